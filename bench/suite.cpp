@@ -0,0 +1,1110 @@
+/*
+* PX-Engine Benchmark - Regression Suite
+ * ---------------------------------------
+ * Runs a fixed set of reproducible rendering workloads and reports their
+ * throughput, optionally as JSON for tracking regressions between releases:
+ * - Surface clears, setPixel and drawLine at several lengths and slopes.
+ * - A triangle mesh drawn immediately and through the binned rasterizer, on
+ *   one thread and on the thread pool.
+ * - BasicSurface clears and setPixel per pixel format and bounds policy.
+ * - Row, column, random, rotated and diagonal-line access per surface
+ *   layout (linear, 8x8 and 16x16 tiles, Morton), and the cost of detiling.
+ * - Scratch surfaces created and destroyed per frame, from the heap, a frame
+ *   arena and a surface pool.
+ * - Every fill and blend kernel the CPU supports, scalar first, so the SIMD
+ *   paths can be compared against the scalar baseline.
+ * - The Mandelbrot kernel on one thread and on the thread pool, every SIMD
+ *   fractal kernel, and a deep zoom rendered by perturbation.
+ * - Texture uploads in every upload mode, in indexed mode, and per
+ *   BasicSurface pixel format, through the headless EGL backend.
+ *
+ * The suite also runs correctness checks, named check/...: reference and
+ * malformed QOI streams, and random scenes drawn immediately against the
+ * same scenes through the binned rasterizer. A failed check makes it exit
+ * with a failure status; '--filter check/' runs the checks alone, as ctest
+ * does.
+ *
+ * No window is needed; the upload benchmarks are skipped when the build or
+ * the driver has no offscreen EGL support.
+ *
+ * Usage:
+ *   px-engine-bench [--filter <text>] [--min-time <seconds>] [--json <file>]
+ *
+ * Options:
+ * - --filter    Only runs the benchmarks whose name contains <text>.
+ * - --min-time  Minimum measuring time per benchmark (default 0.2).
+ * - --json      Also writes the results to <file>, or to stdout for '-', in
+ *               the JSON layout of Google Benchmark, so its comparison
+ *               tools can diff two runs.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "basicSurface.h"
+#include "binnedRasterizer.h"
+#include "bitmapFont.h"
+#include "commandList.h"
+#include "fractalKernels.h"
+#include "fractalRenderer.h"
+#include "glPixelFormat.h"
+#include "graphics.h"
+#ifdef PXE_HEADLESS_EGL
+#include "offscreenContext.h"
+#endif
+#include "pixelKernels.h"
+#include "qoiReader.h"
+#include "surface.h"
+#include "textCache.h"
+#include "threadPool.h"
+
+namespace {
+	struct Resolution {
+		int width;
+		int height;
+	};
+
+	struct Options {
+		std::string filter;
+		double minTime = 0.2;
+		std::string jsonPath;
+	};
+
+	struct Result {
+		std::string name;
+		size_t iterations = 0;
+		double realNanoseconds = 0.0; ///< Mean wall time per iteration.
+		double cpuNanoseconds = 0.0; ///< Mean process CPU time per iteration, summed over all threads.
+		double itemsPerSecond = 0.0;
+		double bytesPerSecond = 0.0;
+	};
+
+	class Suite {
+	public:
+		/**
+		 * @param options The parsed command line.
+		 * @param log Stream for the human-readable result table.
+		 */
+		Suite(Options options, std::FILE *log) : options(std::move(options)), log(log) {}
+
+		[[nodiscard]] bool isSelected(const std::string &name) const {
+			return options.filter.empty() || name.find(options.filter) != std::string::npos;
+		}
+
+		/**
+		 * Runs `body` until at least the minimum time has elapsed, after one untimed warm-up call.
+		 * `items` and `bytes` are the work done by one call; `finish` (e.g. glFinish) runs before the clock
+		 * stops, so asynchronous work is included without serializing every iteration.
+		 */
+		void run(const std::string &name, const double items, const double bytes, const std::function<void()> &body,
+				 const std::function<void()> &finish = nullptr) {
+			if (!isSelected(name))
+				return;
+
+			using clock = std::chrono::steady_clock;
+			body();
+			if (finish) {
+				finish();
+			}
+
+			size_t iterations = 0;
+			const std::clock_t cpuStart = std::clock();
+			const auto start = clock::now();
+			double seconds = 0.0;
+			do {
+				body();
+				iterations++;
+				seconds = std::chrono::duration<double>(clock::now() - start).count();
+				if (finish && seconds >= options.minTime) {
+					finish();
+					seconds = std::chrono::duration<double>(clock::now() - start).count();
+				}
+			} while (seconds < options.minTime);
+			const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+			Result result;
+			result.name = name;
+			result.iterations = iterations;
+			result.realNanoseconds = seconds * 1e9 / static_cast<double>(iterations);
+			result.cpuNanoseconds = cpuSeconds * 1e9 / static_cast<double>(iterations);
+			result.itemsPerSecond = items * static_cast<double>(iterations) / seconds;
+			result.bytesPerSecond = bytes * static_cast<double>(iterations) / seconds;
+			std::fprintf(log, "%-44s %10zu %12.1f %12.2f %10.2f\n", name.c_str(), iterations,
+						 result.realNanoseconds / 1e3, result.itemsPerSecond / 1e6, result.bytesPerSecond / 1e9);
+			std::fflush(log);
+			results.push_back(std::move(result));
+		}
+
+		/**
+		 * Runs a correctness check: `body` returns an empty string when it passes, or what went wrong. Any
+		 * failed check makes the suite exit with a failure status.
+		 */
+		void check(const std::string &name, const std::function<std::string()> &body) {
+			if (!isSelected(name))
+				return;
+			const std::string failure = body();
+			std::fprintf(log, "%-44s %s%s\n", name.c_str(), failure.empty() ? "ok" : "FAILED: ", failure.c_str());
+			std::fflush(log);
+			if (!failure.empty()) {
+				failures++;
+			}
+		}
+
+		[[nodiscard]] int getFailures() const { return failures; }
+
+		void writeJson(std::FILE *file, const std::string &renderer) const {
+			char date[32];
+			const std::time_t now = std::time(nullptr);
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+			const char *buildType = "release";
+#else
+			const char *buildType = "debug";
+#endif
+			std::fprintf(file, "{\n  \"context\": {\n");
+			std::fprintf(file, "    \"date\": \"%s\",\n", date);
+			std::fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+			std::fprintf(file, "    \"library_build_type\": \"%s\",\n", buildType);
+			std::fprintf(file, "    \"fill_kernels\": \"%s\",\n", pxe::fillKernels().name);
+			std::fprintf(file, "    \"blit_kernels\": \"%s\",\n", pxe::blitKernels().name);
+			std::fprintf(file, "    \"renderer\": \"%s\"\n  },\n", escape(renderer).c_str());
+			std::fprintf(file, "  \"benchmarks\": [");
+			for (size_t i = 0; i < results.size(); i++) {
+				const Result &result = results[i];
+				std::fprintf(file, "%s\n    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %zu, ",
+							 i == 0 ? "" : ",", escape(result.name).c_str(), result.iterations);
+				std::fprintf(file, "\"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", ",
+							 result.realNanoseconds, result.cpuNanoseconds);
+				std::fprintf(file, "\"items_per_second\": %.1f, \"bytes_per_second\": %.1f}", result.itemsPerSecond,
+							 result.bytesPerSecond);
+			}
+			std::fprintf(file, "\n  ]\n}\n");
+		}
+
+	private:
+		Options options;
+		std::FILE *log;
+		std::vector<Result> results;
+		int failures = 0;
+
+		static std::string escape(const std::string_view text) {
+			std::string escaped;
+			for (const char c: text) {
+				if (c == '"' || c == '\\') {
+					escaped += '\\';
+				}
+				escaped += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+			}
+			return escaped;
+		}
+	};
+
+	std::string sizeName(const Resolution &resolution) {
+		return std::to_string(resolution.width) + "x" + std::to_string(resolution.height);
+	}
+
+	// A fixed-seed generator, so every run draws exactly the same workload.
+	class Random {
+	public:
+		uint32_t next() {
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<uint32_t>(state >> 33);
+		}
+
+		int below(const int limit) { return static_cast<int>(next() % static_cast<uint32_t>(limit)); }
+
+	private:
+		uint64_t state = 0x5EED;
+	};
+
+	constexpr Resolution surfaceResolutions[] = {{320, 180}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+	// A QOI file around hand-encoded ops: the 14-byte header, the ops and the 8-byte end marker.
+	std::vector<uint8_t> qoiFile(const uint32_t width, const uint32_t height, const std::vector<uint8_t> &ops) {
+		std::vector<uint8_t> file{'q', 'o', 'i', 'f'};
+		for (const uint32_t value: {width, height}) {
+			for (int shift = 24; shift >= 0; shift -= 8) {
+				file.push_back(static_cast<uint8_t>(value >> shift));
+			}
+		}
+		file.push_back(4); // RGBA
+		file.push_back(0); // sRGB
+		file.insert(file.end(), ops.begin(), ops.end());
+		file.insert(file.end(), 7, 0);
+		file.push_back(1);
+		return file;
+	}
+
+	void checkDecoders(Suite &suite) {
+		suite.check("check/decode/qoi", []() -> std::string {
+			// Every op once, across two rows: RGBA, DIFF, LUMA, a run of two, INDEX, RGB and a wrapping DIFF.
+			const std::vector<uint8_t> ops{0xFF, 10, 20, 30, 40, 0x76, 0xA5, 0xA5, 0xC1, 0x0C, 0xFE, 1, 2, 3, 0x4D};
+			const pxe::Image image = pxe::decodeQoi(qoiFile(4, 2, ops));
+			const pxe::Color expected[] = {pxe::Color(10, 20, 30, 40), pxe::Color(11, 19, 30, 40),
+										   pxe::Color(18, 24, 32, 40), pxe::Color(18, 24, 32, 40),
+										   pxe::Color(18, 24, 32, 40), pxe::Color(10, 20, 30, 40),
+										   pxe::Color(1, 2, 3, 40), pxe::Color(255, 3, 2, 40)};
+			for (int i = 0; i < 8; i++) {
+				if (image.getPixel(i % 4, i / 4).pixel() != expected[i].pixel())
+					return "wrong pixel " + std::to_string(i);
+			}
+			// The index starts out transparent black; the reference encoder refers to it for such a first pixel.
+			if (pxe::decodeQoi(qoiFile(1, 1, {0x00})).getPixel(0, 0).pixel() != pxe::Color(0, 0, 0, 0).pixel())
+				return "index does not start out transparent black";
+
+			std::vector<uint8_t> badChannels = qoiFile(1, 1, {0x00});
+			badChannels[12] = 5;
+			const std::vector<uint8_t> malformed[] = {
+					qoiFile(4, 2, {0xFF, 10, 20, 30}), // An op cut short by the end marker.
+					qoiFile(4, 2, {0xC1}), // Fewer pixels than the header promises.
+					qoiFile(0, 2, {0x00}),
+					badChannels,
+					qoiFile(20000, 20000, {0xFD}), // Within the pixel limit, but more than the ops can encode.
+					qoiFile(30000, 30000, {0xFD}),
+					{'q', 'o', 'i', 'f', 0, 0, 0, 1},
+			};
+			for (size_t i = 0; i < std::size(malformed); i++) {
+				try {
+					(void) pxe::decodeQoi(malformed[i]);
+					return "malformed file " + std::to_string(i) + " was accepted";
+				} catch (const std::runtime_error &) {
+				}
+			}
+			return {};
+		});
+	}
+
+	void benchmarkSurface(Suite &suite) {
+		for (const Resolution &resolution: surfaceResolutions) {
+			pxe::Surface surface(resolution.width, resolution.height);
+			const double pixels = static_cast<double>(resolution.width) * resolution.height;
+			// Locking marks every tile as written without touching the pixels, so each clear does a full clear.
+			suite.run("surface/clear/" + sizeName(resolution), pixels, pixels * sizeof(uint32_t), [&] {
+				(void) surface.lockRows(surface.getBounds());
+				surface.clear();
+			});
+		}
+
+		for (const pxe::FillKernels *kernels: pxe::availableFillKernels()) {
+			for (const Resolution &resolution: surfaceResolutions) {
+				const size_t count = static_cast<size_t>(resolution.width) * resolution.height;
+				std::vector<uint32_t> buffer(count);
+				suite.run(std::string("fill/") + kernels->name + "/" + sizeName(resolution), static_cast<double>(count),
+						  static_cast<double>(count * sizeof(uint32_t)),
+						  [&] { kernels->fillSpan(buffer.data(), count, 0xFF336699); });
+			}
+		}
+
+		constexpr Resolution resolution{1920, 1080};
+		pxe::Surface surface(resolution.width, resolution.height);
+		constexpr int pixelCount = 1 << 20;
+		suite.run("surface/setPixel/sequential", pixelCount, pixelCount * sizeof(uint32_t), [&] {
+			for (int i = 0; i < pixelCount; i++) {
+				surface.setPixel(i % resolution.width, i / resolution.width % resolution.height, pxe::Color::Red);
+			}
+		});
+		Random random;
+		std::vector<std::pair<int, int>> points(pixelCount);
+		for (auto &[x, y]: points) {
+			x = random.below(resolution.width);
+			y = random.below(resolution.height);
+		}
+		suite.run("surface/setPixel/random", pixelCount, pixelCount * sizeof(uint32_t), [&] {
+			for (const auto &[x, y]: points) {
+				surface.setPixel(x, y, pxe::Color::Red);
+			}
+		});
+	}
+
+	template<typename Format, typename Bounds>
+	void benchmarkBasicSetPixel(Suite &suite, const std::string &name, const typename Format::Value value) {
+		constexpr Resolution resolution{1920, 1080};
+		pxe::BasicSurface<Format, Bounds> surface(resolution.width, resolution.height);
+		constexpr int pixelCount = 1 << 20;
+		Random random;
+		std::vector<std::pair<int, int>> points(pixelCount);
+		for (auto &[x, y]: points) {
+			x = random.below(resolution.width);
+			y = random.below(resolution.height);
+		}
+		suite.run(name, pixelCount, pixelCount * sizeof(typename Format::Storage), [&] {
+			for (const auto &[x, y]: points) {
+				surface.setPixel(x, y, value);
+			}
+		});
+	}
+
+	template<typename Format>
+	void benchmarkBasicSurface(Suite &suite, const std::string &format, const typename Format::Value value) {
+		constexpr Resolution resolution{1920, 1080};
+		pxe::BasicSurface<Format> surface(resolution.width, resolution.height);
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+		suite.run("basicSurface/" + format + "/clear", pixels, static_cast<double>(surface.getSizeBytes()),
+				  [&] { surface.clear(); });
+		const std::string prefix = "basicSurface/" + format + "/setPixel/";
+		benchmarkBasicSetPixel<Format, pxe::CheckedBounds>(suite, prefix + "checked", value);
+		benchmarkBasicSetPixel<Format, pxe::ClampedBounds>(suite, prefix + "clamped", value);
+		benchmarkBasicSetPixel<Format, pxe::UncheckedBounds>(suite, prefix + "unchecked", value);
+	}
+
+	void benchmarkBasicSurfaces(Suite &suite) {
+		benchmarkBasicSurface<pxe::Argb8888Format>(suite, "argb8888", pxe::Color::Red);
+		benchmarkBasicSurface<pxe::Rgb565Format>(suite, "rgb565", pxe::Color::Red);
+		benchmarkBasicSurface<pxe::Indexed8Format>(suite, "indexed8", 7);
+	}
+
+	template<typename Layout>
+	void benchmarkLayout(Suite &suite, const std::string &layout) {
+		using LayoutSurface = pxe::BasicSurface<pxe::Argb8888Format, pxe::ClampedBounds, Layout>;
+		static constexpr Resolution resolution{1920, 1080};
+		static constexpr uint32_t pixel = pxe::Color::Red.pixel();
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+		const double bytes = pixels * sizeof(uint32_t);
+		const std::string prefix = "layout/" + layout + "/";
+		LayoutSurface surface(resolution.width, resolution.height);
+
+		suite.run(prefix + "rows", pixels, bytes, [&] {
+			for (int y = 0; y < resolution.height; y++) {
+				for (int x = 0; x < resolution.width; x++) {
+					surface.at(x, y) = pixel;
+				}
+			}
+		});
+		suite.run(prefix + "columns", pixels, bytes, [&] {
+			for (int x = 0; x < resolution.width; x++) {
+				for (int y = 0; y < resolution.height; y++) {
+					surface.at(x, y) = pixel;
+				}
+			}
+		});
+
+		// Clustered points, like particles or a flood fill: random jumps between small random walks.
+		constexpr int pointCount = 1 << 20;
+		Random random;
+		std::vector<std::pair<int, int>> points(pointCount);
+		int walkX = 0;
+		int walkY = 0;
+		for (int i = 0; i < pointCount; i++) {
+			if (i % 16 == 0) {
+				walkX = random.below(resolution.width);
+				walkY = random.below(resolution.height);
+			}
+			walkX = std::clamp(walkX + random.below(5) - 2, 0, resolution.width - 1);
+			walkY = std::clamp(walkY + random.below(5) - 2, 0, resolution.height - 1);
+			points[i] = {walkX, walkY};
+		}
+		suite.run(prefix + "random", pointCount, pointCount * sizeof(uint32_t), [&] {
+			for (const auto &[x, y]: points) {
+				surface.at(x, y) = pixel;
+			}
+		});
+
+		// Rotated copy into a linear surface: every destination row walks the source diagonally.
+		pxe::BasicSurface<pxe::Argb8888Format> rotated(resolution.width, resolution.height);
+		const auto cosine = static_cast<int>(std::lround(std::cos(0.5) * 65536.0));
+		const auto sine = static_cast<int>(std::lround(std::sin(0.5) * 65536.0));
+		suite.run(prefix + "rotate", pixels, 2.0 * bytes, [&] {
+			for (int y = 0; y < resolution.height; y++) {
+				const int dy = y - resolution.height / 2;
+				int u = (resolution.width / 2 << 16) - resolution.width / 2 * cosine - dy * sine;
+				int v = (resolution.height / 2 << 16) - resolution.width / 2 * sine + dy * cosine;
+				uint32_t *dst = rotated.row(y);
+				for (int x = 0; x < resolution.width; x++, u += cosine, v += sine) {
+					dst[x] = surface.getPixel(u >> 16, v >> 16).pixel();
+				}
+			}
+		});
+
+		constexpr int lineCount = 4096;
+		constexpr int length = 512;
+		std::vector<pxe::Line> lines(lineCount);
+		for (pxe::Line &line: lines) {
+			line.x0 = random.below(resolution.width);
+			line.y0 = random.below(resolution.height);
+			line.x1 = line.x0 + length;
+			line.y1 = line.y0 + length;
+		}
+		const double linePixels = static_cast<double>(lineCount) * (length + 1);
+		suite.run(prefix + "diagonalLines", linePixels, linePixels * sizeof(uint32_t), [&] {
+			for (const pxe::Line &line: lines) {
+				surface.drawLine(line, pxe::Color::White);
+			}
+		});
+
+		std::vector<uint32_t> rows(static_cast<size_t>(resolution.width) * resolution.height);
+		const pxe::SurfaceView view(rows.data(), resolution.width, resolution.height, resolution.width);
+		suite.run("detile/" + layout + "/" + sizeName(resolution), pixels, 2.0 * bytes,
+				  [&] { surface.copyTo(view); });
+	}
+
+	void benchmarkLayouts(Suite &suite) {
+		benchmarkLayout<pxe::LinearLayout>(suite, "linear");
+		benchmarkLayout<pxe::TiledLayout<8>>(suite, "tiled8");
+		benchmarkLayout<pxe::TiledLayout<16>>(suite, "tiled16");
+		benchmarkLayout<pxe::MortonLayout>(suite, "morton");
+
+		// The Morton kernels alone, over the whole tiles of a 1080p surface.
+		constexpr Resolution resolution{1920, 1080};
+		pxe::BasicSurface<pxe::Argb8888Format, pxe::CheckedBounds, pxe::MortonLayout> surface(resolution.width,
+																							   resolution.height);
+		std::vector<uint32_t> rows(static_cast<size_t>(resolution.width) * resolution.height);
+		const int tilesX = resolution.width / 16;
+		const int tilesY = resolution.height / 16;
+		const double pixels = 256.0 * tilesX * tilesY;
+		for (const pxe::DetileKernels *kernels: pxe::availableDetileKernels()) {
+			suite.run(std::string("detile/morton/") + kernels->name, pixels, 2.0 * pixels * sizeof(uint32_t), [&] {
+				const uint32_t *tile = surface.data();
+				for (int tileY = 0; tileY < tilesY; tileY++) {
+					uint32_t *dst = rows.data() + static_cast<size_t>(tileY) * 16 * resolution.width;
+					for (int tileX = 0; tileX < tilesX; tileX++, tile += 256) {
+						kernels->mortonTile(dst + tileX * 16, resolution.width, tile);
+					}
+				}
+			});
+		}
+	}
+
+	void benchmarkAllocators(Suite &suite) {
+		constexpr Resolution resolutions[] = {{1920, 1080}, {3840, 2160}};
+		for (const Resolution &resolution: resolutions) {
+			const double pixels = static_cast<double>(resolution.width) * resolution.height;
+			const double bytes = pixels * sizeof(uint32_t);
+			// A fresh scratch surface per iteration, like a post-processing pass creating its temporaries.
+			auto scratch = [&](pxe::SurfaceAllocator &allocator) {
+				pxe::BasicSurface<pxe::Argb8888Format> surface(resolution.width, resolution.height, allocator);
+				surface.setPixel(0, 0, pxe::Color::Red);
+			};
+			const std::string suffix = "/scratch/" + sizeName(resolution);
+			suite.run("allocator/heap" + suffix, pixels, bytes, [&] { scratch(pxe::SurfaceAllocator::getDefault()); });
+			pxe::FrameArena arena;
+			suite.run("allocator/arena" + suffix, pixels, bytes, [&] {
+				arena.reset();
+				scratch(arena);
+			});
+			pxe::SurfacePool pool;
+			suite.run("allocator/pool" + suffix, pixels, bytes, [&] { scratch(pool); });
+		}
+	}
+
+	void benchmarkLines(Suite &suite) {
+		struct Slope {
+			const char *name;
+			int dx;
+			int dy;
+		};
+		constexpr Slope slopes[] = {
+				{"horizontal", 1, 0}, {"vertical", 0, 1}, {"diagonal", 1, 1}, {"shallow", 4, 1}, {"steep", 1, 4},
+		};
+		constexpr int lengths[] = {8, 64, 512};
+		constexpr int lineCount = 4096;
+		constexpr Resolution resolution{1920, 1080};
+
+		pxe::Surface surface(resolution.width, resolution.height);
+		for (const Slope &slope: slopes) {
+			for (const int length: lengths) {
+				// Lines start anywhere on the surface, so long ones are also clipped at the edges.
+				Random random;
+				std::vector<pxe::Line> lines(lineCount);
+				double pixels = 0.0;
+				const int steps = std::max(slope.dx, slope.dy);
+				for (pxe::Line &line: lines) {
+					line.x0 = random.below(resolution.width);
+					line.y0 = random.below(resolution.height);
+					line.x1 = line.x0 + slope.dx * length / steps;
+					line.y1 = line.y0 + slope.dy * length / steps;
+					pixels += length + 1;
+				}
+				suite.run("surface/drawLine/" + std::string(slope.name) + "/" + std::to_string(length), pixels,
+						  pixels * sizeof(uint32_t), [&] { surface.drawLines(lines, pxe::Color::White); });
+			}
+		}
+	}
+
+	void checkBinning(Suite &suite) {
+		suite.check("check/raster/binned", []() -> std::string {
+			// Random scenes drawn immediately and through the binned rasterizer must match pixel for pixel. The
+			// surface is not a multiple of the tile size, and some coordinates lie far outside it, so edge tiles,
+			// clipped lines and triangles translated into their tiles are all covered.
+			constexpr Resolution resolution{333, 207};
+			constexpr int sceneCount = 300;
+			Random random;
+			auto coordinate = [&](const int size) {
+				return random.below(8) == 0 ? random.below(200001) - 100000 : random.below(size + 160) - 80;
+			};
+			auto color = [&] { return pxe::Color::fromPixel(0xFF000000u | random.next()); };
+
+			pxe::Surface immediate(resolution.width, resolution.height);
+			pxe::Surface binned(resolution.width, resolution.height);
+			pxe::BinnedRasterizer rasterizer;
+			pxe::ThreadPool pool;
+			const pxe::BinnedRasterizer::ParallelFor serial = [](const int count,
+																 const std::function<void(int)> &body) {
+				for (int i = 0; i < count; i++) {
+					body(i);
+				}
+			};
+			const pxe::BinnedRasterizer::ParallelFor threaded = [&](const int count,
+																	const std::function<void(int)> &body) {
+				pool.parallelFor(static_cast<size_t>(count), [&](const size_t i) { body(static_cast<int>(i)); });
+			};
+			std::vector<pxe::Color> span;
+			for (int scene = 0; scene < sceneCount; scene++) {
+				// Every other list has no cull rectangle, leaving all the clipping to the rasterizer.
+				pxe::CommandList commands = scene % 2 == 0 ? pxe::CommandList(resolution.width, resolution.height)
+														   : pxe::CommandList();
+				immediate.clear();
+				binned.clear();
+				for (int i = 0; i < 40; i++) {
+					const int x0 = coordinate(resolution.width), y0 = coordinate(resolution.height);
+					const int x1 = coordinate(resolution.width), y1 = coordinate(resolution.height);
+					const int x2 = coordinate(resolution.width), y2 = coordinate(resolution.height);
+					const int radius = random.below(8) == 0 ? random.below(2000) : random.below(120);
+					const pxe::Rect region{x0, y0, random.below(200) - 20, random.below(200) - 20};
+					const pxe::Color c = color();
+					switch (random.below(10)) {
+						case 0:
+							immediate.setPixel(x0, y0, c);
+							commands.drawPixel(x0, y0, c);
+							break;
+						case 1:
+							span.resize(static_cast<size_t>(random.below(120)));
+							for (pxe::Color &pixel: span) {
+								pixel = color();
+							}
+							immediate.drawSpan(x0, y0, span);
+							commands.drawSpan(x0, y0, span);
+							break;
+						case 2:
+							immediate.fillRect(region, c);
+							commands.fillRect(region, c);
+							break;
+						case 3:
+							immediate.drawRect(region, c);
+							commands.drawRect(region, c);
+							break;
+						case 4:
+							immediate.drawLine({x0, y0, x1, y1}, c);
+							commands.drawLine({x0, y0, x1, y1}, c);
+							break;
+						case 5: {
+							const pxe::Line lines[] = {{x0, y0, x1, y1}, {x1, y1, x2, y2}, {x2, y2, x0, y0}};
+							immediate.drawLines(lines, c);
+							commands.drawLines(lines, c);
+							break;
+						}
+						case 6:
+							immediate.drawCircle(x0, y0, radius, c);
+							commands.drawCircle(x0, y0, radius, c);
+							break;
+						case 7:
+							immediate.fillCircle(x0, y0, radius, c);
+							commands.fillCircle(x0, y0, radius, c);
+							break;
+						case 8:
+							immediate.drawTriangle(x0, y0, x1, y1, x2, y2, c);
+							commands.drawTriangle(x0, y0, x1, y1, x2, y2, c);
+							break;
+						default:
+							immediate.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+							commands.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+							break;
+					}
+				}
+				rasterizer.execute(commands, binned, scene % 4 < 2 ? serial : threaded);
+				for (int y = 0; y < resolution.height; y++) {
+					for (int x = 0; x < resolution.width; x++) {
+						if (immediate.getPixel(x, y).pixel() != binned.getPixel(x, y).pixel())
+							return "scene " + std::to_string(scene) + " differs at (" + std::to_string(x) + ", " +
+								   std::to_string(y) + ")";
+					}
+				}
+			}
+			return {};
+		});
+	}
+
+	void benchmarkBinning(Suite &suite) {
+		// A mesh of 32x32 pixel cells covering the surface three times over, each layer offset a little.
+		constexpr Resolution resolution{1920, 1080};
+		constexpr int cell = 32;
+		struct Triangle {
+			int x0, y0, x1, y1, x2, y2;
+			uint32_t pixel;
+		};
+		std::vector<Triangle> mesh;
+		for (int layer = 0; layer < 3; layer++) {
+			const int offset = layer * 3;
+			for (int y = -cell; y < resolution.height; y += cell) {
+				for (int x = -cell; x < resolution.width; x += cell) {
+					const auto pixel = static_cast<uint32_t>(0xFF000000u | (x * 2654435761u ^ y * 40503u ^ layer));
+					const int left = x + offset, top = y + offset;
+					mesh.push_back({left, top, left + cell, top, left, top + cell, pixel});
+					mesh.push_back({left + cell, top, left + cell, top + cell, left, top + cell, pixel});
+				}
+			}
+		}
+		const double pixels = 3.0 * resolution.width * resolution.height;
+		const std::string suffix = "/" + sizeName(resolution);
+
+		pxe::Surface surface(resolution.width, resolution.height);
+		suite.run("raster/triangles/immediate" + suffix, pixels, pixels * sizeof(uint32_t), [&] {
+			for (const Triangle &t: mesh) {
+				surface.fillTriangle(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, pxe::Color::fromPixel(t.pixel));
+			}
+		});
+
+		pxe::BinnedRasterizer rasterizer;
+		pxe::CommandList commands(resolution.width, resolution.height);
+		auto record = [&] {
+			commands.clear();
+			for (const Triangle &t: mesh) {
+				commands.fillTriangle(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, pxe::Color::fromPixel(t.pixel));
+			}
+		};
+		const pxe::BinnedRasterizer::ParallelFor serial = [](const int count, const std::function<void(int)> &body) {
+			for (int i = 0; i < count; i++) {
+				body(i);
+			}
+		};
+		suite.run("raster/triangles/binned" + suffix, pixels, pixels * sizeof(uint32_t), [&] {
+			record();
+			rasterizer.execute(commands, surface, serial);
+		});
+		// The same list submitted again, as a static layer would be: binning and rasterization only.
+		record();
+		suite.run("raster/triangles/replay" + suffix, pixels, pixels * sizeof(uint32_t),
+				  [&] { rasterizer.execute(commands, surface, serial); });
+		if (suite.isSelected("raster/triangles/binned-threaded")) {
+			pxe::ThreadPool pool;
+			suite.run("raster/triangles/binned-threaded" + suffix, pixels, pixels * sizeof(uint32_t), [&] {
+				record();
+				rasterizer.execute(commands, surface, [&](const int count, const std::function<void(int)> &body) {
+					pool.parallelFor(static_cast<size_t>(count), [&](const size_t i) { body(static_cast<int>(i)); });
+				});
+			});
+		}
+
+		// Per-pixel plotting: immediate writes against a list that merges each row into one span.
+		const double plotted = static_cast<double>(resolution.width) * resolution.height;
+		suite.run("raster/plot/immediate" + suffix, plotted, plotted * sizeof(uint32_t), [&] {
+			for (int y = 0; y < resolution.height; y++) {
+				for (int x = 0; x < resolution.width; x++) {
+					surface.setPixel(x, y, pxe::Color::fromPixel(0xFF000000u | (x ^ y)));
+				}
+			}
+		});
+		auto plot = [&] {
+			commands.clear();
+			for (int y = 0; y < resolution.height; y++) {
+				for (int x = 0; x < resolution.width; x++) {
+					commands.drawPixel(x, y, pxe::Color::fromPixel(0xFF000000u | (x ^ y)));
+				}
+			}
+		};
+		suite.run("raster/plot/recorded" + suffix, plotted, plotted * sizeof(uint32_t), [&] {
+			plot();
+			rasterizer.execute(commands, surface, serial);
+		});
+		plot();
+		suite.run("raster/plot/replay" + suffix, plotted, plotted * sizeof(uint32_t),
+				  [&] { rasterizer.execute(commands, surface, serial); });
+	}
+
+	void benchmarkBlend(Suite &suite) {
+		constexpr Resolution resolution{1920, 1080};
+		const size_t count = static_cast<size_t>(resolution.width) * resolution.height;
+		std::vector<uint32_t> destination(count, 0xFF102030);
+		std::vector<uint32_t> source(count);
+		Random random;
+		for (uint32_t &pixel: source) {
+			// Premultiplied: every channel at most the alpha.
+			const uint32_t alpha = random.next() & 0xFF;
+			pixel = alpha << 24 | (alpha / 2) << 16 | (alpha / 3) << 8 | alpha / 4;
+		}
+		for (const pxe::BlitKernels *kernels: pxe::availableBlitKernels()) {
+			suite.run(std::string("blend/") + kernels->name + "/" + sizeName(resolution), static_cast<double>(count),
+					  static_cast<double>(count * sizeof(uint32_t)),
+					  [&] { kernels->blendRow(destination.data(), source.data(), count); });
+		}
+	}
+
+	void benchmarkText(Suite &suite) {
+		// A HUD of 20 lines in the default font, drawn every frame.
+		constexpr Resolution resolution{640, 360};
+		pxe::Surface surface(resolution.width, resolution.height);
+		const pxe::BitmapFont &font = pxe::BitmapFont::getDefault();
+		std::vector<std::string> lines;
+		double characters = 0.0;
+		for (int i = 0; i < 20; i++) {
+			lines.push_back("entity " + std::to_string(i) + ": x 123.45 y 67.89 hp 100");
+			characters += static_cast<double>(lines.back().size());
+		}
+
+		// The glyph bits of each character plotted pixel by pixel, as without a text renderer.
+		const pxe::Image &atlas = font.getAtlas();
+		suite.run("text/plotted", characters, characters * font.getAdvance() * font.getLineHeight() * 4, [&] {
+			for (size_t line = 0; line < lines.size(); line++) {
+				int x = 2;
+				for (const char character: lines[line]) {
+					const pxe::Rect glyph = font.getGlyphRegion(character);
+					for (int y = 0; y < glyph.height; y++) {
+						for (int column = 0; column < glyph.width; column++) {
+							if (atlas.getPixel(glyph.x + column, y).a() != 0) {
+								surface.setPixel(x + column, 2 + static_cast<int>(line) * font.getLineHeight() + y,
+												 pxe::Color::White);
+							}
+						}
+					}
+					x += font.getAdvance();
+				}
+			}
+		});
+
+		pxe::TextCache cache;
+		auto drawLines = [&] {
+			for (size_t line = 0; line < lines.size(); line++) {
+				const pxe::Image &text = cache.get(lines[line], font, pxe::Color::White);
+				surface.blit(text, text.getBounds(), 2, 2 + static_cast<int>(line) * font.getLineHeight(),
+							 pxe::BlendMode::ColorKey);
+			}
+			cache.trim();
+		};
+		suite.run("text/cached", characters, characters * font.getAdvance() * font.getLineHeight() * 4, drawLines);
+		// Every line changes every frame, so each one is laid out again.
+		int frame = 0;
+		suite.run("text/changing", characters, characters * font.getAdvance() * font.getLineHeight() * 4, [&] {
+			frame++;
+			for (std::string &line: lines) {
+				line[7] = static_cast<char>('0' + frame % 10);
+			}
+			drawLines();
+		});
+	}
+
+	// The kernel of the Mandelbrot demo: escape-time iteration with a polynomial palette.
+	uint32_t shadeMandelbrot(const double real, const double imag) {
+		constexpr int maxIter = 256;
+		int iter = 0;
+		double zr = 0.0, zi = 0.0;
+		while (zr * zr + zi * zi <= 4.0 && iter < maxIter) {
+			const double temp = zr * zr - zi * zi + real;
+			zi = 2.0 * zr * zi + imag;
+			zr = temp;
+			iter++;
+		}
+		if (iter == maxIter)
+			return pxe::Color::Black.pixel();
+		const double t = static_cast<double>(iter) / maxIter;
+		return pxe::Color(static_cast<int>(9 * (1 - t) * t * t * t * 255),
+						  static_cast<int>(15 * (1 - t) * (1 - t) * t * t * 255),
+						  static_cast<int>(8.5 * (1 - t) * (1 - t) * (1 - t) * t * 255))
+				.pixel();
+	}
+
+	/**
+	 * @brief Draws one frame of a three-layer scene: a full-screen gradient background, a translucent band
+	 * changing every 16th frame and moving foreground squares. With a single layer everything is redrawn.
+	 */
+	void drawLayeredFrame(pxe::Graphics &graphics, const std::vector<pxe::Color> &gradient, const int frame) {
+		const bool layered = graphics.getLayerCount() > 1;
+		const int width = graphics.getWidth(), height = graphics.getHeight();
+		graphics.beginFrame();
+		if (!layered || frame == 0) {
+			for (int y = 0; y < height; y++) {
+				graphics.drawSpan(0, y, std::span(gradient).subspan(y % 256, width));
+			}
+		}
+		if (!layered || frame % 16 == 0) {
+			if (layered) {
+				graphics.setDrawLayer(1);
+				graphics.clear();
+			}
+			for (int i = 0; i < 8; i++) {
+				graphics.fillRect({i * width / 8 + frame % 64, height / 3, width / 16, height / 3},
+								  pxe::Color(0, 96, 0, 128));
+			}
+		}
+		if (layered) {
+			graphics.setDrawLayer(2);
+		}
+		for (int i = 0; i < 16; i++) {
+			graphics.fillRect({(frame * 7 + i * 120) % width, i * 67 % height, 32, 32}, pxe::Color::White);
+		}
+		if (layered) {
+			graphics.setDrawLayer(0);
+		}
+		graphics.endFrame();
+	}
+
+	/**
+	 * @brief Runs `drawLayeredFrame` with the scene in one surface, then in three layers.
+	 */
+	void benchmarkLayeredScene(Suite &suite, const std::string &prefix, const Resolution &resolution,
+							   const pxe::GraphicsTarget target, const GLADloadproc loader,
+							   const std::function<void()> &finish) {
+		std::vector<pxe::Color> gradient(resolution.width + 256);
+		for (size_t x = 0; x < gradient.size(); x++) {
+			gradient[x] = pxe::Color(static_cast<uint8_t>(x), static_cast<uint8_t>(x / 4), 160);
+		}
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+		const std::string suffix = "/" + sizeName(resolution);
+		pxe::Graphics graphics(resolution.width, resolution.height, target, loader);
+		int frame = 0;
+		suite.run(prefix + "redraw" + suffix, pixels, pixels * sizeof(uint32_t),
+				  [&] { drawLayeredFrame(graphics, gradient, frame++); }, finish);
+
+		graphics.setRetainedMode(true);
+		graphics.addLayer(true);
+		graphics.addLayer(false);
+		constexpr pxe::LayerCompositing modes[] = {pxe::LayerCompositing::Gpu, pxe::LayerCompositing::Cpu};
+		constexpr const char *modeNames[] = {"gpu", "cpu"};
+		for (size_t mode = target == pxe::GraphicsTarget::None ? 1 : 0; mode < std::size(modes); mode++) {
+			graphics.setLayerCompositing(modes[mode]);
+			frame = 0;
+			suite.run(prefix + modeNames[mode] + suffix, pixels, pixels * sizeof(uint32_t),
+					  [&] { drawLayeredFrame(graphics, gradient, frame++); }, finish);
+		}
+	}
+
+	void benchmarkLayers(Suite &suite) {
+		benchmarkLayeredScene(suite, "layers/", {1920, 1080}, pxe::GraphicsTarget::None, nullptr, nullptr);
+	}
+
+	void benchmarkMandelbrot(Suite &suite) {
+		constexpr Resolution resolution{640, 360};
+		// The classic full view: both inside points at the iteration limit and fast-escaping ones.
+		constexpr double scale = 3.2 / resolution.width;
+		constexpr double centerX = -0.6;
+		pxe::Surface surface(resolution.width, resolution.height);
+		const pxe::SurfaceView view = surface.lockRows(surface.getBounds());
+		auto shadeRow = [&](const size_t y) {
+			uint32_t *row = view.row(static_cast<int>(y));
+			const double imag = (static_cast<double>(y) - resolution.height / 2.0) * scale;
+			for (int x = 0; x < resolution.width; x++) {
+				row[x] = shadeMandelbrot((x - resolution.width / 2.0) * scale + centerX, imag);
+			}
+		};
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+
+		suite.run("mandelbrot/scalar/" + sizeName(resolution), pixels, pixels * sizeof(uint32_t), [&] {
+			for (size_t y = 0; y < static_cast<size_t>(resolution.height); y++) {
+				shadeRow(y);
+			}
+		});
+		if (suite.isSelected("mandelbrot/threaded/")) {
+			pxe::ThreadPool pool;
+			suite.run("mandelbrot/threaded/" + sizeName(resolution), pixels, pixels * sizeof(uint32_t),
+					  [&] { pool.parallelFor(resolution.height, shadeRow); });
+		}
+	}
+
+	void benchmarkFractals(Suite &suite) {
+		// The view of the Mandelbrot benchmarks, through the engine's kernels with smooth escape values.
+		constexpr Resolution resolution{640, 360};
+		constexpr double scale = 3.2 / resolution.width;
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+		std::vector<float> values(resolution.width);
+		for (const pxe::FractalKernels *kernels: pxe::availableFractalKernels()) {
+			suite.run(std::string("fractal/") + kernels->name + "/" + sizeName(resolution), pixels,
+					  pixels * sizeof(float), [&] {
+						  for (int y = 0; y < resolution.height; y++) {
+							  kernels->escapeRow(values.data(), values.size(), -0.6 - resolution.width / 2.0 * scale,
+												 scale, (y - resolution.height / 2.0) * scale, 256);
+						  }
+					  });
+		}
+
+		// Past the precision of doubles: reference orbit, series approximation and perturbed pixels.
+		constexpr Resolution deep{160, 90};
+		pxe::FractalRenderer renderer(deep.width, deep.height);
+		renderer.setCenter("-0.743643887037158704752191506114774", "0.131825904205311970493132056385139");
+		renderer.setMaxIterations(4000);
+		renderer.setTimeBudget(std::numeric_limits<double>::infinity());
+		const double deepPixels = static_cast<double>(deep.width) * deep.height;
+		bool nudge = false;
+		suite.run("fractal/deep-1e-14/" + sizeName(deep), deepPixels, deepPixels * sizeof(uint32_t), [&] {
+			// Alternating between two nearly equal scales forces a complete render every time.
+			nudge = !nudge;
+			renderer.setScale(nudge ? 1e-14 : 1.000001e-14);
+			(void) renderer.update();
+		});
+	}
+
+#ifdef PXE_HEADLESS_EGL
+	/**
+	 * @brief Times full-frame uploads of a BasicSurface into a texture of its own format.
+	 */
+	template<typename Format>
+	void benchmarkFormatUpload(Suite &suite, const std::string &format, const Resolution &resolution) {
+		const std::string name = "upload/format/" + format + "/" + sizeName(resolution);
+		if (!suite.isSelected(name))
+			return;
+
+		pxe::BasicSurface<Format> surface(resolution.width, resolution.height);
+		constexpr pxe::GLPixelFormat glFormat = pxe::GLPixelFormatOf<Format>::value;
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, resolution.width, resolution.height, 0,
+					 glFormat.format, glFormat.type, nullptr);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, surface.getPitch());
+		const double pixels = static_cast<double>(resolution.width) * resolution.height;
+		suite.run(
+				name, pixels, pixels * sizeof(typename Format::Storage),
+				[&] {
+					glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, resolution.width, resolution.height, glFormat.format,
+									glFormat.type, surface.data());
+				},
+				[] { glFinish(); });
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glDeleteTextures(1, &texture);
+	}
+#endif
+
+	std::string benchmarkUploads(Suite &suite) {
+#ifdef PXE_HEADLESS_EGL
+		if (!suite.isSelected("upload/"))
+			return {};
+
+		std::unique_ptr<pxe::OffscreenContext> context;
+		try {
+			context = std::make_unique<pxe::OffscreenContext>();
+		} catch (const std::exception &e) {
+			std::fprintf(stderr, "Skipping upload benchmarks: %s\n", e.what());
+			return {};
+		}
+
+		constexpr Resolution resolutions[] = {{1280, 720}, {1920, 1080}, {3840, 2160}};
+		constexpr pxe::UploadMode modes[] = {pxe::UploadMode::Direct, pxe::UploadMode::PixelBufferRing};
+		constexpr const char *modeNames[] = {"direct", "pbo-ring"};
+		std::string renderer;
+		for (const Resolution &resolution: resolutions) {
+			pxe::Graphics graphics(resolution.width, resolution.height, pxe::GraphicsTarget::Framebuffer,
+								   pxe::OffscreenContext::getLoader());
+			renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+			for (size_t mode = 0; mode < std::size(modes); mode++) {
+				graphics.setUploadMode(modes[mode]);
+				if (graphics.getUploadMode() != modes[mode]) {
+					std::fprintf(stderr, "Skipping %s uploads: not supported by the driver\n", modeNames[mode]);
+					continue;
+				}
+				// Full frames, and a frame where only a band of 1/16 of the rows changed.
+				const pxe::Rect full{0, 0, resolution.width, resolution.height};
+				const pxe::Rect band{0, resolution.height / 2, resolution.width, resolution.height / 16};
+				for (const pxe::Rect &region: {full, band}) {
+					const double pixels = static_cast<double>(region.width) * region.height;
+					const std::string name = std::string("upload/") + modeNames[mode] + "/" + sizeName(resolution) +
+											 (region == full ? "/full" : "/band");
+					suite.run(
+							name, pixels, pixels * sizeof(uint32_t),
+							[&] {
+								(void) graphics.lockRows(region);
+								graphics.endFrame();
+							},
+							[] { glFinish(); });
+				}
+			}
+			// Indexed mode: a changed frame of palette indices, and a frame where only the palette changed.
+			graphics.setIndexedMode(true);
+			const double pixels = static_cast<double>(resolution.width) * resolution.height;
+			suite.run(
+					"upload/indexed/" + sizeName(resolution) + "/full", pixels, pixels,
+					[&] {
+						(void) graphics.lockIndexedSurface();
+						graphics.endFrame();
+					},
+					[] { glFinish(); });
+			std::vector<pxe::Color> palette(256, pxe::Color::Blue);
+			suite.run(
+					"upload/indexed/" + sizeName(resolution) + "/palette", pixels, palette.size() * sizeof(uint32_t),
+					[&] {
+						graphics.setPalette(0, palette);
+						graphics.endFrame();
+					},
+					[] { glFinish(); });
+			graphics.setIndexedMode(false);
+		}
+		// A scene redrawn every frame against the same scene kept in layers, composited on the GPU or CPU.
+		benchmarkLayeredScene(suite, "upload/layers/", {1920, 1080}, pxe::GraphicsTarget::Framebuffer,
+							  pxe::OffscreenContext::getLoader(), [] { glFinish(); });
+		// The same frames in each BasicSurface format; GLAD stays loaded for as long as the context lives.
+		for (const Resolution &resolution: resolutions) {
+			benchmarkFormatUpload<pxe::Argb8888Format>(suite, "argb8888", resolution);
+			benchmarkFormatUpload<pxe::Rgb565Format>(suite, "rgb565", resolution);
+			benchmarkFormatUpload<pxe::Indexed8Format>(suite, "indexed8", resolution);
+		}
+		return renderer;
+#else
+		(void) suite;
+		return {};
+#endif
+	}
+} // namespace
+
+int main(const int argc, char *argv[]) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view argument = argv[i];
+		if (argument == "--filter" && i + 1 < argc) {
+			options.filter = argv[++i];
+		} else if (argument == "--min-time" && i + 1 < argc) {
+			options.minTime = std::max(std::atof(argv[++i]), 0.001);
+		} else if (argument == "--json" && i + 1 < argc) {
+			options.jsonPath = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--filter <text>] [--min-time <seconds>] [--json <file>]\n", argv[0]);
+			return 2;
+		}
+	}
+	// With JSON on stdout, the table goes to stderr instead.
+	const bool jsonToStdout = options.jsonPath == "-";
+	std::FILE *log = jsonToStdout ? stderr : stdout;
+
+	Suite suite(options, log);
+	std::fprintf(log, "%-44s %10s %12s %12s %10s\n", "Benchmark", "Iterations", "us/iter", "Mitems/s", "GB/s");
+	std::string renderer;
+	try {
+		checkDecoders(suite);
+		checkBinning(suite);
+		benchmarkSurface(suite);
+		benchmarkBasicSurfaces(suite);
+		benchmarkLayouts(suite);
+		benchmarkAllocators(suite);
+		benchmarkLines(suite);
+		benchmarkBinning(suite);
+		benchmarkBlend(suite);
+		benchmarkText(suite);
+		benchmarkLayers(suite);
+		benchmarkMandelbrot(suite);
+		benchmarkFractals(suite);
+		renderer = benchmarkUploads(suite);
+	} catch (const std::exception &e) {
+		std::fprintf(stderr, "Benchmark error: %s\n", e.what());
+		return EXIT_FAILURE;
+	}
+
+	if (jsonToStdout) {
+		suite.writeJson(stdout, renderer);
+	} else if (!options.jsonPath.empty()) {
+		std::FILE *file = std::fopen(options.jsonPath.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "Cannot write %s\n", options.jsonPath.c_str());
+			return EXIT_FAILURE;
+		}
+		suite.writeJson(file, renderer);
+		std::fclose(file);
+	}
+	return suite.getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
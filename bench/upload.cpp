@@ -0,0 +1,100 @@
+/*
+* PX-Engine Benchmark - Texture Upload Formats
+ * ---------------------------------------------
+ * Measures glTexSubImage2D throughput for the client pixel layouts a 32-bit
+ * surface can be uploaded with, at a few common resolutions.
+ *
+ * The layout marked with '*' is the one the engine was compiled for (see
+ * pixelFormat.h). Formats the driver has to swizzle show up as a large drop
+ * in MB/s compared to the native one.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "glPixelFormat.h"
+#include "window.h"
+
+namespace {
+	struct UploadFormat {
+		const char *name;
+		GLenum format;
+		GLenum type;
+	};
+
+	constexpr UploadFormat uploadFormats[] = {
+			{"RGBA / UNSIGNED_BYTE", GL_RGBA, GL_UNSIGNED_BYTE},
+			{"BGRA / UNSIGNED_BYTE", GL_BGRA, GL_UNSIGNED_BYTE},
+			{"RGBA / UNSIGNED_INT_8_8_8_8_REV", GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV},
+			{"BGRA / UNSIGNED_INT_8_8_8_8_REV", GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV},
+	};
+
+	struct Resolution {
+		int width;
+		int height;
+	};
+
+	constexpr Resolution resolutions[] = {{320, 180}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+	constexpr int warmupIterations = 10;
+	constexpr int measuredIterations = 100;
+
+	double measureUpload(const UploadFormat &uploadFormat, const Resolution &resolution) {
+		using clock = std::chrono::steady_clock;
+		const std::vector<uint32_t> pixels(static_cast<size_t>(resolution.width) * resolution.height, 0xFF336699);
+
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, resolution.width, resolution.height, 0, uploadFormat.format,
+					 uploadFormat.type, nullptr);
+
+		auto upload = [&] {
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, resolution.width, resolution.height, uploadFormat.format,
+							uploadFormat.type, pixels.data());
+		};
+		for (int i = 0; i < warmupIterations; i++) {
+			upload();
+		}
+		glFinish();
+
+		const auto start = clock::now();
+		for (int i = 0; i < measuredIterations; i++) {
+			upload();
+		}
+		glFinish();
+		const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+		glDeleteTextures(1, &texture);
+		const double bytes = static_cast<double>(pixels.size() * sizeof(uint32_t)) * measuredIterations;
+		return bytes / seconds / 1e6;
+	}
+} // namespace
+
+int main() {
+	try {
+		const pxe::Window window(64, 64, "PX-Engine Upload Benchmark");
+		if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+			throw std::runtime_error("Failed to initialize GLAD");
+		}
+		std::printf("Renderer: %s\n\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+		std::printf("%-34s %12s %12s\n", "Format", "Resolution", "MB/s");
+
+		for (const auto &uploadFormat: uploadFormats) {
+			const bool native = uploadFormat.format == pxe::surfaceGLFormat.format &&
+								uploadFormat.type == pxe::surfaceGLFormat.type;
+			for (const auto &resolution: resolutions) {
+				const double throughput = measureUpload(uploadFormat, resolution);
+				char size[32];
+				std::snprintf(size, sizeof(size), "%dx%d", resolution.width, resolution.height);
+				std::printf("%c %-32s %12s %12.1f\n", native ? '*' : ' ', uploadFormat.name, size, throughput);
+			}
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "Benchmark error: " << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -1,102 +1,86 @@
 /*
 * PX-Engine Demo - Mandelbrot Set Visualization
  * -----------------------------------------------
- * This demo showcases a Mandelbrot set visualization using the PX-Engine.
- * The visualization maps each pixel to a point in the complex plane and
- * iterates the Mandelbrot equation to determine its color.
+ * This demo showcases a Mandelbrot set explorer built on the PX-Engine's
+ * fractal renderer. Each pixel is mapped to a point in the complex plane and
+ * colored by how fast the Mandelbrot iteration escapes from it.
  *
  * Features:
- * - Uses pixel-by-pixel iteration to generate the Mandelbrot set.
- * - Maps the display coordinates to the complex plane.
- * - Allows interactive panning using the AWSD keys.
- * - Enables zoom in and out using the Up and Down arrow keys.
+ * - Iterates several points at once with the SIMD kernels of the running CPU
+ *   (SSE2, AVX2, AVX-512 or NEON), skipping the main cardioid and bulb, and
+ *   colors them smoothly instead of in iteration bands.
+ * - Refines every new view from 8x8 blocks to full resolution over several
+ *   frames, spreading the rows over the engine's thread pool.
+ * - Keeps the finished image: panning only computes the newly exposed strips,
+ *   and an unchanged view costs nothing. Retained mode means the surface is
+ *   only rewritten (and re-uploaded) when the image changed.
+ * - Switches to perturbation around an arbitrary-precision reference orbit
+ *   once doubles run out of precision, so zooms go far past 1e-14.
+ * - Raises the iteration limit with the zoom depth.
  * - Uses delta time to ensure smooth interaction.
  *
  * Controls:
  * - Use W/A/S/D to move (pan) the view.
  * - Use UP and DOWN arrows to zoom in and out.
+ * - Use Q and E to halve or double the iteration limit.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include "engine.h"
+#include "fractalRenderer.h"
 #include "keyCodes.h"
 
 class MandelbrotDemo final : public pxe::Engine {
 public:
     MandelbrotDemo(int width, int height, const std::string &title, int pixelSize = 1) :
         Engine(width, height, title, pixelSize),
-        offsetX(0.0), offsetY(0.0),
-        // Initial scale: mapping one pixel to a small step in the complex plane.
-        scale(4.0 / std::min(getWidth(), getHeight()))
+        fractal(getWidth(), getHeight()),
+        initialScale(fractal.getScale())
     {}
 
     void onSetup() override {
-        // Optionally, any one-time setup can be done here.
+        // The renderer keeps its own copy of the image, so the surface is only rewritten when it changes.
+        setRetainedMode(true);
     }
 
     void onUpdate(float deltaTime) override {
-        // Adjust panning with AWSD keys.
-        // We scale the pan speed relative to the current scale to ensure consistent movement.
-        double panSpeed = 200.0 * deltaTime * scale;
-        if (isKeyPressed(pxe::KeyCode::W)) { offsetY += panSpeed; }
-        if (isKeyPressed(pxe::KeyCode::S)) { offsetY -= panSpeed; }
-        if (isKeyPressed(pxe::KeyCode::A)) { offsetX -= panSpeed; }
-        if (isKeyPressed(pxe::KeyCode::D)) { offsetX += panSpeed; }
+        // Pan with AWSD keys, in pixels per second.
+        double panSpeed = 200.0 * deltaTime;
+        if (isKeyPressed(pxe::KeyCode::W)) { fractal.pan(0.0, panSpeed); }
+        if (isKeyPressed(pxe::KeyCode::S)) { fractal.pan(0.0, -panSpeed); }
+        if (isKeyPressed(pxe::KeyCode::A)) { fractal.pan(-panSpeed, 0.0); }
+        if (isKeyPressed(pxe::KeyCode::D)) { fractal.pan(panSpeed, 0.0); }
 
         // Adjust zoom with Up and Down arrow keys.
         // Zooming is done by modifying the scale: decreasing it zooms in, increasing zooms out.
         double zoomSpeed = 1.5 * deltaTime;
-        if (isKeyPressed(pxe::KeyCode::UpArrow)) { scale *= (1 - zoomSpeed); }
-        if (isKeyPressed(pxe::KeyCode::DownArrow)) { scale *= (1 + zoomSpeed); }
+        if (isKeyPressed(pxe::KeyCode::UpArrow)) { fractal.setScale(fractal.getScale() * (1 - zoomSpeed)); }
+        if (isKeyPressed(pxe::KeyCode::DownArrow)) { fractal.setScale(fractal.getScale() * (1 + zoomSpeed)); }
 
-        // Render the Mandelbrot set.
-        int width = getWidth();
-        int height = getHeight();
-        // Loop over each pixel.
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                // Map the pixel to a point in the complex plane.
-                // We center the view at (offsetX, offsetY).
-                double real = (x - width / 2) * scale + offsetX;
-                double imag = (y - height / 2) * scale + offsetY;
+        // Deeper views need more iterations to resolve their detail.
+        if (wasKeyPressed(pxe::KeyCode::E)) { iterationFactor = std::min(iterationFactor * 2.0, 64.0); }
+        if (wasKeyPressed(pxe::KeyCode::Q)) { iterationFactor = std::max(iterationFactor / 2.0, 1.0 / 16.0); }
+        double octaves = std::max(0.0, std::log2(initialScale / fractal.getScale()));
+        int iterations = static_cast<int>((256.0 + 100.0 * octaves) * iterationFactor);
+        fractal.setMaxIterations(std::clamp(iterations, 16, 1 << 20));
 
-                // Mandelbrot iteration.
-                const int maxIter = 100;
-                int iter = 0;
-                double zr = 0.0, zi = 0.0;
-                while ((zr * zr + zi * zi <= 4.0) && (iter < maxIter)) {
-                    double temp = zr * zr - zi * zi + real;
-                    zi = 2.0 * zr * zi + imag;
-                    zr = temp;
-                    iter++;
-                }
-
-                // Choose a color based on the number of iterations.
-                int r, g, b;
-                if (iter == maxIter) {
-                    // Points inside the set are drawn black.
-                    r = g = b = 0;
-                } else {
-                    // Points outside the set are colored using a simple gradient.
-                    double t = static_cast<double>(iter) / maxIter;
-                    r = static_cast<int>(9 * (1 - t) * t * t * t * 255);
-                    g = static_cast<int>(15 * (1 - t) * (1 - t) * t * t * 255);
-                    b = static_cast<int>(8.5 * (1 - t) * (1 - t) * (1 - t) * t * 255);
-                }
-                drawPixel(x, y, r, g, b);
-            }
+        // Refine the image on the thread pool; copy it to the surface only if it changed.
+        if (fractal.update([this](int count, const auto &body) { parallelFor(count, body); })) {
+            fractal.copyTo(lockRows());
         }
     }
 
 private:
-    double offsetX, offsetY; // Offsets in the complex plane for panning.
-    double scale;          // Scale factor (complex-plane units per pixel).
+    pxe::FractalRenderer fractal;
+    double initialScale;         // Scale of the initial view, the reference for the iteration limit.
+    double iterationFactor = 1.0; // Multiplier of the automatic iteration limit (Q/E).
 };
 
 int main() {
     try {
-        MandelbrotDemo demo(100, 60, "Mandelbrot Set Demo - PX-Engine", 8);
+        MandelbrotDemo demo(400, 240, "Mandelbrot Set Demo - PX-Engine", 2);
         demo.run();
     } catch (const std::exception &e) {
         std::cerr << "Application error: " << e.what() << '\n';
@@ -5,7 +5,7 @@
  * The square is centered in the window and rotates over time.
  *
  * Features:
- * - Uses Bresenham’s line algorithm to draw lines (provided by the engine).
+ * - Draws the edges as one clipped batch of lines (provided by the engine).
  * - Applies 2D transformations using GLM (rotation and translation).
  * - Changes color when the space key is pressed.
  * - Uses delta time to ensure smooth rotation.
@@ -49,11 +49,12 @@ public:
 		pxe::Color c = isKeyPressed(pxe::KeyCode::Space) ? pxe::Color::Magenta : pxe::Color::White;
 
 		// Draw the square edges
+		pxe::Line edges[4];
 		for (int i = 0; i < 4; i++) {
-			drawLine(static_cast<int>(vertices[i].x), static_cast<int>(vertices[i].y),
-					 static_cast<int>(vertices[(i + 1) % 4].x), static_cast<int>(vertices[(i + 1) % 4].y), c.r(), c.g(),
-					 c.b());
+			edges[i] = {static_cast<int>(vertices[i].x), static_cast<int>(vertices[i].y),
+						static_cast<int>(vertices[(i + 1) % 4].x), static_cast<int>(vertices[(i + 1) % 4].y)};
 		}
+		drawLines(edges, c);
 
 		// Increase rotation angle
 		rotationAngle += velocity * deltaTime;
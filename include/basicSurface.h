@@ -0,0 +1,434 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include "color.h"
+#include "geometry.h"
+#include "surfaceAllocator.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief 32-bit direct color, in the native `PixelFormat` layout of `Color::pixel()` (0xAARRGGBB by default).
+	 */
+	struct Argb8888Format {
+		using Storage = uint32_t; ///< One stored pixel.
+		using Value = Color; ///< What `setPixel` takes and `getPixel` returns.
+
+		[[nodiscard]] static constexpr Storage pack(const Color color) { return color.pixel(); }
+
+		[[nodiscard]] static constexpr Color unpack(const Storage pixel) { return Color::fromPixel(pixel); }
+	};
+
+	/**
+	 * @brief 16-bit opaque direct color: 5 bits of red in the high bits, 6 of green and 5 of blue.
+	 *
+	 * Packing truncates each channel; unpacking replicates the high bits into the low ones, so black and
+	 * white survive a round trip exactly.
+	 */
+	struct Rgb565Format {
+		using Storage = uint16_t;
+		using Value = Color;
+
+		[[nodiscard]] static constexpr Storage pack(const Color color) {
+			return static_cast<Storage>((color.r() & 0xF8) << 8 | (color.g() & 0xFC) << 3 | color.b() >> 3);
+		}
+
+		[[nodiscard]] static constexpr Color unpack(const Storage pixel) {
+			const int red = pixel >> 11;
+			const int green = (pixel >> 5) & 0x3F;
+			const int blue = pixel & 0x1F;
+			return Color(static_cast<uint8_t>(red << 3 | red >> 2), static_cast<uint8_t>(green << 2 | green >> 4),
+						 static_cast<uint8_t>(blue << 3 | blue >> 2));
+		}
+	};
+
+	/**
+	 * @brief 8-bit palette index; the colors live in a separate palette.
+	 */
+	struct Indexed8Format {
+		using Storage = uint8_t;
+		using Value = uint8_t; ///< The palette index.
+
+		[[nodiscard]] static constexpr Storage pack(const Value index) { return index; }
+
+		[[nodiscard]] static constexpr Value unpack(const Storage pixel) { return pixel; }
+	};
+
+	/**
+	 * @brief Bounds policy ignoring writes outside the surface and reading them as `Value{}`, like `Surface`.
+	 */
+	struct CheckedBounds {
+		/**
+		 * @brief Maps a coordinate onto the surface.
+		 * @return True if the (possibly adjusted) coordinate may be accessed.
+		 */
+		[[nodiscard]] static constexpr bool resolve(int &x, int &y, const int width, const int height) {
+			return static_cast<unsigned>(x) < static_cast<unsigned>(width) &&
+				   static_cast<unsigned>(y) < static_cast<unsigned>(height);
+		}
+	};
+
+	/**
+	 * @brief Bounds policy moving outside coordinates to the nearest edge pixel, e.g. for edge-extended sampling.
+	 */
+	struct ClampedBounds {
+		[[nodiscard]] static constexpr bool resolve(int &x, int &y, const int width, const int height) {
+			if (width <= 0 || height <= 0)
+				return false;
+			x = std::clamp(x, 0, width - 1);
+			y = std::clamp(y, 0, height - 1);
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Bounds policy for callers that already clipped: only asserts, so release builds have no branch.
+	 */
+	struct UncheckedBounds {
+		[[nodiscard]] static constexpr bool resolve([[maybe_unused]] const int &x, [[maybe_unused]] const int &y,
+													[[maybe_unused]] const int width,
+													[[maybe_unused]] const int height) {
+			assert(x >= 0 && x < width && y >= 0 && y < height);
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Copies the top-left `view.getWidth()` x `view.getHeight()` pixels of a row-major 32-bit buffer.
+	 */
+	void detileLinear(const uint32_t *pixels, int pitch, const SurfaceView &view);
+
+	/**
+	 * @brief Copies the top-left pixels of a `TiledLayout` 32-bit buffer into the rows of a view.
+	 */
+	void detileBlocked(const uint32_t *pixels, int pitch, int tileSize, const SurfaceView &view);
+
+	/**
+	 * @brief Copies the top-left pixels of a `MortonLayout` 32-bit buffer into the rows of a view, with SIMD
+	 * kernels for every whole tile.
+	 */
+	void detileMorton(const uint32_t *pixels, int pitch, const SurfaceView &view);
+
+	/**
+	 * @brief Layout policy storing rows one after the other, like `Surface`.
+	 */
+	struct LinearLayout {
+		/// Rows and columns are padded to multiples of this many pixels.
+		static constexpr int tileSize = 1;
+		/// Pixels of a row starting at a multiple of this many are contiguous in memory: here, whole rows.
+		static constexpr int runLength = 1 << 30;
+
+		/**
+		 * @brief Gets the pitch, in pixels, of a surface of `width` pixels.
+		 */
+		[[nodiscard]] static constexpr int pitch(const int width, const size_t pixelBytes) {
+			return alignedPitch(width, pixelBytes);
+		}
+
+		/**
+		 * @brief Gets the index of a pixel in the buffer.
+		 */
+		[[nodiscard]] static constexpr size_t offset(const int x, const int y, const int pitch) {
+			return static_cast<size_t>(y) * pitch + x;
+		}
+
+		static void detile(const uint32_t *pixels, const int pitch, const SurfaceView &view) {
+			detileLinear(pixels, pitch, view);
+		}
+	};
+
+	/**
+	 * @brief Layout policy storing square tiles of `TileSize` x `TileSize` pixels one after the other.
+	 *
+	 * Tiles are row-major and so are the pixels inside them, so a 2D neighborhood spans few cache lines and
+	 * pages whatever the direction a loop walks in: an 8x8 tile of 32-bit pixels is 4 cache lines, where the
+	 * same pixels of a 1080p linear surface touch 8 lines and 8 pages.
+	 * @tparam TileSize Edge of a tile in pixels, a power of two from 8 to 64.
+	 */
+	template<int TileSize = 8>
+	struct TiledLayout {
+		static_assert(TileSize >= 8 && TileSize <= 64 && (TileSize & (TileSize - 1)) == 0,
+					  "Tile size must be a power of two from 8 to 64");
+		static constexpr int tileSize = TileSize;
+		static constexpr int runLength = TileSize;
+
+		/**
+		 * @brief Gets the width padded to whole tiles; a row of tiles spans `pitch * TileSize` pixels.
+		 */
+		[[nodiscard]] static constexpr int pitch(const int width, size_t) {
+			return (width + TileSize - 1) & ~(TileSize - 1);
+		}
+
+		[[nodiscard]] static constexpr size_t offset(const int x, const int y, const int pitch) {
+			constexpr int mask = TileSize - 1;
+			return static_cast<size_t>(y & ~mask) * pitch + static_cast<size_t>(x & ~mask) * TileSize +
+				   static_cast<size_t>((y & mask) * TileSize + (x & mask));
+		}
+
+		static void detile(const uint32_t *pixels, const int pitch, const SurfaceView &view) {
+			detileBlocked(pixels, pitch, TileSize, view);
+		}
+	};
+
+	/**
+	 * @brief Layout policy storing 16x16 tiles one after the other, with the pixels of a tile in Morton (Z) order.
+	 *
+	 * Interleaving the coordinate bits keeps every aligned 2x2, 4x4 and 8x8 block contiguous: a 4x4 block of
+	 * 32-bit pixels is exactly one cache line, which suits access that is local in 2D but has no preferred
+	 * direction, such as rotated or scaled sampling.
+	 */
+	struct MortonLayout {
+		static constexpr int tileSize = 16;
+		static constexpr int runLength = 2;
+
+		[[nodiscard]] static constexpr int pitch(const int width, size_t) { return (width + 15) & ~15; }
+
+		[[nodiscard]] static constexpr size_t offset(const int x, const int y, const int pitch) {
+			return static_cast<size_t>(y & ~15) * pitch + static_cast<size_t>(x & ~15) * 16 +
+				   static_cast<size_t>(spreadBits(x & 15) | spreadBits(y & 15) << 1);
+		}
+
+		static void detile(const uint32_t *pixels, const int pitch, const SurfaceView &view) {
+			detileMorton(pixels, pitch, view);
+		}
+
+	private:
+		// Moves the 4 bits of `value` to the even bit positions.
+		static constexpr int spreadBits(int value) {
+			value = (value | value << 2) & 0x33;
+			return (value | value << 1) & 0x55;
+		}
+	};
+
+	/**
+	 * @brief An off-screen pixel buffer specialized at compile time on its pixel format, bounds policy and layout.
+	 *
+	 * Where `Surface` is the engine's dirty-tracked 32-bit drawing target, a `BasicSurface` is a plain
+	 * buffer for content that does not need 4 bytes per pixel (`Rgb565Format` halves and `Indexed8Format`
+	 * quarters the memory traffic of 32-bit pixels) and for hot loops that clip up front and should not
+	 * pay a bounds check per pixel (`UncheckedBounds`). Rows start on `rowAlignment` byte boundaries, so
+	 * `getPitch()` may exceed the width; the padding is never displayed.
+	 *
+	 * A tiled layout (`TiledLayout`, `MortonLayout`) trades the row access of `row()` and of the upload for
+	 * locality in both directions: columns, diagonals and rotated reads stay within a few cache lines. Draw
+	 * through `setPixel`, `at` or `fillRect`, which all address pixels through the layout, and convert the
+	 * finished image to rows with `copyTo`, e.g. into `Engine::lockRows()`.
+	 * @tparam Format `Argb8888Format`, `Rgb565Format` or `Indexed8Format`.
+	 * @tparam Bounds `CheckedBounds`, `ClampedBounds` or `UncheckedBounds`; applies to `setPixel` and `getPixel`.
+	 * @tparam Layout `LinearLayout`, `TiledLayout<8>`, `TiledLayout<16>` or `MortonLayout`.
+	 */
+	template<typename Format, typename Bounds = CheckedBounds, typename Layout = LinearLayout>
+	class BasicSurface {
+	public:
+		using Storage = typename Format::Storage;
+		using Value = typename Format::Value;
+
+		/// Alignment in bytes of the buffer and of every row.
+		static constexpr size_t rowAlignment = pixelAlignment;
+
+		/**
+		 * @brief Creates a surface with every pixel set to `Value{}` (opaque black, or palette index 0).
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 * @param allocator Where the pixels come from, e.g. a `FrameArena` for scratch surfaces; must outlive
+		 * the surface.
+		 * @throws std::invalid_argument if a size is negative.
+		 */
+		BasicSurface(const int width, const int height, SurfaceAllocator &allocator = SurfaceAllocator::getDefault()) :
+			width(checkedSize(width)), height(checkedSize(height)), pitch(Layout::pitch(width, sizeof(Storage))),
+			rows((height + Layout::tileSize - 1) / Layout::tileSize * Layout::tileSize),
+			pixels(allocator, static_cast<size_t>(pitch) * rows * sizeof(Storage)) {
+			clear();
+		}
+
+		BasicSurface(const BasicSurface &) = delete;
+		BasicSurface &operator=(const BasicSurface &) = delete;
+		BasicSurface(BasicSurface &&) noexcept = default;
+		BasicSurface &operator=(BasicSurface &&) noexcept = default;
+
+		/**
+		 * @brief Writes a pixel, subject to the bounds policy.
+		 */
+		void setPixel(int x, int y, const Value value) {
+			if (Bounds::resolve(x, y, width, height)) {
+				at(x, y) = Format::pack(value);
+			}
+		}
+
+		/**
+		 * @brief Reads a pixel, subject to the bounds policy; rejected coordinates read as `Value{}`.
+		 */
+		[[nodiscard]] Value getPixel(int x, int y) const {
+			if (Bounds::resolve(x, y, width, height))
+				return Format::unpack(at(x, y));
+			return Value{};
+		}
+
+		/**
+		 * @brief Gets a pixel in the layout's order without bounds checking, for loops that clipped up front.
+		 * @param x X-coordinate; only asserted.
+		 * @param y Y-coordinate; only asserted.
+		 */
+		[[nodiscard]] Storage &at(const int x, const int y) {
+			assert(x >= 0 && x < width && y >= 0 && y < height);
+			return pixels.as<Storage>()[Layout::offset(x, y, pitch)];
+		}
+
+		[[nodiscard]] const Storage &at(const int x, const int y) const {
+			assert(x >= 0 && x < width && y >= 0 && y < height);
+			return pixels.as<Storage>()[Layout::offset(x, y, pitch)];
+		}
+
+		/**
+		 * @brief Sets every pixel, including the padding, to one value.
+		 */
+		void fill(const Value value) {
+			std::fill_n(pixels.as<Storage>(), static_cast<size_t>(pitch) * rows, Format::pack(value));
+		}
+
+		/**
+		 * @brief Sets every pixel to `Value{}`.
+		 */
+		void clear() { fill(Value{}); }
+
+		/**
+		 * @brief Fills a rectangle, clipped once against the surface whatever the bounds policy.
+		 */
+		void fillRect(const Rect &region, const Value value) {
+			const int x0 = std::max(region.x, 0);
+			const int y0 = std::max(region.y, 0);
+			const int x1 = std::min(region.right(), width);
+			const int y1 = std::min(region.bottom(), height);
+			const Storage pixel = Format::pack(value);
+			for (int y = y0; y < y1; y++) {
+				// One block fill per run of pixels the layout keeps contiguous.
+				for (int x = x0; x < x1;) {
+					const int end = std::min(x1, (x & ~(Layout::runLength - 1)) + Layout::runLength);
+					std::fill_n(&at(x, y), end - x, pixel);
+					x = end;
+				}
+			}
+		}
+
+		/**
+		 * @brief Draws a line; both endpoints are included and pixels outside the surface are skipped.
+		 */
+		void drawLine(const Line &line, const Value value) {
+			const Storage pixel = Format::pack(value);
+			const int dx = std::abs(line.x1 - line.x0);
+			const int dy = -std::abs(line.y1 - line.y0);
+			const int stepX = line.x0 < line.x1 ? 1 : -1;
+			const int stepY = line.y0 < line.y1 ? 1 : -1;
+			int x = line.x0;
+			int y = line.y0;
+			int error = dx + dy;
+			while (true) {
+				if (static_cast<unsigned>(x) < static_cast<unsigned>(width) &&
+					static_cast<unsigned>(y) < static_cast<unsigned>(height)) {
+					at(x, y) = pixel;
+				}
+				if (x == line.x1 && y == line.y1)
+					break;
+				const int doubled = 2 * error;
+				if (doubled >= dy) {
+					error += dy;
+					x += stepX;
+				}
+				if (doubled <= dx) {
+					error += dx;
+					y += stepY;
+				}
+			}
+		}
+
+		/**
+		 * @brief Copies the pixels into the rows of a view, converting them from the layout; 32-bit formats only.
+		 *
+		 * Copies the top-left `view.getWidth()` x `view.getHeight()` pixels, clipped to the surface.
+		 * @param view The destination, e.g. `Engine::lockRows()`.
+		 */
+		void copyTo(const SurfaceView &view) const {
+			static_assert(std::is_same_v<Storage, uint32_t>, "copyTo needs 32-bit pixels");
+			Layout::detile(data(), pitch, view.subView(getBounds()));
+		}
+
+		/**
+		 * @brief Gets the first pixel of a row, for loops writing packed `Storage` values directly; linear layout only.
+		 * @param y Row index; only asserted.
+		 */
+		[[nodiscard]] Storage *row(const int y) {
+			static_assert(std::is_same_v<Layout, LinearLayout>, "Rows are only contiguous in a linear layout");
+			assert(y >= 0 && y < height);
+			return pixels.as<Storage>() + static_cast<ptrdiff_t>(y) * pitch;
+		}
+
+		[[nodiscard]] const Storage *row(const int y) const {
+			static_assert(std::is_same_v<Layout, LinearLayout>, "Rows are only contiguous in a linear layout");
+			assert(y >= 0 && y < height);
+			return pixels.as<Storage>() + static_cast<ptrdiff_t>(y) * pitch;
+		}
+
+		/**
+		 * @brief Gets the first pixel of the buffer, aligned to `rowAlignment`.
+		 */
+		[[nodiscard]] const Storage *data() const { return pixels.as<Storage>(); }
+
+		[[nodiscard]] int getWidth() const { return width; }
+
+		[[nodiscard]] int getHeight() const { return height; }
+
+		/**
+		 * @brief Gets the padded width in pixels: the distance between two rows in a linear layout, and between
+		 * two rows of tiles divided by the tile size in a tiled one.
+		 */
+		[[nodiscard]] int getPitch() const { return pitch; }
+
+		/**
+		 * @brief Gets the size of the buffer in bytes, padding included.
+		 */
+		[[nodiscard]] size_t getSizeBytes() const { return static_cast<size_t>(pitch) * rows * sizeof(Storage); }
+
+		/**
+		 * @brief Gets the rectangle (0, 0, width, height).
+		 */
+		[[nodiscard]] Rect getBounds() const { return {0, 0, width, height}; }
+
+	private:
+		int width, height, pitch;
+		int rows; ///< Height padded to whole tiles.
+		PixelStorage pixels;
+
+		static int checkedSize(const int size) {
+			if (size < 0) {
+				throw std::invalid_argument("Surface size must not be negative");
+			}
+			return size;
+		}
+	};
+
+	/// The surface of palette indices drawn in the engine's indexed mode.
+	using IndexedSurface = BasicSurface<Indexed8Format>;
+} // namespace pxe
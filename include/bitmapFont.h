@@ -0,0 +1,102 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "geometry.h"
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief A fixed-width bitmap font, rasterized once into an atlas image.
+	 *
+	 * Glyphs are one bit per pixel and cover a contiguous range of characters; text is laid out on a grid
+	 * of `getAdvance()` x `getLineHeight()` cells, with '\n' starting a new line. Characters outside the
+	 * range are drawn as '?' when the font has one, and as blank cells otherwise. `Engine::drawText` draws
+	 * with the embedded default font, an ASCII font of 5x7 pixel capitals with two rows of descenders.
+	 */
+	class BitmapFont {
+	public:
+		/**
+		 * @brief Creates a font from one-bit glyph rows.
+		 * @param glyphWidth Width of every glyph in pixels, 1 to 8.
+		 * @param glyphHeight Height of every glyph in pixels.
+		 * @param firstCharacter The character of the first glyph; the others follow in character order.
+		 * @param rows `glyphHeight` bytes per glyph, top row first; bit `glyphWidth - 1` is the leftmost pixel.
+		 * @param spacing Blank columns between two glyphs.
+		 * @param lineSpacing Blank rows between two lines.
+		 * @throws std::invalid_argument if a size is out of range or `rows` does not hold whole glyphs.
+		 */
+		BitmapFont(int glyphWidth, int glyphHeight, char firstCharacter, std::span<const uint8_t> rows,
+				   int spacing = 1, int lineSpacing = 1);
+
+		/**
+		 * @brief Gets the embedded default font, covering the printable ASCII characters ' ' to '~'.
+		 */
+		[[nodiscard]] static const BitmapFont &getDefault();
+
+		/**
+		 * @brief Gets the atlas: every glyph side by side in one row, opaque white on transparent.
+		 */
+		[[nodiscard]] const Image &getAtlas() const { return atlas; }
+
+		/**
+		 * @brief Gets the region of the atlas holding a character's glyph.
+		 * @return The glyph of `character`, of the fallback '?', or an empty rectangle for a blank cell.
+		 */
+		[[nodiscard]] Rect getGlyphRegion(char character) const;
+
+		/**
+		 * @brief Gets the size of a text's layout.
+		 * @return (0, 0, width, height) of the bounding box of every cell used, without trailing spacing.
+		 */
+		[[nodiscard]] Rect measure(std::string_view text) const;
+
+		[[nodiscard]] int getGlyphWidth() const { return glyphWidth; }
+
+		[[nodiscard]] int getGlyphHeight() const { return glyphHeight; }
+
+		/**
+		 * @brief Gets the distance in pixels between the left edges of two consecutive glyphs.
+		 */
+		[[nodiscard]] int getAdvance() const { return glyphWidth + spacing; }
+
+		/**
+		 * @brief Gets the distance in pixels between the top edges of two consecutive lines.
+		 */
+		[[nodiscard]] int getLineHeight() const { return glyphHeight + lineSpacing; }
+
+		/**
+		 * @brief Gets an identifier unique to this font and its copies, the key of cached layouts.
+		 */
+		[[nodiscard]] uint64_t getId() const { return id; }
+
+	private:
+		int glyphWidth;
+		int glyphHeight;
+		int spacing;
+		int lineSpacing;
+		unsigned char firstCharacter;
+		int glyphCount;
+		int fallback = -1; ///< Glyph index of '?', or -1 when the font does not have it.
+		uint64_t id;
+		Image atlas;
+	};
+} // namespace pxe
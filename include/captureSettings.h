@@ -0,0 +1,58 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace pxe {
+	/**
+	 * @brief Container written by a frame capture.
+	 */
+	enum class CaptureFormat {
+		/// Raw frames back to back, four bytes per pixel in the `PixelFormat` byte order (BGRA by default).
+		Raw,
+		/// A YUV4MPEG2 stream (4:2:0, full range BT.601) that most video tools read directly.
+		Y4M,
+		/// One PNG file per frame, named `<path>000000.png`, `<path>000001.png`, and so on.
+		PngSequence,
+		/// Raw frames piped to an `ffmpeg` process found on the `PATH`, which encodes them to `path`.
+		Ffmpeg,
+	};
+
+	/**
+	 * @brief Settings of a frame capture started with `Engine::startCapture`.
+	 */
+	struct CaptureSettings {
+		CaptureFormat format = CaptureFormat::Y4M;
+		std::string path; ///< Output file, file name prefix for `PngSequence`, or ffmpeg output file.
+		double frameRate = 60.0; ///< Frame rate recorded in Y4M headers and passed to ffmpeg.
+		int queueDepth = 8; ///< Frames that may wait for the writer thread before new ones are dropped.
+		/// When false, a full queue makes the render loop wait for the writer instead of dropping the frame,
+		/// e.g. for headless batch renders where every frame matters more than the frame rate.
+		bool dropWhenBehind = true;
+	};
+
+	/**
+	 * @brief Progress of the current or last frame capture.
+	 */
+	struct CaptureStats {
+		size_t framesWritten = 0;
+		size_t framesDropped = 0; ///< Frames skipped because the writer thread fell behind.
+	};
+} // namespace pxe
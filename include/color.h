@@ -18,17 +18,18 @@
 
 #pragma once
 #include <cstdint>
+#include "pixelFormat.h"
 
 namespace pxe {
 	/**
 	 * @brief Represents an RGBA color using a compact 32-bit storage.
 	 *
-	 * The color is stored in 0xAARRGGBB format, where the alpha channel occupies the most
-	 * significant 8 bits. By default, the alpha channel is set to 255 (fully opaque).
+	 * The color is stored already packed in the engine's `PixelFormat` (0xAARRGGBB by default), so it can
+	 * be written to a surface without repacking. By default, the alpha channel is set to 255 (fully opaque).
 	 */
 	struct Color {
 	private:
-		uint32_t value; // Stores color in 0xAARRGGBB format
+		uint32_t value; // Stores color in the native PixelFormat layout
 
 	public:
 		/**
@@ -40,35 +41,54 @@ namespace pxe {
 		 * @param alpha Alpha component (0-255, default is 255 for fully opaque).
 		 */
 		explicit constexpr Color(const uint8_t red = 0, const uint8_t green = 0, const uint8_t blue = 0, const uint8_t alpha = 255)
-			: value((static_cast<uint32_t>(alpha) << 24) | (red << 16) | (green << 8) | blue) {}
+			: value(PixelFormat::pack(red, green, blue, alpha)) {}
+
+		/**
+		 * @brief Creates a color from a pixel already packed in the native `PixelFormat`.
+		 *
+		 * @param pixel The packed pixel value.
+		 * @return The color holding that pixel.
+		 */
+		[[nodiscard]] static constexpr Color fromPixel(const uint32_t pixel) {
+			Color color;
+			color.value = pixel;
+			return color;
+		}
+
+		/**
+		 * @brief Retrieves the color packed in the native `PixelFormat`.
+		 *
+		 * @return The packed pixel value.
+		 */
+		[[nodiscard]] constexpr uint32_t pixel() const { return value; }
 
 		/**
 		 * @brief Retrieves the red component.
 		 *
 		 * @return The red component (0-255).
 		 */
-		[[nodiscard]] constexpr uint8_t r() const { return (value >> 16) & 0xFF; }
+		[[nodiscard]] constexpr uint8_t r() const { return PixelFormat::red(value); }
 
 		/**
 		 * @brief Retrieves the green component.
 		 *
 		 * @return The green component (0-255).
 		 */
-		[[nodiscard]] constexpr uint8_t g() const { return (value >> 8) & 0xFF; }
+		[[nodiscard]] constexpr uint8_t g() const { return PixelFormat::green(value); }
 
 		/**
 		 * @brief Retrieves the blue component.
 		 *
 		 * @return The blue component (0-255).
 		 */
-		[[nodiscard]] constexpr uint8_t b() const { return value & 0xFF; }
+		[[nodiscard]] constexpr uint8_t b() const { return PixelFormat::blue(value); }
 
 		/**
 		 * @brief Retrieves the alpha component.
 		 *
 		 * @return The alpha component (0-255).
 		 */
-		[[nodiscard]] constexpr uint8_t a() const { return (value >> 24) & 0xFF; }
+		[[nodiscard]] constexpr uint8_t a() const { return PixelFormat::alpha(value); }
 
 		// Predefined Colors (Fully opaque by default)
 		static const Color Black;
@@ -79,6 +99,7 @@ namespace pxe {
 		static const Color Yellow;
 		static const Color Cyan;
 		static const Color Magenta;
+		static const Color Transparent; ///< Fully transparent black, the premultiplied form of any invisible color.
 	};
 
 	// Define static color constants **outside** the class body
@@ -90,5 +111,6 @@ namespace pxe {
 	inline constexpr Color Color::Yellow{255, 255, 0};
 	inline constexpr Color Color::Cyan{0, 255, 255};
 	inline constexpr Color Color::Magenta{255, 0, 255};
+	inline constexpr Color Color::Transparent{0, 0, 0, 0};
 
 } // namespace pxe
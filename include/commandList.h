@@ -0,0 +1,157 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+#include "color.h"
+#include "geometry.h"
+
+namespace pxe {
+	/**
+	 * @brief A recorded sequence of draw calls, replayed into the frame with `Engine::submit`.
+	 *
+	 * A list is plain data: it can be built on any thread (one list per thread), kept across frames and
+	 * submitted again without re-recording. Recording already does the work that is cheaper before
+	 * rasterization:
+	 * - Primitives entirely outside the cull rectangle, or covering no pixel, are dropped.
+	 * - A span or pixel continuing the previous span on the same row is merged into it, and so is a
+	 *   rectangle of the same color extending the previous one, so plotting loops become a few commands.
+	 *
+	 * Commands are only merged with the one recorded just before, so the order of draws is preserved.
+	 */
+	class CommandList {
+	public:
+		enum class CommandType : uint8_t { FillRect, Line, Circle, FilledCircle, Triangle, Span };
+
+		/**
+		 * @brief One recorded draw; the meaning of `values` depends on the type.
+		 *
+		 * FillRect: x, y, width, height. Line: x0, y0, x1, y1. Circle and FilledCircle: center x, center y,
+		 * radius. Triangle: the three vertices. Span: x, y, pixel count and index of the first pixel in
+		 * `getSpanPixels()`. Unused values are zero.
+		 */
+		struct Command {
+			CommandType type;
+			uint32_t pixel; ///< Packed color; unused by spans.
+			int values[6];
+		};
+
+		/**
+		 * @brief Creates a list that only drops primitives covering no pixel at all.
+		 */
+		CommandList();
+
+		/**
+		 * @brief Creates a list that also drops primitives entirely outside (0, 0, width, height).
+		 *
+		 * Typically the surface size, `Engine::getWidth()` x `Engine::getHeight()`.
+		 */
+		CommandList(int width, int height);
+
+		void drawPixel(int x, int y, Color color);
+
+		void drawSpan(int x, int y, std::span<const Color> colors);
+
+		void fillRect(const Rect &region, Color color);
+
+		/**
+		 * @brief Records the outline of a rectangle as four rectangles, like `Surface::drawRect`.
+		 */
+		void drawRect(const Rect &region, Color color);
+
+		void drawLine(const Line &line, Color color);
+
+		void drawLines(std::span<const Line> lines, Color color);
+
+		void drawCircle(int centerX, int centerY, int radius, Color color);
+
+		void fillCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Records the outline of a triangle as three lines, like `Surface::drawTriangle`.
+		 */
+		void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Appends the commands of another list, e.g. one recorded on a worker thread.
+		 */
+		void append(const CommandList &other);
+
+		/**
+		 * @brief Re-records the list only if its inputs changed since the last call.
+		 *
+		 * `key` identifies what the list is built from, e.g. a hash of the UI state it draws. When it equals
+		 * the key of the previous call the recorded commands are kept as they are; otherwise the list is
+		 * cleared and `recorder` fills it again.
+		 * @param key Hash of everything the recorded commands depend on.
+		 * @param recorder Records the commands into the list it is given.
+		 * @return True if the list was re-recorded.
+		 */
+		bool update(uint64_t key, const std::function<void(CommandList &list)> &recorder);
+
+		/**
+		 * @brief Removes every command; the cull rectangle stays.
+		 */
+		void clear();
+
+		/**
+		 * @brief Checks whether the list holds no command.
+		 */
+		[[nodiscard]] bool isEmpty() const;
+
+		/**
+		 * @brief Gets the number of commands, after culling and merging.
+		 */
+		[[nodiscard]] size_t getCommandCount() const;
+
+		/**
+		 * @brief Hashes the recorded commands, to tell cheaply whether a list draws the same as before.
+		 *
+		 * Two lists with equal contents have equal hashes. Reads the whole list, at memory speed.
+		 */
+		[[nodiscard]] uint64_t getHash() const;
+
+		[[nodiscard]] std::span<const Command> getCommands() const;
+
+		/**
+		 * @brief Gets the packed pixels of the recorded spans.
+		 */
+		[[nodiscard]] std::span<const uint32_t> getSpanPixels() const;
+
+	private:
+		std::vector<Command> commands;
+		std::vector<uint32_t> spanPixels;
+		Rect cullBounds; ///< Primitives outside are dropped; empty when there is no cull rectangle.
+		std::optional<uint64_t> recordedKey; ///< Key of the last `update` that recorded the current contents.
+
+		/**
+		 * @brief Checks whether a primitive with the given bounding box may cover pixels inside the cull
+		 * rectangle; 64-bit so far off-surface coordinates cannot overflow.
+		 */
+		[[nodiscard]] bool isVisible(int64_t x0, int64_t y0, int64_t x1, int64_t y1) const;
+
+		void addCircle(CommandType type, int centerX, int centerY, int radius, Color color);
+	};
+} // namespace pxe
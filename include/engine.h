@@ -17,10 +17,30 @@
  */
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <initializer_list>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include "basicSurface.h"
+#include "bitmapFont.h"
+#include "captureSettings.h"
 #include "color.h"
+#include "commandList.h"
+#include "frameStats.h"
+#include "geometry.h"
+#include "image.h"
+#include "imageFile.h"
+#include "inputEvent.h"
 #include "keyCodes.h"
+#include "renderSettings.h"
+#include "sprite.h"
+#include "surfaceAllocator.h"
+#include "surfaceView.h"
 
 namespace pxe {
 	/**
@@ -30,6 +50,9 @@ namespace pxe {
 	 */
 	class Engine {
 	public:
+		/// Default edge length in pixels of the tiles handed out by `renderTiles` (64x64 pixels fit in L2).
+		static constexpr int defaultTileSize = 64;
+
 		/**
 		 * @brief Creates an instance of the Pixel Engine.
 		 *
@@ -45,6 +68,20 @@ namespace pxe {
 		 */
 		Engine(int width, int height, const std::string &title, int pixelSize = 1);
 
+		/**
+		 * @brief Creates a headless instance of the Pixel Engine, without any window or input.
+		 *
+		 * Meant for batch rendering, servers without a display and benchmarking the CPU raster path in
+		 * CI. Frames are read back through `setFrameCallback`, and `run(frameCount)` renders them as fast as
+		 * possible unless a `FramePacing::TargetFps` cap is set. Input queries always report nothing pressed.
+		 *
+		 * @param width The width of the engine's drawing surface.
+		 * @param height The height of the engine's drawing surface.
+		 * @param backend Whether frames still go through OpenGL (offscreen) or only through the CPU surface.
+		 * @throws std::runtime_error if the offscreen backend is unavailable in this build or on this system.
+		 */
+		Engine(int width, int height, HeadlessBackend backend);
+
 		/**
 		 * @brief Virtual destructor for Engine.
 		 *
@@ -56,10 +93,31 @@ namespace pxe {
 		 * @brief Starts the main engine loop.
 		 *
 		 * Calls `onSetup()`, then enters the update loop, calling `onUpdate(deltaTime)`
-		 * each frame. Stops when the window is closed, then calls `onDestroy()`.
+		 * each frame. Stops when the window is closed (never, for a headless engine), then calls `onDestroy()`.
+		 * With `ThreadingMode::RenderThread`, `onUpdate` runs on a separate simulation thread
+		 * while this thread presents frames; `onSetup` and `onDestroy` always run here.
 		 */
 		void run();
 
+		/**
+		 * @brief Runs the main loop for at most `frameCount` frames.
+		 *
+		 * Behaves like `run()`, but also returns once `frameCount` frames have been simulated. This is the
+		 * usual way to drive a headless engine, which has no window to close.
+		 * @param frameCount Number of frames to render; negative for no limit.
+		 */
+		void run(int frameCount);
+
+		/**
+		 * @brief Sets a function called with every completed frame.
+		 *
+		 * The callback runs on the thread calling `onUpdate`, after the frame (including the profiler
+		 * overlay) has been drawn and before it is presented. The view is only valid during the call and
+		 * must not be written to.
+		 * @param callback The function receiving the frame index and the finished frame, or null to remove it.
+		 */
+		void setFrameCallback(std::function<void(int frameIndex, const SurfaceView &frame)> callback);
+
 	protected:
 		/**
 		 * @brief Called once when the engine starts.
@@ -76,6 +134,15 @@ namespace pxe {
 		 */
 		virtual void onUpdate(float deltaTime) = 0;
 
+		/**
+		 * @brief Called at a fixed rate when a fixed timestep is set with `setFixedTimestep`.
+		 *
+		 * Runs zero or more times per frame, before `onUpdate`, which then acts as the render step and can
+		 * blend the last two simulation states with `getInterpolationAlpha()`. Does nothing by default.
+		 * @param step The fixed timestep in seconds.
+		 */
+		virtual void onFixedUpdate(float step);
+
 		/**
 		 * @brief Called when the engine is shutting down.
 		 *
@@ -106,6 +173,42 @@ namespace pxe {
 		 */
 		[[nodiscard]] std::pair<double, double> getMousePosition() const;
 
+		/**
+		 * @brief Checks whether a key went down since the previous frame's update.
+		 *
+		 * Input is consumed once per frame, before `onFixedUpdate` and `onUpdate`, so a tap shorter than a
+		 * frame is still reported here even though `isKeyPressed` never sees it held.
+		 * @param key The key to check (based on `KeyCode`).
+		 */
+		[[nodiscard]] bool wasKeyPressed(KeyCode key) const;
+
+		/**
+		 * @brief Checks whether a key went up since the previous frame's update.
+		 * @param key The key to check (based on `KeyCode`).
+		 */
+		[[nodiscard]] bool wasKeyReleased(KeyCode key) const;
+
+		/**
+		 * @brief Checks whether a mouse button went down since the previous frame's update.
+		 * @param button The mouse button to check (based on `MouseButton`).
+		 */
+		[[nodiscard]] bool wasMousePressed(MouseButton button) const;
+
+		/**
+		 * @brief Checks whether a mouse button went up since the previous frame's update.
+		 * @param button The mouse button to check (based on `MouseButton`).
+		 */
+		[[nodiscard]] bool wasMouseReleased(MouseButton button) const;
+
+		/**
+		 * @brief Gets every input event received since the previous frame's update, oldest first.
+		 *
+		 * Events are timestamped when the window system delivers them, so e.g. a drawing tool can follow
+		 * every cursor move between two frames. Empty when headless.
+		 * @return The events; valid until the next frame.
+		 */
+		[[nodiscard]] std::span<const InputEvent> getInputEvents() const;
+
 		/**
 		 * @brief Draws a pixel on the screen using a `Color` object.
 		 *
@@ -150,6 +253,540 @@ namespace pxe {
 		 */
 		void drawLine(int x1, int y1, int x2, int y2, int r, int g, int b);
 
+		/**
+		 * @brief Draws a batch of lines sharing one color.
+		 *
+		 * Each line is clipped once against the surface and drawn without per-pixel bounds checks.
+		 * @param lines The segments to draw; both endpoints of each are included.
+		 * @param color The color of the lines.
+		 */
+		void drawLines(std::span<const Line> lines, Color color);
+
+		/**
+		 * @brief Draws a horizontal run of pixels.
+		 *
+		 * The run is clipped once and copied in a single block, which is much faster than calling
+		 * `drawPixel` for every pixel of a scanline.
+		 * @param x X-coordinate of the first pixel.
+		 * @param y Y-coordinate of the row.
+		 * @param colors The colors of the run, left to right.
+		 */
+		void drawSpan(int x, int y, std::span<const Color> colors);
+
+		/**
+		 * @brief Fills a rectangle with a solid color.
+		 *
+		 * @param x X-coordinate of the top-left corner.
+		 * @param y Y-coordinate of the top-left corner.
+		 * @param width Width of the rectangle in pixels.
+		 * @param height Height of the rectangle in pixels.
+		 * @param color The fill color.
+		 */
+		void fillRect(int x, int y, int width, int height, Color color);
+
+		/**
+		 * @brief Draws the one pixel wide outline of a rectangle, inside its bounds.
+		 *
+		 * @param x X-coordinate of the top-left corner.
+		 * @param y Y-coordinate of the top-left corner.
+		 * @param width Width of the rectangle in pixels.
+		 * @param height Height of the rectangle in pixels.
+		 * @param color The outline color.
+		 */
+		void drawRect(int x, int y, int width, int height, Color color);
+
+		/**
+		 * @brief Draws the one pixel wide outline of a circle.
+		 *
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The outline color.
+		 */
+		void drawCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Fills a circle, including the pixels `drawCircle` would draw for the same radius.
+		 *
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The fill color.
+		 */
+		void fillCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Draws the outline of a triangle.
+		 *
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The outline color.
+		 */
+		void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Fills a triangle.
+		 *
+		 * Vertices sit on pixel corners and a top-left fill rule applies, so meshes of triangles sharing
+		 * edges draw every pixel exactly once.
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The fill color.
+		 */
+		void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Draws an image, e.g. a sprite, with its top-left corner at (x, y).
+		 *
+		 * The image is clipped once against the surface; rows are copied, color-keyed or blended
+		 * several pixels at a time.
+		 * @param image The image to draw.
+		 * @param x X-coordinate of the image's top-left corner.
+		 * @param y Y-coordinate of the image's top-left corner.
+		 * @param mode How image pixels are combined with the surface; `Alpha` expects premultiplied colors.
+		 */
+		void blit(const Image &image, int x, int y, BlendMode mode = BlendMode::Alpha);
+
+		/**
+		 * @brief Draws a region of an image, e.g. one frame of a sprite sheet.
+		 *
+		 * @param image The image to draw from.
+		 * @param sourceRegion The region of `image` to draw.
+		 * @param x X-coordinate of the region's top-left corner on the surface.
+		 * @param y Y-coordinate of the region's top-left corner on the surface.
+		 * @param mode How image pixels are combined with the surface.
+		 */
+		void blit(const Image &image, const Rect &sourceRegion, int x, int y, BlendMode mode = BlendMode::Alpha);
+
+		/**
+		 * @brief Draws text with the top-left corner of its first glyph at (x, y).
+		 *
+		 * The layout of each (text, font, color) is rendered once and cached while it is drawn every frame,
+		 * so a repeated string costs one color-keyed blit; '\n' starts a new line. A color that is not
+		 * opaque is blended like `BlendMode::Alpha` and must be premultiplied.
+		 * @param x X-coordinate of the text's top-left corner.
+		 * @param y Y-coordinate of the text's top-left corner.
+		 * @param text The characters to draw; see `BitmapFont` for those the font lacks.
+		 * @param color The color of the glyphs; the background is left untouched.
+		 * @param font The font to draw with, by default the embedded one.
+		 */
+		void drawText(int x, int y, std::string_view text, Color color,
+					  const BitmapFont &font = BitmapFont::getDefault());
+
+		/**
+		 * @brief Adds an image to the GPU sprite atlas.
+		 *
+		 * Images are packed into a 2048x2048 atlas texture and uploaded the next time sprites are drawn.
+		 * Like `blit` with `BlendMode::Alpha`, sprites expect premultiplied alpha.
+		 * @param image The sprite image; copied, so it may be destroyed afterwards.
+		 * @return The handle to pass to `drawSprite`.
+		 * @throws std::runtime_error if the atlas has no room left for the image.
+		 */
+		SpriteId addSprite(const Image &image);
+
+		/**
+		 * @brief Draws a sprite with its top-left corner at (x, y).
+		 *
+		 * Unlike `blit`, sprites are not written into the surface: every sprite drawn during a frame is
+		 * batched and composited over the surface on the GPU with one instanced draw call, in the order
+		 * they were drawn. They are not part of frame callbacks or captures, and are skipped with
+		 * `HeadlessBackend::CpuOnly`.
+		 * @param sprite A handle returned by `addSprite`.
+		 * @param x X-coordinate in surface pixels; fractional positions are allowed.
+		 * @param y Y-coordinate in surface pixels; fractional positions are allowed.
+		 * @throws std::out_of_range if the handle is unknown.
+		 */
+		void drawSprite(SpriteId sprite, float x, float y);
+
+		/**
+		 * @brief Draws a scaled, rotated or tinted sprite.
+		 *
+		 * @param sprite A handle returned by `addSprite`.
+		 * @param transform Position, scale, rotation and tint of the sprite.
+		 * @throws std::out_of_range if the handle is unknown.
+		 */
+		void drawSprite(SpriteId sprite, const SpriteTransform &transform);
+
+		/**
+		 * @brief Locks the whole drawing surface for direct writes.
+		 *
+		 * Bounds are checked once here; the returned view exposes each row of the pixel buffer so hot
+		 * loops can write packed pixels (`Color::pixel()`) with plain stores. The view is only valid until
+		 * `onUpdate` returns.
+		 * @return A row-pitched view over the surface.
+		 */
+		[[nodiscard]] SurfaceView lockRows();
+
+		/**
+		 * @brief Locks a region of the drawing surface for direct writes.
+		 *
+		 * @param region The region to lock; it is clipped to the surface.
+		 * @return A row-pitched view over the clipped region, with coordinates relative to it.
+		 */
+		[[nodiscard]] SurfaceView lockRows(const Rect &region);
+
+		/**
+		 * @brief Runs a function for every index in [0, count) on the engine's worker threads.
+		 *
+		 * The work is spread over a persistent, work-stealing thread pool (created on first use) and the
+		 * calling thread. Returns once every call has completed; exceptions are rethrown here. Engine draw
+		 * functions are not thread-safe, so parallel bodies should only write through views obtained
+		 * beforehand, e.g. with `lockRows`.
+		 * @param count Number of iterations.
+		 * @param body The function to run for each index.
+		 */
+		void parallelFor(int count, const std::function<void(int index)> &body);
+
+		/**
+		 * @brief Renders the drawing surface in parallel, one square tile at a time.
+		 *
+		 * The surface is split into tiles of `tileSize` pixels (smaller along the right and bottom edges)
+		 * and `kernel` is invoked once per tile from the thread pool with the tile's rectangle in surface
+		 * coordinates and a view over exactly that tile. Tiles never overlap, so kernels can write their
+		 * view without any locking.
+		 * @param kernel The function rendering one tile.
+		 * @param tileSize Edge length of the tiles in pixels.
+		 */
+		void renderTiles(const std::function<void(const Rect &tile, SurfaceView &view)> &kernel,
+						 int tileSize = defaultTileSize);
+
+		/**
+		 * @brief Loads an image file on a background thread; see `loadImage` for the supported formats.
+		 *
+		 * Loads run concurrently on the engine's asset threads (started on first use), so a frame can
+		 * request many assets and poll or wait for the futures later. Uncompressed native files are
+		 * memory-mapped rather than read.
+		 * @param path Path of the file.
+		 * @return A future receiving the image, or the exception raised while loading it.
+		 */
+		[[nodiscard]] std::future<Image> loadImageAsync(const std::string &path);
+
+		/**
+		 * @brief Gets the allocator for scratch surfaces that only live for the current frame.
+		 *
+		 * E.g. `BasicSurface<Argb8888Format> blurred(width, height, getFrameArena())` for a post-processing
+		 * step: allocating is a pointer bump, the memory is reused every frame, and nothing is freed. It is
+		 * reset before every `onUpdate`, so such surfaces must not be kept beyond it. Use it only from
+		 * `onUpdate` (and `onFixedUpdate`).
+		 */
+		[[nodiscard]] FrameArena &getFrameArena();
+
+		/**
+		 * @brief Gets the pool recycling the buffers of offscreen surfaces that are re-created over and over.
+		 *
+		 * The engine allocates its own surfaces from it too, so a resize by dynamic resolution reuses
+		 * buffers instead of going back to the heap. Use it from the thread calling `onUpdate`, and destroy
+		 * the surfaces allocated from it before the engine.
+		 */
+		[[nodiscard]] SurfacePool &getSurfacePool();
+
+		/**
+		 * @brief Switches the display to an 8-bit palette-indexed surface.
+		 *
+		 * Retro-style scenes with at most 256 colors draw palette indices into `lockIndexedSurface()`
+		 * instead of colors into the 32-bit surface. Each changed frame uploads one byte per pixel, which the
+		 * GPU looks up in a 256-entry palette, so clears and uploads move a quarter of the memory, and palette
+		 * cycling or fades only change the 1 KB palette (`setPalette`). Follows retained mode like the
+		 * 32-bit surface: cleared to index 0 before every `onUpdate` unless retained. While enabled, the
+		 * 32-bit drawing functions and the profiler overlay are not displayed (sprites are), the frame
+		 * callback still sees the 32-bit surface, and GPU captures record the palette output. Call on
+		 * the thread owning the window, e.g. from `onSetup`; not available with `ThreadingMode::RenderThread`.
+		 * @param enabled True to display the indexed surface.
+		 * @throws std::logic_error from `run()` if combined with `ThreadingMode::RenderThread`.
+		 */
+		void setIndexedMode(bool enabled);
+
+		/**
+		 * @brief Gets the indexed surface of the current frame for drawing palette indices.
+		 *
+		 * Marks the whole surface for upload at the end of the frame. Its `setPixel` ignores coordinates
+		 * outside the surface; `row(y)` gives direct access to the (64-byte aligned) bytes of a row. Valid
+		 * until `onUpdate` returns.
+		 * @throws std::logic_error outside indexed mode.
+		 */
+		[[nodiscard]] IndexedSurface &lockIndexedSurface();
+
+		/**
+		 * @brief Replaces palette entries of the indexed mode, effective from the next displayed frame.
+		 *
+		 * The palette starts as a grayscale ramp (index `i` is `Color(i, i, i)`); alpha is ignored.
+		 * @param colors The new colors.
+		 * @param first Index of the first replaced entry.
+		 * @throws std::out_of_range if the entries do not lie within [0, 256).
+		 */
+		void setPalette(std::span<const Color> colors, int first = 0);
+
+		/**
+		 * @brief Computes every displayed pixel on the GPU with a GLSL fragment shader instead of the CPU.
+		 *
+		 * For per-pixel workloads such as fractals or plasma effects this removes both the CPU work and the
+		 * texture upload: while a shader is set, the surface is neither uploaded nor shown, and the shader
+		 * writes the display texture directly (sprites are still drawn on top, and GPU captures record the
+		 * shader output; the frame callback still sees the CPU surface). The source is a complete
+		 * `#version 330 core` fragment shader writing `out vec4 FragColor`; `gl_FragCoord.xy` is the pixel
+		 * center in surface coordinates, with y pointing down, and `uniform vec2 surfaceSize` is set by the
+		 * engine. Shaders are compiled by the presenting thread before they are first displayed and cached
+		 * by source hash, so setting the same source every frame or switching between shaders is cheap; a
+		 * compile error is thrown from `run()`.
+		 * @param source The fragment shader source, or an empty string to display the surface again.
+		 * @throws std::logic_error for a `HeadlessBackend::CpuOnly` engine.
+		 */
+		void setPixelShader(const std::string &source);
+
+		/**
+		 * @brief Sets a `float` or `vecN` uniform of the pixel shader, e.g. an offset, scale or time from `onUpdate`.
+		 *
+		 * The values apply to the frame being drawn and persist until set again, also across shader changes.
+		 * @param name The uniform name; uniforms the active shader does not declare are ignored.
+		 * @param values One to four components, e.g. `{x, y}` for a `vec2`.
+		 * @throws std::invalid_argument for zero or more than four components.
+		 */
+		void setShaderUniform(const std::string &name, std::initializer_list<float> values);
+
+		/**
+		 * @brief Adds a layer above the surface and the layers added before, composited when displayed.
+		 *
+		 * Scenes of a static background, a slowly changing middle and a moving foreground draw each into its
+		 * own layer, selected with `setDrawLayer`, and stop redrawing what did not change: every layer keeps
+		 * its own dirty state, and only layers that changed are uploaded and blended again. Layer 0 is the
+		 * surface, which keeps following retained mode; added layers start transparent and take premultiplied
+		 * colors, like `BlendMode::Alpha` blits. Layers are not displayed in indexed mode or with a pixel
+		 * shader (sprites are drawn on top of them), the frame callback sees their composite, and a resize by
+		 * dynamic resolution clears them.
+		 * @param retained True to keep the layer across frames, false to clear it before every `onUpdate`.
+		 * @return The index of the new layer.
+		 * @throws std::logic_error from `run()` if combined with `ThreadingMode::RenderThread`.
+		 */
+		int addLayer(bool retained = true);
+
+		/**
+		 * @brief Selects the layer the drawing functions, `lockRows`, `submit` and `clear` target.
+		 *
+		 * Binned draws recorded for the previous layer are executed first.
+		 * @param layer 0 for the surface, or an index returned by `addLayer`.
+		 * @throws std::out_of_range if there is no such layer.
+		 */
+		void setDrawLayer(int layer);
+
+		/**
+		 * @brief Removes the added layers, drawing to the surface alone again.
+		 */
+		void removeLayers();
+
+		/**
+		 * @brief Selects whether layers are blended on the GPU, the default, or on the CPU.
+		 *
+		 * GPU compositing uploads each changed layer to its own texture; CPU compositing blends the changed
+		 * regions with the SIMD blend kernels and uploads one surface, which suits drivers with slow uploads
+		 * and is what `HeadlessBackend::CpuOnly` always uses.
+		 */
+		void setLayerCompositing(LayerCompositing compositing);
+
+		/**
+		 * @brief Clears the draw layer: the surface to opaque black, an added layer to transparent.
+		 *
+		 * The surface is cleared automatically at the start of every frame unless retained mode is enabled.
+		 */
+		void clear();
+
+		/**
+		 * @brief Defers the draw calls of each frame and rasterizes them in parallel, in screen tiles.
+		 *
+		 * While enabled, `drawPixel`, `drawLine`, `drawLines`, `drawSpan`, `fillRect`, `drawRect` and the circle
+		 * and triangle functions only record a command. Once `onUpdate` returns, the commands are binned to
+		 * 64x64 tiles and the tiles are rasterized on the thread pool, each replaying its commands in
+		 * submission order, so the frame is exactly what immediate drawing would have produced. `lockRows`,
+		 * `renderTiles`, `blit` and `drawText` execute the pending commands first, and `clear` discards them.
+		 * Pays off for fill-rate bound frames such as large triangle meshes; a handful of small draws is
+		 * faster drawn immediately.
+		 * @param enabled True to bin draws, false to draw immediately again; pending draws are executed first.
+		 */
+		void setBinnedRendering(bool enabled);
+
+		/**
+		 * @brief Draws a recorded command list into the frame.
+		 *
+		 * The list may have been built on any thread, but is submitted from `onUpdate` like any other draw
+		 * call. With binned rendering the commands join the frame's, in order; otherwise they are rasterized
+		 * right away, in parallel tiles. The list is only read, so the same one can be submitted every frame.
+		 * @param commands The commands to draw.
+		 */
+		void submit(const CommandList &commands);
+
+		/**
+		 * @brief Enables or disables retained mode.
+		 *
+		 * By default the surface is cleared before every `onUpdate`. In retained mode the previous frame is
+		 * kept instead, so mostly static scenes only redraw (and re-upload) what actually changed.
+		 * @param retained True to keep the surface contents between frames.
+		 */
+		void setRetainedMode(bool retained);
+
+		/**
+		 * @brief Selects how frames are paced against the display.
+		 *
+		 * Can be changed at any time; the new policy is applied by the presenting thread before its next frame.
+		 * @param pacing The pacing policy.
+		 * @param targetFps Frame rate cap used by `FramePacing::TargetFps`.
+		 */
+		void setFramePacing(FramePacing pacing, double targetFps = 60.0);
+
+		/**
+		 * @brief Trades some throughput for the shortest delay between input and the frame showing it.
+		 *
+		 * By default events are polled after the buffer swap, so `onUpdate` sees input that is a whole frame
+		 * (plus however long the swap blocked) old. In low-latency mode the single-threaded loop instead
+		 * polls right before `onUpdate`, and with `FramePacing::VSync` or `AdaptiveVSync` it first sleeps
+		 * until just before the next vertical blank minus the predicted cost of the frame, so the input is
+		 * read as late as possible. The vblank period is measured from the swaps; while it does not match the
+		 * refresh rate of the window's monitor, the sleep is skipped. Raw (unaccelerated) mouse motion is also
+		 * requested where the platform supports it; it applies while the mouse is captured.
+		 * `FramePhase::InputLatency` in the profiler reports the resulting input-to-swap time. With
+		 * `ThreadingMode::RenderThread` only the raw motion applies: the simulation thread already consumes
+		 * input at the start of every update.
+		 * @param enabled True to enable low-latency mode.
+		 */
+		void setLowLatencyMode(bool enabled);
+
+		/**
+		 * @brief Hides the cursor and locks it to the window, for mouse-look style controls.
+		 *
+		 * `getMousePosition` then reports unbounded virtual coordinates; use the difference between frames.
+		 * @param captured True to capture the mouse, false to release it.
+		 */
+		void setMouseCaptured(bool captured);
+
+		/**
+		 * @brief Gets the mouse cursor position in surface pixels, accounting for scaling and letterboxing.
+		 *
+		 * Positions over the letterbox bars fall outside `[0, getWidth()) x [0, getHeight())`.
+		 * @return The (x, y) surface coordinates under the cursor; (0, 0) when headless.
+		 */
+		[[nodiscard]] std::pair<double, double> getMouseSurfacePosition() const;
+
+		/**
+		 * @brief Selects how the surface is scaled to the (resizable) window on the GPU.
+		 *
+		 * Scaling happens in the fragment stage of the display pass, so its cost depends on the window size
+		 * only, never on the surface size. Applied by the presenting thread before its next frame.
+		 * @param filter The scaling filter; `ScalingFilter::IntegerNearest` by default.
+		 */
+		void setScalingFilter(ScalingFilter filter);
+
+		/**
+		 * @brief Shrinks the surface while frames take longer than a budget, and grows it back when they don't.
+		 *
+		 * The CPU time from clearing the surface to submitting the frame is compared with the budget, and the
+		 * surface is resized in steps between `minimumScale` and 1 times the size passed to the constructor;
+		 * the GPU stretches whatever size is current into the viewport of the full size, so the image keeps
+		 * its place and size on screen. `getWidth()` and `getHeight()` change
+		 * accordingly, and a resize clears the surface, also in retained mode. Only the single-threaded loop
+		 * resizes, and never while a capture runs. Disabling returns to the full size.
+		 * @param enabled True to enable dynamic resolution.
+		 * @param budgetMilliseconds CPU time per frame to stay within.
+		 * @param minimumScale Smallest fraction of the full width and height to render at.
+		 */
+		void setDynamicResolution(bool enabled, double budgetMilliseconds = 1000.0 / 60.0, double minimumScale = 0.5);
+
+		/**
+		 * @brief Enables fixed-timestep simulation through `onFixedUpdate`.
+		 *
+		 * Frame time is accumulated and consumed in whole steps, so simulation runs at exactly
+		 * `stepsPerSecond` regardless of the display rate. At most `maxStepsPerFrame` steps run per frame;
+		 * any backlog beyond that is dropped so a slow frame cannot trigger ever longer catch-up frames.
+		 * @param stepsPerSecond Simulation rate in Hz, e.g. 120; zero or negative disables fixed steps.
+		 * @param maxStepsPerFrame Upper bound of `onFixedUpdate` calls per frame.
+		 */
+		void setFixedTimestep(double stepsPerSecond, int maxStepsPerFrame = 8);
+
+		/**
+		 * @brief Gets how far the simulation has advanced into the next fixed step.
+		 *
+		 * @return A value in [0, 1) to interpolate between the previous and current simulation state in
+		 * `onUpdate`, or 0 when no fixed timestep is set.
+		 */
+		[[nodiscard]] float getInterpolationAlpha() const;
+
+		/**
+		 * @brief Selects the threading mode used by `run()`.
+		 *
+		 * Takes effect when the loop starts, so call it from the constructor or `onSetup()`. In
+		 * `ThreadingMode::RenderThread`, `onUpdate` and every drawing call happen on the simulation thread,
+		 * each frame starts from a cleared surface (retained mode is ignored), and the displayed frame is
+		 * always the most recently completed one. The simulation thread waits for each frame to be picked up
+		 * before starting the next, so it is paced like the display.
+		 * @param mode The threading mode.
+		 */
+		void setThreadingMode(ThreadingMode mode);
+
+		/**
+		 * @brief Selects how the drawing surface is uploaded to the GPU every frame.
+		 *
+		 * `UploadMode::PixelBufferRing` streams frames through persistently mapped buffers and silently
+		 * falls back to `UploadMode::Direct` when the OpenGL driver does not support them.
+		 * @param mode The requested upload mode.
+		 */
+		void setUploadMode(UploadMode mode);
+
+		/**
+		 * @brief Gets the upload mode that is actually in use.
+		 *
+		 * @return The active upload mode, which may differ from the requested one after a fallback.
+		 */
+		[[nodiscard]] UploadMode getUploadMode() const;
+
+		/**
+		 * @brief Enables or disables the built-in frame profiler.
+		 *
+		 * While enabled, every phase of the main loop is timed on the CPU and the texture upload and draw
+		 * are timed on the GPU (where timer queries are available). Disabled by default; when disabled the
+		 * instrumentation costs one relaxed atomic load per phase.
+		 * @param enabled True to start recording.
+		 */
+		void setProfilerEnabled(bool enabled);
+
+		/**
+		 * @brief Shows or hides the profiler overlay.
+		 *
+		 * The overlay is a stacked bar graph of the recent CPU frame phases, drawn into the bottom-left
+		 * corner of the surface after `onUpdate`, with a marker line at 16.7 ms and the latest frame time as
+		 * text. It is only drawn while the profiler is enabled.
+		 * @param visible True to draw the overlay.
+		 */
+		void setProfilerOverlay(bool visible);
+
+		/**
+		 * @brief Gets the rolling frame statistics collected by the profiler.
+		 *
+		 * @return Last, mean, p50, p95 and p99 of every phase in milliseconds, over the last
+		 * few seconds of frames.
+		 */
+		[[nodiscard]] FrameStats getFrameStats() const;
+
+		/**
+		 * @brief Starts recording every presented frame, replacing any capture in progress.
+		 *
+		 * Frames are read back asynchronously (from the display texture through mapped buffers and fences
+		 * where the driver supports it, from the CPU surface otherwise) and written by a dedicated thread,
+		 * so the render loop never waits for the disk. Frames arriving while `settings.queueDepth` frames
+		 * are still waiting to be written are dropped. Call from the thread owning the window: `onSetup`,
+		 * `onDestroy`, or `onUpdate` in single-threaded mode.
+		 * @param settings Output format and destination.
+		 * @throws std::runtime_error if the output cannot be opened.
+		 */
+		void startCapture(const CaptureSettings &settings);
+
+		/**
+		 * @brief Writes the frames still queued and closes the capture. Does nothing if none is running.
+		 *
+		 * Runs automatically when the engine is destroyed. Same threading rules as `startCapture`.
+		 * @throws std::runtime_error if writing any frame failed.
+		 */
+		void stopCapture();
+
+		/**
+		 * @brief Gets the frames written and dropped by the current capture, or by the last one.
+		 */
+		[[nodiscard]] CaptureStats getCaptureStats() const;
+
 		/**
 		 * @brief Gets the width of the window.
 		 *
@@ -167,6 +804,7 @@ namespace pxe {
 		/**
 		 * @brief Gets the width of the target rendering surface in pixel size units.
 		 *
+		 * Constant unless dynamic resolution is enabled.
 		 * @return The width of the target rendering surface in pixel size units.
 		 */
 		[[nodiscard]] int getWidth() const;
@@ -183,7 +821,8 @@ namespace pxe {
 		 *
 		 * The pixel size determines how many screen pixels represent a single logical pixel.
 		 * A value of 1 means a 1:1 ratio (default behavior), while a value of 2 means each
-		 * logical pixel is rendered as a 2×2 block on screen.
+		 * logical pixel is rendered as a 2×2 block on screen. This is the initial window size only:
+		 * the window is resizable, and the scaling filter then decides how the surface fills it.
 		 *
 		 * @return The pixel size scaling factor.
 		 */
@@ -191,8 +830,114 @@ namespace pxe {
 
 	private:
 		int pixelSize = 0;
-		std::unique_ptr<class Window> window; ///< Smart pointer for managing window lifecycle.
+		ThreadingMode threadingMode = ThreadingMode::SingleThreaded;
+		std::atomic<FramePacing> framePacing{FramePacing::VSync};
+		std::atomic<double> targetFps{60.0};
+		std::atomic<bool> framePacingChanged{true}; ///< Set when the presenting thread must reapply the pacing.
+		std::unique_ptr<class FrameLimiter> frameLimiter;
+		std::unique_ptr<class VblankPredictor> vblankPredictor; ///< Schedules the low-latency input wait.
+		std::chrono::steady_clock::time_point refreshRateQueried; ///< When the monitor's rate was last read.
+		std::atomic<bool> lowLatency{false};
+		std::atomic<bool> mouseCaptured{false};
+		std::atomic<bool> inputModeChanged{false}; ///< Set when the presenting thread must reapply the input mode.
+		std::atomic<ScalingFilter> scalingFilter{ScalingFilter::IntegerNearest};
+		int fullWidth = 0; ///< Surface size passed to the constructor.
+		int fullHeight = 0;
+		bool dynamicResolution = false;
+		std::unique_ptr<class ResolutionScaler> resolutionScaler;
+		double fixedStep = 0.0; ///< Fixed timestep in seconds, 0 when disabled.
+		int maxFixedSteps = 8;
+		double fixedAccumulator = 0.0;
+		float interpolationAlpha = 0.0f;
+		int frameLimit = -1; ///< Frames left to `run`, negative for no limit.
+		std::function<void(int, const SurfaceView &)> frameCallback;
+		std::unique_ptr<class OffscreenContext> offscreenContext; ///< EGL context of the offscreen backend.
+		std::unique_ptr<class Window> window; ///< Smart pointer for managing window lifecycle, null when headless.
 		std::unique_ptr<class Graphics> graphics; ///< Smart pointer for managing graphics lifecycle.
+		std::unique_ptr<class FrameCapture> capture; ///< Running capture; destroyed before the graphics context.
+		CaptureStats lastCaptureStats;
 		std::unique_ptr<class Input> input; ///< Smart pointer for managing graphics lifecycle.
+		std::unique_ptr<class ThreadPool> threadPool; ///< Worker threads, created on first parallel call.
+		bool binnedRendering = false;
+		CommandList frameCommands; ///< Binned draws of the current frame, culled to the surface size.
+		std::unique_ptr<class BinnedRasterizer> binnedRasterizer; ///< Created by the first command list executed.
+		std::unique_ptr<class AssetLoader> assetLoader; ///< Background loading threads, created on first use.
+		std::unique_ptr<class TextCache> textCache; ///< Layouts of the strings drawn, created on first use.
+		std::unique_ptr<class FrameProfiler> profiler;
+		std::atomic<bool> profilerOverlay{false};
+
+		[[nodiscard]] ThreadPool &getThreadPool();
+
+		/**
+		 * @brief Creates the members shared by the windowed and headless engines.
+		 */
+		void initRuntime();
+
+		/**
+		 * @brief Checks whether the main loop should start frame `frameIndex`.
+		 */
+		[[nodiscard]] bool keepRunning(int frameIndex) const;
+
+		/**
+		 * @brief Hands the frame just drawn to the frame callback, if any.
+		 */
+		void deliverFrame(int frameIndex);
+
+		/**
+		 * @brief Swaps the window buffers, if there is a window, timing the swap.
+		 */
+		void swapBuffers();
+
+		/**
+		 * @brief Processes window events, if there is a window, timing them. Presenting thread only.
+		 *
+		 * Applies a pending input mode change first.
+		 */
+		void pollEvents();
+
+		/**
+		 * @brief Records the input-to-swap latency of the frame just swapped. Single-threaded loop only.
+		 */
+		void recordInputLatency();
+
+		/**
+		 * @brief Hands the window's framebuffer size and the scaling filter to Graphics. Presenting thread only.
+		 */
+		void updateDisplay();
+
+		/**
+		 * @brief Feeds a frame's cost to dynamic resolution and resizes the surface if needed. Single-threaded
+		 * loop only, between frames.
+		 * @param frameCost CPU time of the frame just submitted.
+		 */
+		void updateRenderScale(std::chrono::steady_clock::duration frameCost);
+
+		void runSingleThreaded();
+		void runWithRenderThread();
+
+		/**
+		 * @brief Runs the due fixed steps, if any, followed by `onUpdate`, then executes the binned draws.
+		 */
+		void simulate(float deltaTime);
+
+		/**
+		 * @brief Rasterizes the draws recorded in binned rendering, if any, into the surface.
+		 */
+		void executeBinnedDraws();
+
+		/**
+		 * @brief Rasterizes a command list into the surface, in parallel tiles.
+		 */
+		void execute(const CommandList &commands);
+
+		/**
+		 * @brief Applies a pending pacing change and waits for the frame deadline. Presenting thread only.
+		 */
+		void paceFrame();
+
+		/**
+		 * @brief Draws the profiler overlay into the drawing surface.
+		 */
+		void drawProfilerOverlay();
 	};
 } // namespace pxe
@@ -0,0 +1,167 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief Renders the Mandelbrot set progressively, redoing as little work as possible between frames.
+	 *
+	 * A new view (scale, iteration limit or size) is first computed one sample per 8x8 block, then refined
+	 * to 4x4, 2x2 and full resolution; `update` runs as many of these passes as fit in its time budget, so
+	 * a view that is being zoomed stays interactive and sharpens once the zoom stops. Panning by whole
+	 * pixels keeps the finished image, shifts it, and only computes the newly exposed strips. An unchanged,
+	 * finished view costs nothing.
+	 *
+	 * Shallow views use the SIMD kernels of the running CPU with smooth coloring. Below
+	 * `perturbationScale`, where doubles run out of precision, the center is kept in arbitrary precision
+	 * and the pixels are iterated by perturbation around a reference orbit at the center, which supports
+	 * zooms down to `minScale`.
+	 */
+	class FractalRenderer {
+	public:
+		/// Runs `body(index)` for every index in [0, count), possibly in parallel; e.g. `Engine::parallelFor`.
+		using ParallelFor = std::function<void(int count, const std::function<void(int index)> &body)>;
+
+		/// Scale (complex-plane units per pixel) below which views are rendered by perturbation.
+		static constexpr double perturbationScale = 1e-13;
+		/// Smallest supported scale; pixel offsets below it would leave the normal range of a double.
+		static constexpr double minScale = 1e-290;
+		/// Largest supported scale.
+		static constexpr double maxScale = 1.0;
+		/// Edge length in pixels of the blocks computed by the first refinement pass.
+		static constexpr int coarsestBlock = 8;
+
+		/**
+		 * @brief Creates a renderer showing the whole set.
+		 * @param width Width of the image in pixels.
+		 * @param height Height of the image in pixels.
+		 * @throws std::invalid_argument if a dimension is not positive.
+		 */
+		FractalRenderer(int width, int height);
+		~FractalRenderer();
+
+		FractalRenderer(const FractalRenderer &) = delete;
+		FractalRenderer &operator=(const FractalRenderer &) = delete;
+
+		/**
+		 * @brief Changes the image size, restarting the refinement.
+		 * @throws std::invalid_argument if a dimension is not positive.
+		 */
+		void resize(int width, int height);
+
+		/**
+		 * @brief Centers the view on a point.
+		 */
+		void setCenter(double real, double imag);
+
+		/**
+		 * @brief Centers the view on a point given as decimal strings, as precise as deep zooms need.
+		 * @throws std::invalid_argument if a coordinate is not a plain decimal number.
+		 */
+		void setCenter(std::string_view real, std::string_view imag);
+
+		/**
+		 * @brief Moves the view by a distance in pixels.
+		 *
+		 * The view moves in whole pixels, so the finished image can be reused; fractions are accumulated
+		 * over calls.
+		 * @param dx Pixels to move towards increasing real values.
+		 * @param dy Pixels to move towards increasing imaginary values (down the image).
+		 */
+		void pan(double dx, double dy);
+
+		/**
+		 * @brief Sets the zoom, clamped to [`minScale`, `maxScale`].
+		 * @param scale Complex-plane units per pixel.
+		 */
+		void setScale(double scale);
+
+		[[nodiscard]] double getScale() const { return scale; }
+
+		/**
+		 * @brief Sets the iteration limit; deep zooms need more iterations to resolve detail.
+		 * @throws std::invalid_argument if the limit is not positive.
+		 */
+		void setMaxIterations(int maxIterations);
+
+		[[nodiscard]] int getMaxIterations() const { return maxIterations; }
+
+		/**
+		 * @brief Sets how long `update` keeps refining. The first pass of a view always runs.
+		 */
+		void setTimeBudget(double milliseconds);
+
+		/**
+		 * @brief Runs refinement passes until the image is finished or the time budget is used.
+		 * @param parallelFor Distributes the rows of a pass; null runs them on the calling thread.
+		 * @return True if the image changed since the previous call.
+		 */
+		bool update(const ParallelFor &parallelFor = nullptr);
+
+		/**
+		 * @brief Checks whether the image is computed at full resolution.
+		 */
+		[[nodiscard]] bool isComplete() const { return block == 0; }
+
+		/**
+		 * @brief Checks whether the current scale is rendered by perturbation.
+		 */
+		[[nodiscard]] bool isPerturbed() const { return scale < perturbationScale; }
+
+		/**
+		 * @brief Copies the image into a view, e.g. one obtained from `Engine::lockRows()`.
+		 *
+		 * Copies the overlapping area when the sizes differ.
+		 */
+		void copyTo(const SurfaceView &view) const;
+
+		[[nodiscard]] int getWidth() const { return width; }
+		[[nodiscard]] int getHeight() const { return height; }
+
+	private:
+		int width;
+		int height;
+		double scale;
+		int maxIterations = 256;
+		double budgetMilliseconds = 8.0;
+		double panX = 0.0; ///< Fraction of a pixel panned but not applied yet.
+		double panY = 0.0;
+		int block = coarsestBlock; ///< Block size of the next refinement pass; 0 once the image is finished.
+		bool changed = false;
+		bool orbitReady = false;
+		std::vector<float> values; ///< Smooth escape value per pixel; NaN where not computed yet.
+		std::vector<uint32_t> pixels; ///< The colored image.
+		std::vector<float> scratchValues; ///< Reused by `shift`.
+		std::vector<uint32_t> scratchPixels;
+		std::vector<uint32_t> palette;
+		std::unique_ptr<class ReferenceOrbit> reference; ///< Holds the center, also when not perturbing.
+
+		void restart();
+		void shift(int dx, int dy);
+		void runPass(int blockSize, const ParallelFor &parallelFor);
+		void renderRow(int y, int blockSize, std::vector<float> &samples);
+		[[nodiscard]] uint32_t colorOf(float value) const;
+	};
+} // namespace pxe
@@ -0,0 +1,76 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace pxe {
+	/**
+	 * @brief The phases of a frame measured by the built-in profiler.
+	 */
+	enum class FramePhase : int {
+		BeginFrame, ///< Surface clear at the start of the frame (CPU).
+		Update, ///< `onUpdate`, including any fixed steps (CPU).
+		EndFrame, ///< Texture upload and draw submission (CPU).
+		SwapBuffers, ///< Buffer swap, usually waiting for VSync (CPU).
+		PollEvents, ///< Window and input event processing (CPU).
+		GpuUpload, ///< Texture upload as executed by the GPU.
+		GpuDraw, ///< Display quad draw as executed by the GPU.
+		InputLatency, ///< From the oldest input event a frame consumed until its swap returned (single-threaded).
+		Frame, ///< A whole iteration of the main loop (CPU).
+	};
+
+	/// Number of values in `FramePhase`.
+	inline constexpr size_t framePhaseCount = static_cast<size_t>(FramePhase::Frame) + 1;
+
+	/**
+	 * @brief Gets a short display name for a frame phase.
+	 */
+	[[nodiscard]] constexpr const char *framePhaseName(const FramePhase phase) {
+		constexpr const char *names[framePhaseCount] = {"begin", "update", "end", "swap", "poll",
+														 "gpu upload", "gpu draw", "input", "frame"};
+		return names[static_cast<size_t>(phase)];
+	}
+
+	/**
+	 * @brief Rolling statistics of one frame phase, in milliseconds.
+	 */
+	struct PhaseTiming {
+		double last = 0.0; ///< Most recent sample.
+		double mean = 0.0;
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		size_t samples = 0; ///< Number of samples in the window the statistics were computed over.
+	};
+
+	/**
+	 * @brief A snapshot of the profiler's rolling statistics for every frame phase.
+	 */
+	struct FrameStats {
+		std::array<PhaseTiming, framePhaseCount> phases{};
+
+		/**
+		 * @brief Gets the statistics of one phase.
+		 */
+		[[nodiscard]] const PhaseTiming &operator[](const FramePhase phase) const {
+			return phases[static_cast<size_t>(phase)];
+		}
+	};
+} // namespace pxe
@@ -0,0 +1,62 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace pxe {
+	/**
+	 * @brief An axis-aligned rectangle in surface pixel coordinates.
+	 *
+	 * The rectangle covers the half-open ranges [x, x + width) and [y, y + height).
+	 */
+	struct Rect {
+		int x = 0;
+		int y = 0;
+		int width = 0;
+		int height = 0;
+
+		/**
+		 * @brief Checks whether the rectangle covers no pixels.
+		 */
+		[[nodiscard]] constexpr bool isEmpty() const { return width <= 0 || height <= 0; }
+
+		/**
+		 * @brief Gets the exclusive right edge of the rectangle.
+		 */
+		[[nodiscard]] constexpr int right() const { return x + width; }
+
+		/**
+		 * @brief Gets the exclusive bottom edge of the rectangle.
+		 */
+		[[nodiscard]] constexpr int bottom() const { return y + height; }
+
+		constexpr bool operator==(const Rect &) const = default;
+	};
+
+	/**
+	 * @brief A line segment between two pixel centers; both endpoints are drawn.
+	 */
+	struct Line {
+		int x0 = 0;
+		int y0 = 0;
+		int x1 = 0;
+		int y1 = 0;
+
+		constexpr bool operator==(const Line &) const = default;
+	};
+} // namespace pxe
@@ -0,0 +1,198 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include "color.h"
+#include "geometry.h"
+#include "surfaceAllocator.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief How `blit` combines source pixels with the destination.
+	 */
+	enum class BlendMode {
+		Copy, ///< Source pixels replace the destination, one block copy per row.
+		ColorKey, ///< Like `Copy`, but source pixels equal to the image's color key are skipped.
+		Alpha, ///< Premultiplied alpha: dst = src + dst * (1 - srcAlpha).
+	};
+
+	/**
+	 * @brief An image or sprite: a pixel buffer in the native `PixelFormat` that can be blitted onto the
+	 * drawing surface or onto another image.
+	 *
+	 * Images use the same row-pitched layout as surfaces: their own pixels come from the default
+	 * `SurfaceAllocator`, with every row starting on a `pixelAlignment` boundary, so `getView()` accepts every
+	 * direct-access technique that works on `lockRows()` and blits read aligned rows. The default allocator
+	 * keeps no state, so images can still be created, copied and destroyed on any thread. `BlendMode::Alpha`
+	 * expects premultiplied colors; images made from straight-alpha colors should be converted once with
+	 * `premultiplyAlpha()`.
+	 *
+	 * An image can also wrap pixels it does not own, such as a memory-mapped asset file; their rows are
+	 * packed, with a pitch equal to the width. Such images are read-only until the first write (`setPixel`,
+	 * `getView`, `premultiplyAlpha`, `blit` into it), which copies the pixels into aligned storage of their
+	 * own. Copies of a wrapping image share the wrapped pixels.
+	 */
+	class Image {
+	public:
+		Image() = default;
+
+		/**
+		 * @brief Creates an image filled with one color.
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 * @param fill Initial color of every pixel.
+		 * @throws std::invalid_argument if a dimension is negative.
+		 */
+		Image(int width, int height, Color fill = Color::Transparent);
+
+		/**
+		 * @brief Creates an image from rows of colors.
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 * @param pixels `width * height` colors, row by row.
+		 * @throws std::invalid_argument if a dimension is negative or the pixel count does not match.
+		 */
+		Image(int width, int height, std::span<const Color> pixels);
+
+		/**
+		 * @brief Wraps pixels owned by someone else, without copying them.
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 * @param pixels `width * height` pixels in the native `PixelFormat`, row by row.
+		 * @param owner Keeps `pixels` alive for as long as any image refers to them.
+		 * @throws std::invalid_argument if a dimension is negative or `pixels` is null.
+		 */
+		Image(int width, int height, const uint32_t *pixels, std::shared_ptr<const void> owner);
+
+		Image(const Image &other);
+		Image(Image &&other) noexcept;
+		Image &operator=(const Image &other);
+		Image &operator=(Image &&other) noexcept;
+		~Image() = default;
+
+		/**
+		 * @brief Sets a pixel; out-of-bounds coordinates are ignored.
+		 */
+		void setPixel(int x, int y, Color color);
+
+		/**
+		 * @brief Gets a pixel, or Color::Transparent if the coordinates are out of bounds.
+		 */
+		[[nodiscard]] Color getPixel(int x, int y) const;
+
+		/**
+		 * @brief Gives direct write access to the pixels.
+		 * @return A row-pitched view over the whole image, valid until the image is resized or destroyed.
+		 */
+		[[nodiscard]] SurfaceView getView();
+
+		/**
+		 * @brief Gets the pixels, row by row: rows start `getPitch()` pixels apart, and the span ends with the
+		 * last pixel of the last row.
+		 */
+		[[nodiscard]] std::span<const uint32_t> getPixels() const {
+			return {data, height > 0 ? static_cast<size_t>(height - 1) * pitch + width : 0};
+		}
+
+		/**
+		 * @brief Checks whether the image wraps pixels it does not own, i.e. has not been written to.
+		 */
+		[[nodiscard]] bool isShared() const { return owner != nullptr; }
+
+		/**
+		 * @brief Converts straight-alpha colors to premultiplied alpha, in place.
+		 *
+		 * Fully opaque pixels are left unchanged, so opaque images can be blended without converting.
+		 */
+		void premultiplyAlpha();
+
+		/**
+		 * @brief Sets the color skipped by `BlendMode::ColorKey`; all four channels must match.
+		 * @param key The transparent color, Color::Magenta by default.
+		 */
+		void setColorKey(Color key) { colorKey = key; }
+
+		/**
+		 * @brief Gets the color skipped by `BlendMode::ColorKey`.
+		 */
+		[[nodiscard]] Color getColorKey() const { return colorKey; }
+
+		/**
+		 * @brief Draws a region of another image onto this one.
+		 *
+		 * Both rectangles are clipped once, before any pixel is touched.
+		 * @param source The image to read from; must not be this image.
+		 * @param sourceRegion The region of `source` to draw.
+		 * @param x X-coordinate in this image of the region's top-left corner.
+		 * @param y Y-coordinate in this image of the region's top-left corner.
+		 * @param mode How source pixels are combined with this image.
+		 */
+		void blit(const Image &source, const Rect &sourceRegion, int x, int y, BlendMode mode);
+
+		/**
+		 * @brief Gets the width of the image in pixels.
+		 */
+		[[nodiscard]] int getWidth() const { return width; }
+
+		/**
+		 * @brief Gets the height of the image in pixels.
+		 */
+		[[nodiscard]] int getHeight() const { return height; }
+
+		/**
+		 * @brief Gets the distance in pixels between the starts of two consecutive rows.
+		 */
+		[[nodiscard]] int getPitch() const { return pitch; }
+
+		/**
+		 * @brief Gets the bounds of the image.
+		 * @return The rectangle (0, 0, width, height).
+		 */
+		[[nodiscard]] Rect getBounds() const { return {0, 0, width, height}; }
+
+	private:
+		int width = 0;
+		int height = 0;
+		int pitch = 0; ///< Row pitch in pixels: aligned in `storage`, the width in wrapped memory.
+		PixelStorage storage; ///< Own pixels; empty while the image wraps someone else's.
+		const uint32_t *data = nullptr; ///< First pixel, in `storage` or in the wrapped memory.
+		std::shared_ptr<const void> owner; ///< Keeps wrapped pixels alive; null when they are in `storage`.
+		Color colorKey = Color::Magenta;
+
+		/**
+		 * @brief Allocates aligned storage for the current size; the pixels are left uninitialized.
+		 */
+		void allocateStorage();
+
+		/**
+		 * @brief Gets a row of own storage.
+		 */
+		[[nodiscard]] uint32_t *row(const int y) {
+			return storage.as<uint32_t>() + static_cast<ptrdiff_t>(y) * pitch;
+		}
+
+		/**
+		 * @brief Copies wrapped pixels into own storage before a write.
+		 */
+		void makeWritable();
+	};
+} // namespace pxe
@@ -0,0 +1,78 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief Compression of the pixel payload in the engine-native image format.
+	 */
+	enum class ImageCompression {
+		None, ///< Raw rows; loaded by memory-mapping the file, without copying or decoding.
+		Lz4, ///< One LZ4 block; smaller files that still decode at memory bandwidth.
+	};
+
+	/**
+	 * @brief Loads an image file, detecting its format from its signature.
+	 *
+	 * Accepts the engine-native format written by `saveImage` (and the `px-engine-convert` tool), PNG
+	 * and QOI. An uncompressed native file whose layout matches `PixelFormat` is memory-mapped and
+	 * wrapped by the returned image without any copy: pixels are paged in on first use and the image
+	 * stays valid after the call (see `Image::isShared`). Everything else is decoded into a new image.
+	 *
+	 * The native format is a 32-byte little-endian header followed by the payload:
+	 * | Offset | Size | Field |
+	 * |-------:|-----:|-------|
+	 * | 0 | 4 | Magic "PXEI" |
+	 * | 4 | 2 | Version, 1 |
+	 * | 6 | 1 | Layout: 0 for 0xAARRGGBB, 1 for 0xAABBGGRR pixels |
+	 * | 7 | 1 | Compression: 0 for none, 1 for LZ4 |
+	 * | 8 | 4 | Width |
+	 * | 12 | 4 | Height |
+	 * | 16 | 8 | Payload size in bytes |
+	 * | 24 | 8 | Reserved, 0 |
+	 *
+	 * The decompressed payload holds `height` rows of `width` little-endian 32-bit pixels.
+	 * @param path Path of the file.
+	 * @return The image. PNG and QOI images have straight alpha; native files keep whatever they were saved with.
+	 * @throws std::runtime_error if the file cannot be read or is not a valid image.
+	 */
+	[[nodiscard]] Image loadImage(const std::string &path);
+
+	/**
+	 * @brief Decodes an image file held in memory; see `loadImage` for the formats.
+	 *
+	 * The pixels are always copied, so `file` may be released afterwards.
+	 * @param file The complete file.
+	 * @throws std::runtime_error if the data is not a valid image.
+	 */
+	[[nodiscard]] Image decodeImage(std::span<const uint8_t> file);
+
+	/**
+	 * @brief Writes an image in the engine-native format, in the current `PixelFormat` layout.
+	 * @param path Path of the file to create or replace.
+	 * @param image The image to write.
+	 * @param compression Payload compression.
+	 * @throws std::runtime_error if the file cannot be written.
+	 */
+	void saveImage(const std::string &path, const Image &image, ImageCompression compression = ImageCompression::None);
+} // namespace pxe
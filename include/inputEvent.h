@@ -0,0 +1,48 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include "keyCodes.h"
+
+namespace pxe {
+	/**
+	 * @brief Kinds of events recorded by the input queue.
+	 */
+	enum class InputEventType : uint8_t {
+		KeyPress,
+		KeyRelease,
+		KeyRepeat, ///< Auto-repeat of a held key; does not change the pressed state.
+		MousePress,
+		MouseRelease,
+		CursorMove,
+	};
+
+	/**
+	 * @brief One keyboard or mouse event, in the order the window system delivered it.
+	 */
+	struct InputEvent {
+		InputEventType type = InputEventType::CursorMove;
+		KeyCode key = KeyCode::Unknown; ///< Key of a key event, otherwise `KeyCode::Unknown`.
+		MouseButton button = MouseButton::Left; ///< Button of a mouse button event.
+		double x = 0.0; ///< Cursor position in window coordinates when the event happened.
+		double y = 0.0;
+		std::chrono::steady_clock::time_point time{}; ///< When the engine received the event from the window system.
+	};
+} // namespace pxe
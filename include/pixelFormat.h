@@ -0,0 +1,71 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace pxe {
+	/**
+	 * @brief Describes the in-memory layout of a 32-bit pixel, shared by `Color`, `Surface` and the renderer.
+	 *
+	 * The layout is fixed at compile time so that colors are packed once, straight into the form the GPU
+	 * consumes. By default pixels are 0xAARRGGBB native integers, which desktop OpenGL uploads as
+	 * `GL_BGRA` + `GL_UNSIGNED_INT_8_8_8_8_REV` without any driver-side swizzling. Defining
+	 * `PXE_PIXEL_FORMAT_RGBA` switches to 0xAABBGGRR, the layout OpenGL ES expects for `GL_RGBA` uploads.
+	 */
+	struct PixelFormat {
+#ifdef PXE_PIXEL_FORMAT_RGBA
+		static constexpr int redShift = 0;
+		static constexpr int blueShift = 16;
+#else
+		static constexpr int redShift = 16;
+		static constexpr int blueShift = 0;
+#endif
+		static constexpr int greenShift = 8;
+		static constexpr int alphaShift = 24;
+
+		/**
+		 * @brief Packs the given channels into a pixel.
+		 */
+		[[nodiscard]] static constexpr uint32_t pack(const uint8_t red, const uint8_t green, const uint8_t blue,
+													 const uint8_t alpha = 255) {
+			return (static_cast<uint32_t>(alpha) << alphaShift) | (static_cast<uint32_t>(red) << redShift) |
+				   (static_cast<uint32_t>(green) << greenShift) | (static_cast<uint32_t>(blue) << blueShift);
+		}
+
+		/**
+		 * @brief Extracts the red channel of a pixel.
+		 */
+		[[nodiscard]] static constexpr uint8_t red(const uint32_t pixel) { return (pixel >> redShift) & 0xFF; }
+
+		/**
+		 * @brief Extracts the green channel of a pixel.
+		 */
+		[[nodiscard]] static constexpr uint8_t green(const uint32_t pixel) { return (pixel >> greenShift) & 0xFF; }
+
+		/**
+		 * @brief Extracts the blue channel of a pixel.
+		 */
+		[[nodiscard]] static constexpr uint8_t blue(const uint32_t pixel) { return (pixel >> blueShift) & 0xFF; }
+
+		/**
+		 * @brief Extracts the alpha channel of a pixel.
+		 */
+		[[nodiscard]] static constexpr uint8_t alpha(const uint32_t pixel) { return (pixel >> alphaShift) & 0xFF; }
+	};
+} // namespace pxe
@@ -0,0 +1,101 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace pxe {
+	/**
+	 * @brief Selects how the CPU surface is transferred to the display texture every frame.
+	 */
+	enum class UploadMode {
+		/// Calls glTexSubImage2D straight from client memory. Always available.
+		Direct,
+		/// Streams through a ring of persistently mapped pixel buffer objects guarded by fences, so the CPU can
+		/// write frame N+1 while the GPU still consumes frame N. Requires GL_ARB_buffer_storage and falls back
+		/// to `Direct` when the extension is missing.
+		PixelBufferRing,
+	};
+
+	/**
+	 * @brief Selects which threads run the simulation and the presentation of frames.
+	 */
+	enum class ThreadingMode {
+		/// `onUpdate`, the upload and the buffer swap all run in sequence on the main thread.
+		SingleThreaded,
+		/// `onUpdate` runs on a dedicated simulation thread drawing into one of three surfaces, while the main
+		/// thread owns the GL context and presents the latest completed surface. A slow swap (e.g. waiting
+		/// for VSync) no longer delays the next `onUpdate`, which starts as soon as the previous frame is
+		/// picked up for display, so the simulation runs at most one frame ahead of it.
+		RenderThread,
+	};
+
+	/**
+	 * @brief Selects how the presentation loop is paced against the display.
+	 */
+	enum class FramePacing {
+		/// Waits for vertical blank on every swap (swap interval 1). The default.
+		VSync,
+		/// Waits for vertical blank, but swaps immediately when a frame misses it instead of waiting a
+		/// whole extra refresh (swap interval -1). Falls back to `VSync` when the driver lacks
+		/// `WGL_EXT_swap_control_tear` / `GLX_EXT_swap_control_tear`.
+		AdaptiveVSync,
+		/// Never waits (swap interval 0), to measure raw throughput without the compositor's cap.
+		Uncapped,
+		/// Disables VSync and caps the frame rate with a sleep/spin limiter at the requested target.
+		TargetFps,
+	};
+
+	/**
+	 * @brief Selects how the surface is scaled to the window on the GPU.
+	 */
+	enum class ScalingFilter {
+		/// The largest whole multiple of the surface size that fits, centered, with nearest sampling: every
+		/// surface pixel covers the same block of screen pixels. The default.
+		IntegerNearest,
+		/// Fills the window at any ratio, keeping the aspect: each pixel is magnified with nearest sampling
+		/// and only the one-screen-pixel seams between pixels are blended, so edges stay sharp without the
+		/// uneven pixel widths of plain nearest scaling.
+		SharpBilinear,
+		/// Like `SharpBilinear`, plus scanlines and an aperture-grille mask in the fragment stage. The
+		/// scanlines fade out below 2x vertical scale, where they would only darken the image.
+		Crt,
+	};
+
+	/**
+	 * @brief Selects where the layer stack is blended into the displayed frame.
+	 */
+	enum class LayerCompositing {
+		/// Every layer has its own texture, uploaded only where the layer changed, and the textures are blended
+		/// into the display texture on the GPU; an unchanged stack skips both. The default.
+		Gpu,
+		/// The layers are blended with the SIMD blend kernels into a CPU surface, only where one of them
+		/// changed, and that single surface is uploaded. Always used without OpenGL.
+		Cpu,
+	};
+
+	/**
+	 * @brief Selects what a headless engine renders with when there is no window.
+	 */
+	enum class HeadlessBackend {
+		/// Runs the full upload and draw path into an offscreen framebuffer of a surfaceless EGL context.
+		/// Requires a build with `PXE_HEADLESS_EGL` and a driver exposing `EGL_KHR_surfaceless_context`.
+		Offscreen,
+		/// Never touches the GPU: frames only go through the CPU surface, which is all the frame callback sees.
+		CpuOnly,
+	};
+} // namespace pxe
@@ -0,0 +1,45 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "color.h"
+
+namespace pxe {
+	/**
+	 * @brief Handle of an image stored in the engine's sprite atlas, returned by `addSprite`.
+	 */
+	struct SpriteId {
+		int index = -1; ///< Position in the atlas' sprite table; -1 for no sprite.
+
+		[[nodiscard]] constexpr bool isValid() const { return index >= 0; }
+
+		constexpr bool operator==(const SpriteId &) const = default;
+	};
+
+	/**
+	 * @brief Placement of one sprite draw, in surface pixel coordinates.
+	 */
+	struct SpriteTransform {
+		float x = 0.0f; ///< X-coordinate of the sprite's top-left corner before rotation.
+		float y = 0.0f; ///< Y-coordinate of the sprite's top-left corner before rotation.
+		float scaleX = 1.0f; ///< Horizontal scale; the drawn width is the image width times this.
+		float scaleY = 1.0f; ///< Vertical scale; the drawn height is the image height times this.
+		float rotation = 0.0f; ///< Rotation in radians about the sprite's center, from the x axis towards the y axis.
+		Color tint = Color::White; ///< Premultiplied color multiplied with every texel; white draws the image as is.
+	};
+} // namespace pxe
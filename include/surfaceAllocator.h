@@ -0,0 +1,255 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pxe {
+	/// Alignment in bytes of every pixel allocation (one cache line, a whole AVX-512 register) and of surface rows.
+	inline constexpr size_t pixelAlignment = 64;
+
+	/**
+	 * @brief Where surfaces get their pixel memory from.
+	 *
+	 * Every allocation is aligned to `pixelAlignment`. Allocators are not thread-safe: a surface must be
+	 * created and destroyed on the thread using its allocator, and the allocator must outlive it.
+	 */
+	class SurfaceAllocator {
+	public:
+		virtual ~SurfaceAllocator() = default;
+
+		/**
+		 * @brief Allocates at least `bytes` bytes aligned to `pixelAlignment`.
+		 * @throws std::bad_alloc if the memory is not available.
+		 */
+		[[nodiscard]] virtual void *allocate(size_t bytes) = 0;
+
+		/**
+		 * @brief Returns an allocation of this allocator.
+		 * @param memory The pointer `allocate` returned.
+		 * @param bytes The size that was passed to `allocate`.
+		 */
+		virtual void deallocate(void *memory, size_t bytes) = 0;
+
+		/**
+		 * @brief Gets the process-wide `HeapSurfaceAllocator` that surfaces use by default.
+		 */
+		[[nodiscard]] static SurfaceAllocator &getDefault();
+	};
+
+	/**
+	 * @brief Allocates straight from the operating system's heap.
+	 *
+	 * On Linux, allocations of at least `hugePageThreshold` bytes are mapped on 2 MB boundaries and
+	 * advised as transparent huge pages (`madvise(MADV_HUGEPAGE)`), so scanning a 4K framebuffer touches
+	 * a handful of TLB entries instead of thousands. Elsewhere it always uses aligned `operator new`:
+	 * large pages on Windows need a privilege regular processes do not hold.
+	 */
+	class HeapSurfaceAllocator final : public SurfaceAllocator {
+	public:
+		/// One 3840x2160 32-bit framebuffer.
+		static constexpr size_t defaultHugePageThreshold = size_t{3840} * 2160 * sizeof(uint32_t);
+
+		/**
+		 * @param hugePageThreshold Smallest allocation backed by huge pages; `SIZE_MAX` disables them.
+		 */
+		explicit HeapSurfaceAllocator(size_t hugePageThreshold = defaultHugePageThreshold);
+
+		[[nodiscard]] void *allocate(size_t bytes) override;
+
+		void deallocate(void *memory, size_t bytes) override;
+
+	private:
+		size_t hugePageThreshold;
+	};
+
+	/**
+	 * @brief A bump allocator for scratch surfaces that only live for one frame.
+	 *
+	 * Allocating is a pointer increment and deallocating does nothing; `reset()` makes all of the memory
+	 * available again at once, and the engine calls it at the start of every frame. Blocks are kept
+	 * across resets, so after the first few frames a steady workload allocates nothing at all.
+	 */
+	class FrameArena final : public SurfaceAllocator {
+	public:
+		/// Size of the blocks requested from the upstream allocator; larger allocations get a block of their own.
+		static constexpr size_t defaultBlockSize = size_t{4} << 20;
+
+		/**
+		 * @param upstream Allocator the blocks come from; must outlive the arena.
+		 * @param blockSize Size of each block.
+		 */
+		explicit FrameArena(SurfaceAllocator &upstream = getDefault(), size_t blockSize = defaultBlockSize);
+
+		~FrameArena() override;
+
+		FrameArena(const FrameArena &) = delete;
+		FrameArena &operator=(const FrameArena &) = delete;
+
+		[[nodiscard]] void *allocate(size_t bytes) override;
+
+		void deallocate(void *memory, size_t bytes) override;
+
+		/**
+		 * @brief Releases every allocation at once. Surfaces allocated before must no longer be used.
+		 */
+		void reset();
+
+		/**
+		 * @brief Gets the bytes handed out since the last reset, alignment padding included.
+		 */
+		[[nodiscard]] size_t getUsedBytes() const;
+
+		/**
+		 * @brief Gets the bytes held in blocks, used or not.
+		 */
+		[[nodiscard]] size_t getCapacityBytes() const;
+
+	private:
+		struct Block {
+			std::byte *memory;
+			size_t size;
+		};
+
+		SurfaceAllocator &upstream;
+		size_t blockSize;
+		std::vector<Block> blocks; ///< Every block, the ones in use first.
+		size_t current = 0; ///< Index of the block being filled.
+		size_t offset = 0; ///< Bytes used in the current block.
+		size_t usedBytes = 0; ///< Bytes used in the blocks before the current one.
+	};
+
+	/**
+	 * @brief Recycles freed buffers for offscreen surfaces that are created and destroyed repeatedly.
+	 *
+	 * Allocations are rounded up to size classes, eight per power of two, so that at most 12.5% is
+	 * wasted; a freed buffer goes to the free list of its class and serves the next allocation of that
+	 * class, e.g. the surfaces re-created at a new size by dynamic resolution.
+	 */
+	class SurfacePool final : public SurfaceAllocator {
+	public:
+		/**
+		 * @param upstream Allocator the buffers come from; must outlive the pool.
+		 */
+		explicit SurfacePool(SurfaceAllocator &upstream = getDefault());
+
+		/**
+		 * @brief Returns the free buffers to the upstream allocator; buffers still in use must be freed first.
+		 */
+		~SurfacePool() override;
+
+		SurfacePool(const SurfacePool &) = delete;
+		SurfacePool &operator=(const SurfacePool &) = delete;
+
+		[[nodiscard]] void *allocate(size_t bytes) override;
+
+		void deallocate(void *memory, size_t bytes) override;
+
+		/**
+		 * @brief Returns every free buffer to the upstream allocator.
+		 */
+		void trim();
+
+		/**
+		 * @brief Gets the bytes held in free buffers.
+		 */
+		[[nodiscard]] size_t getFreeBytes() const;
+
+		/**
+		 * @brief Gets the size class an allocation of `bytes` is rounded up to.
+		 */
+		[[nodiscard]] static size_t sizeClass(size_t bytes);
+
+	private:
+		SurfaceAllocator &upstream;
+		std::unordered_map<size_t, std::vector<void *>> freeBuffers; ///< Free buffers by size class.
+		size_t freeBytes = 0;
+	};
+
+	/**
+	 * @brief Owns one allocation of a `SurfaceAllocator` and returns it on destruction.
+	 */
+	class PixelStorage {
+	public:
+		PixelStorage() = default;
+
+		/**
+		 * @brief Allocates `bytes` bytes from `allocator`.
+		 */
+		PixelStorage(SurfaceAllocator &allocator, const size_t bytes) :
+			allocator(&allocator), memory(allocator.allocate(bytes)), bytes(bytes) {}
+
+		~PixelStorage() {
+			if (memory) {
+				allocator->deallocate(memory, bytes);
+			}
+		}
+
+		PixelStorage(const PixelStorage &) = delete;
+		PixelStorage &operator=(const PixelStorage &) = delete;
+
+		PixelStorage(PixelStorage &&other) noexcept :
+			allocator(other.allocator), memory(std::exchange(other.memory, nullptr)),
+			bytes(std::exchange(other.bytes, 0)) {}
+
+		PixelStorage &operator=(PixelStorage &&other) noexcept {
+			if (this != &other) {
+				if (memory) {
+					allocator->deallocate(memory, bytes);
+				}
+				allocator = other.allocator;
+				memory = std::exchange(other.memory, nullptr);
+				bytes = std::exchange(other.bytes, 0);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Gets the memory, aligned to `pixelAlignment`, as an array of `T`.
+		 */
+		template<typename T>
+		[[nodiscard]] T *as() const {
+			return static_cast<T *>(memory);
+		}
+
+		/**
+		 * @brief Gets the size of the allocation in bytes.
+		 */
+		[[nodiscard]] size_t size() const { return bytes; }
+
+	private:
+		SurfaceAllocator *allocator = nullptr;
+		void *memory = nullptr;
+		size_t bytes = 0;
+	};
+
+	/**
+	 * @brief Rounds a row length up so that every row starts on a `pixelAlignment` boundary.
+	 * @param width Row length in pixels.
+	 * @param pixelBytes Size of one pixel; must divide `pixelAlignment`.
+	 * @return The row pitch in pixels.
+	 */
+	[[nodiscard]] constexpr int alignedPitch(const int width, const size_t pixelBytes) {
+		const auto pixelsPerAlignment = static_cast<int>(pixelAlignment / pixelBytes);
+		return (width + pixelsPerAlignment - 1) / pixelsPerAlignment * pixelsPerAlignment;
+	}
+} // namespace pxe
@@ -0,0 +1,120 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "color.h"
+#include "geometry.h"
+
+namespace pxe {
+	/**
+	 * @brief A mutable, row-pitched window into a surface's pixel buffer.
+	 *
+	 * Views are clipped once when they are created, so accessing them only asserts (in debug builds)
+	 * instead of bounds checking every pixel. Pixels are stored in the native `PixelFormat`; row `y`
+	 * starts `y * getPitch()` pixels after row 0. A view stays valid until the frame ends.
+	 */
+	class SurfaceView {
+	public:
+		SurfaceView() = default;
+
+		/**
+		 * @brief Creates a view over an existing pixel buffer.
+		 * @param pixels Pointer to the first pixel of the view.
+		 * @param width Width of the view in pixels.
+		 * @param height Height of the view in pixels.
+		 * @param pitch Distance in pixels between the starts of two consecutive rows.
+		 */
+		SurfaceView(uint32_t *pixels, const int width, const int height, const int pitch) :
+			pixels(pixels), width(width), height(height), pitch(pitch) {}
+
+		/**
+		 * @brief Gets a pointer to the first pixel of a row.
+		 * @param y Row index, relative to the view.
+		 */
+		[[nodiscard]] uint32_t *row(const int y) const {
+			assert(y >= 0 && y < height);
+			return pixels + static_cast<ptrdiff_t>(y) * pitch;
+		}
+
+		/**
+		 * @brief Writes a pixel without bounds checking.
+		 * @param x X-coordinate, relative to the view.
+		 * @param y Y-coordinate, relative to the view.
+		 * @param color The color to store.
+		 */
+		void setPixel(const int x, const int y, const Color color) const {
+			assert(x >= 0 && x < width);
+			row(y)[x] = color.pixel();
+		}
+
+		/**
+		 * @brief Reads a pixel without bounds checking.
+		 * @param x X-coordinate, relative to the view.
+		 * @param y Y-coordinate, relative to the view.
+		 */
+		[[nodiscard]] Color getPixel(const int x, const int y) const {
+			assert(x >= 0 && x < width);
+			return Color::fromPixel(row(y)[x]);
+		}
+
+		/**
+		 * @brief Creates a view over a region of this view.
+		 *
+		 * The region is clipped to this view.
+		 * @param region The region, relative to this view.
+		 */
+		[[nodiscard]] SurfaceView subView(const Rect &region) const {
+			const int x0 = region.x < 0 ? 0 : region.x;
+			const int y0 = region.y < 0 ? 0 : region.y;
+			const int x1 = region.right() > width ? width : region.right();
+			const int y1 = region.bottom() > height ? height : region.bottom();
+			if (x0 >= x1 || y0 >= y1)
+				return {};
+			return {pixels + static_cast<ptrdiff_t>(y0) * pitch + x0, x1 - x0, y1 - y0, pitch};
+		}
+
+		/**
+		 * @brief Gets the width of the view in pixels.
+		 */
+		[[nodiscard]] int getWidth() const { return width; }
+
+		/**
+		 * @brief Gets the height of the view in pixels.
+		 */
+		[[nodiscard]] int getHeight() const { return height; }
+
+		/**
+		 * @brief Gets the distance in pixels between the starts of two consecutive rows.
+		 */
+		[[nodiscard]] int getPitch() const { return pitch; }
+
+		/**
+		 * @brief Checks whether the view covers no pixels.
+		 */
+		[[nodiscard]] bool isEmpty() const { return width <= 0 || height <= 0; }
+
+	private:
+		uint32_t *pixels = nullptr;
+		int width = 0;
+		int height = 0;
+		int pitch = 0;
+	};
+} // namespace pxe
@@ -0,0 +1,70 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assetLoader.h"
+#include <algorithm>
+#include <utility>
+#include "imageFile.h"
+
+namespace pxe {
+	AssetLoader::AssetLoader(const unsigned threadCount) {
+		const unsigned count = std::max(threadCount, 1u);
+		workers.reserve(count);
+		for (unsigned i = 0; i < count; i++) {
+			workers.emplace_back(&AssetLoader::workerLoop, this);
+		}
+	}
+
+	AssetLoader::~AssetLoader() {
+		{
+			std::lock_guard lock(queueMutex);
+			stopping = true;
+		}
+		queueCondition.notify_all();
+		for (std::thread &worker: workers) {
+			worker.join();
+		}
+	}
+
+	std::future<Image> AssetLoader::load(std::string path) {
+		std::packaged_task<Image()> task([path = std::move(path)] { return loadImage(path); });
+		std::future<Image> result = task.get_future();
+		{
+			std::lock_guard lock(queueMutex);
+			queue.push_back(std::move(task));
+		}
+		queueCondition.notify_one();
+		return result;
+	}
+
+	void AssetLoader::workerLoop() {
+		while (true) {
+			std::packaged_task<Image()> task;
+			{
+				std::unique_lock lock(queueMutex);
+				queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+				if (stopping)
+					return;
+				task = std::move(queue.front());
+				queue.pop_front();
+			}
+			// Exceptions are stored in the future by the task itself.
+			task();
+		}
+	}
+} // namespace pxe
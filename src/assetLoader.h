@@ -0,0 +1,70 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief Loads and decodes image files on background threads.
+	 *
+	 * Unlike `ThreadPool`, which runs one data-parallel loop at a time while the caller waits, the
+	 * loader keeps a queue of independent jobs so that a frame can request assets and keep running.
+	 */
+	class AssetLoader {
+	public:
+		/**
+		 * @brief Starts the loader threads.
+		 * @param threadCount Number of threads decoding concurrently; at least one is started.
+		 */
+		explicit AssetLoader(unsigned threadCount);
+
+		/**
+		 * @brief Finishes the loads already running and joins the threads.
+		 *
+		 * Queued loads that have not started are abandoned; their futures report `std::future_errc::broken_promise`.
+		 */
+		~AssetLoader();
+
+		AssetLoader(const AssetLoader &) = delete;
+		AssetLoader &operator=(const AssetLoader &) = delete;
+
+		/**
+		 * @brief Queues a `loadImage` call.
+		 * @param path Path of the file.
+		 * @return A future receiving the image, or the exception `loadImage` threw.
+		 */
+		[[nodiscard]] std::future<Image> load(std::string path);
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex queueMutex;
+		std::condition_variable queueCondition;
+		std::deque<std::packaged_task<Image()>> queue;
+		bool stopping = false;
+
+		void workerLoop();
+	};
+} // namespace pxe
@@ -0,0 +1,80 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "atlasPacker.h"
+#include <algorithm>
+#include <climits>
+
+namespace pxe {
+	AtlasPacker::AtlasPacker(const int width, const int height) : width(width), height(height) {
+		skyline.push_back({0, 0, width});
+	}
+
+	std::optional<Rect> AtlasPacker::insert(const int width, const int height) {
+		if (width <= 0 || height <= 0 || width > this->width || height > this->height)
+			return std::nullopt;
+
+		// Try the left edge of every run; the rectangle rests on the highest run it spans.
+		size_t bestIndex = skyline.size();
+		int bestBottom = INT_MAX, bestWidth = INT_MAX, bestY = 0;
+		for (size_t i = 0; i < skyline.size(); i++) {
+			const int x = skyline[i].x;
+			if (x + width > this->width)
+				break;
+			int y = 0;
+			for (size_t j = i; j < skyline.size() && skyline[j].x < x + width; j++) {
+				y = std::max(y, skyline[j].y);
+			}
+			if (y + height > this->height)
+				continue;
+			if (y + height < bestBottom || (y + height == bestBottom && skyline[i].width < bestWidth)) {
+				bestIndex = i;
+				bestBottom = y + height;
+				bestWidth = skyline[i].width;
+				bestY = y;
+			}
+		}
+		if (bestIndex == skyline.size())
+			return std::nullopt;
+
+		// Replace the covered runs with one at the rectangle's bottom, trimming the last partially covered run.
+		const int x = skyline[bestIndex].x;
+		size_t end = bestIndex;
+		while (end < skyline.size() && skyline[end].x + skyline[end].width <= x + width) {
+			end++;
+		}
+		if (end < skyline.size() && skyline[end].x < x + width) {
+			Segment &partial = skyline[end];
+			partial.width -= x + width - partial.x;
+			partial.x = x + width;
+		}
+		const auto first = skyline.begin() + static_cast<ptrdiff_t>(bestIndex);
+		skyline.insert(skyline.erase(first, skyline.begin() + static_cast<ptrdiff_t>(end)), {x, bestBottom, width});
+
+		// Merge neighbours at the same level so the number of runs stays small.
+		for (size_t i = 0; i + 1 < skyline.size();) {
+			if (skyline[i].y == skyline[i + 1].y) {
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase(skyline.begin() + static_cast<ptrdiff_t>(i) + 1);
+			} else {
+				i++;
+			}
+		}
+		return Rect{x, bestY, width, height};
+	}
+} // namespace pxe
@@ -0,0 +1,58 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <optional>
+#include <vector>
+#include "geometry.h"
+
+namespace pxe {
+	/**
+	 * @brief Packs rectangles into a fixed-size area with the skyline bottom-left heuristic.
+	 *
+	 * The packer tracks the lowest free row over each horizontal run of the area (the skyline) and
+	 * places every rectangle where its bottom edge ends up highest, breaking ties towards narrower
+	 * gaps. Rectangles are never removed.
+	 */
+	class AtlasPacker {
+	public:
+		/**
+		 * @brief Creates an empty packer.
+		 * @param width Width of the area.
+		 * @param height Height of the area.
+		 */
+		AtlasPacker(int width, int height);
+
+		/**
+		 * @brief Reserves space for a rectangle.
+		 * @param width Width of the rectangle.
+		 * @param height Height of the rectangle.
+		 * @return The reserved region, or nothing if the rectangle does not fit anywhere.
+		 */
+		[[nodiscard]] std::optional<Rect> insert(int width, int height);
+
+	private:
+		/// A run of the skyline: columns [x, x + width) are used down to row `y`.
+		struct Segment {
+			int x, y, width;
+		};
+
+		int width, height;
+		std::vector<Segment> skyline; ///< Runs ordered by `x`, covering the full width.
+	};
+} // namespace pxe
@@ -0,0 +1,67 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "basicSurface.h"
+#include <algorithm>
+#include <cstring>
+#include "pixelKernels.h"
+
+namespace pxe {
+	void detileLinear(const uint32_t *pixels, const int pitch, const SurfaceView &view) {
+		const size_t rowBytes = static_cast<size_t>(view.getWidth()) * sizeof(uint32_t);
+		for (int y = 0; y < view.getHeight(); y++) {
+			std::memcpy(view.row(y), pixels + static_cast<ptrdiff_t>(y) * pitch, rowBytes);
+		}
+	}
+
+	void detileBlocked(const uint32_t *pixels, const int pitch, const int tileSize, const SurfaceView &view) {
+		const int mask = tileSize - 1;
+		for (int y = 0; y < view.getHeight(); y++) {
+			// Row `y` is one run of `tileSize` pixels in every tile of its row of tiles.
+			const uint32_t *tileRow = pixels + static_cast<ptrdiff_t>(y & ~mask) * pitch + (y & mask) * tileSize;
+			uint32_t *dst = view.row(y);
+			for (int x = 0; x < view.getWidth(); x += tileSize) {
+				const int count = std::min(tileSize, view.getWidth() - x);
+				std::memcpy(dst + x, tileRow + static_cast<ptrdiff_t>(x) * tileSize, count * sizeof(uint32_t));
+			}
+		}
+	}
+
+	void detileMorton(const uint32_t *pixels, const int pitch, const SurfaceView &view) {
+		constexpr int tileSize = 16;
+		const DetileKernels &kernels = detileKernels();
+		const auto dstPitch = static_cast<size_t>(view.getPitch());
+		for (int tileY = 0; tileY < view.getHeight(); tileY += tileSize) {
+			const uint32_t *tile = pixels + static_cast<ptrdiff_t>(tileY) * pitch;
+			const int rows = std::min(tileSize, view.getHeight() - tileY);
+			for (int tileX = 0; tileX < view.getWidth(); tileX += tileSize, tile += tileSize * tileSize) {
+				const int columns = std::min(tileSize, view.getWidth() - tileX);
+				if (rows == tileSize && columns == tileSize) {
+					kernels.mortonTile(view.row(tileY) + tileX, dstPitch, tile);
+					continue;
+				}
+				// Edge tiles are detiled whole into a scratch tile, then clipped.
+				alignas(16) uint32_t scratch[tileSize * tileSize];
+				kernels.mortonTile(scratch, tileSize, tile);
+				for (int y = 0; y < rows; y++) {
+					std::memcpy(view.row(tileY + y) + tileX, scratch + y * tileSize, columns * sizeof(uint32_t));
+				}
+			}
+		}
+	}
+} // namespace pxe
@@ -0,0 +1,156 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bigFixed.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace pxe {
+	BigFixed BigFixed::fromDouble(const double value) {
+		if (!std::isfinite(value) || std::fabs(value) >= 4294967296.0)
+			throw std::out_of_range("BigFixed: value out of range");
+		BigFixed result;
+		result.negative = value < 0.0;
+		// Peeling off 32 bits at a time is exact: the fraction of a double and its scaling by 2^32 both are.
+		double remaining = std::fabs(value);
+		for (size_t k = 0; k < result.limbs.size() && remaining != 0.0; k++) {
+			const double limb = std::floor(remaining);
+			result.limbs[k] = static_cast<uint32_t>(limb);
+			remaining = std::ldexp(remaining - limb, 32);
+		}
+		return result;
+	}
+
+	BigFixed BigFixed::fromDecimal(std::string_view text) {
+		BigFixed result;
+		if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+			result.negative = text.front() == '-';
+			text.remove_prefix(1);
+		}
+		const size_t point = text.find('.');
+		const std::string_view integer = text.substr(0, point);
+		const std::string_view fraction = point == std::string_view::npos ? std::string_view{} : text.substr(point + 1);
+		if (integer.empty() && fraction.empty())
+			throw std::invalid_argument("BigFixed: not a decimal number");
+
+		// The fraction is accumulated from its last digit: x = (digit + x) / 10.
+		for (auto it = fraction.rbegin(); it != fraction.rend(); ++it) {
+			if (*it < '0' || *it > '9')
+				throw std::invalid_argument("BigFixed: not a decimal number");
+			uint64_t remainder = static_cast<uint32_t>(*it - '0');
+			for (size_t k = 1; k < result.limbs.size(); k++) {
+				const uint64_t dividend = remainder << 32 | result.limbs[k];
+				result.limbs[k] = static_cast<uint32_t>(dividend / 10);
+				remainder = dividend % 10;
+			}
+		}
+		uint64_t whole = 0;
+		for (const char c: integer) {
+			if (c < '0' || c > '9')
+				throw std::invalid_argument("BigFixed: not a decimal number");
+			whole = whole * 10 + static_cast<uint64_t>(c - '0');
+			if (whole > UINT32_MAX)
+				throw std::out_of_range("BigFixed: value out of range");
+		}
+		result.limbs[0] = static_cast<uint32_t>(whole);
+		return result;
+	}
+
+	double BigFixed::toDouble() const {
+		double value = 0.0;
+		for (size_t k = limbs.size(); k-- > 0;) {
+			value = std::ldexp(value, -32) + limbs[k];
+		}
+		return negative ? -value : value;
+	}
+
+	BigFixed BigFixed::multiply(const BigFixed &other, const int precision) const {
+		const size_t used = static_cast<size_t>(precision) + 1;
+		// Column k collects the partial products weighing 2^(-32k); one guard column absorbs the carries
+		// of the truncated ones. Sums of 32-bit halves cannot overflow 64 bits at this length.
+		uint64_t columns[maxFractionLimbs + 2] = {};
+		for (size_t i = 0; i < used; i++) {
+			if (limbs[i] == 0)
+				continue;
+			for (size_t j = 0; i + j <= used && j < used; j++) {
+				const uint64_t product = static_cast<uint64_t>(limbs[i]) * other.limbs[j];
+				columns[i + j] += product & 0xFFFFFFFF;
+				if (i + j > 0) {
+					columns[i + j - 1] += product >> 32;
+				}
+			}
+		}
+		BigFixed result;
+		result.negative = negative != other.negative;
+		uint64_t carry = columns[used] >> 32;
+		for (size_t k = used; k-- > 0;) {
+			const uint64_t sum = columns[k] + carry;
+			result.limbs[k] = static_cast<uint32_t>(sum);
+			carry = sum >> 32;
+		}
+		return result;
+	}
+
+	BigFixed BigFixed::operator+(const BigFixed &other) const {
+		BigFixed result = *this;
+		if (negative == other.negative) {
+			addMagnitude(result.limbs, other.limbs);
+		} else if (lessMagnitude(limbs, other.limbs)) {
+			result.limbs = other.limbs;
+			result.negative = other.negative;
+			subtractMagnitude(result.limbs, limbs);
+		} else {
+			subtractMagnitude(result.limbs, other.limbs);
+		}
+		return result;
+	}
+
+	BigFixed BigFixed::operator-(const BigFixed &other) const { return *this + -other; }
+
+	BigFixed BigFixed::operator-() const {
+		BigFixed result = *this;
+		result.negative = !negative;
+		return result;
+	}
+
+	bool BigFixed::lessMagnitude(const Limbs &a, const Limbs &b) {
+		for (size_t k = 0; k < a.size(); k++) {
+			if (a[k] != b[k])
+				return a[k] < b[k];
+		}
+		return false;
+	}
+
+	void BigFixed::addMagnitude(Limbs &a, const Limbs &b) {
+		uint64_t carry = 0;
+		for (size_t k = a.size(); k-- > 0;) {
+			const uint64_t sum = static_cast<uint64_t>(a[k]) + b[k] + carry;
+			a[k] = static_cast<uint32_t>(sum);
+			carry = sum >> 32;
+		}
+	}
+
+	void BigFixed::subtractMagnitude(Limbs &a, const Limbs &b) {
+		uint64_t borrow = 0;
+		for (size_t k = a.size(); k-- > 0;) {
+			const uint64_t difference = static_cast<uint64_t>(a[k]) - b[k] - borrow;
+			a[k] = static_cast<uint32_t>(difference);
+			borrow = difference >> 63;
+		}
+	}
+} // namespace pxe
@@ -0,0 +1,83 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace pxe {
+	/**
+	 * @brief A signed fixed-point number with a 32-bit integer part and up to `maxFractionLimbs` 32-bit
+	 * fraction limbs (about 1100 bits).
+	 *
+	 * Deep zooms need coordinates far below the resolution of a double, so the reference orbit of the
+	 * perturbation renderer is iterated in this type. Products only use the first `precision` fraction
+	 * limbs, so their cost follows the zoom depth; they are truncated rather than rounded. Values must stay
+	 * below 2^32 in magnitude, which escape-time iteration guarantees.
+	 */
+	class BigFixed {
+	public:
+		static constexpr int maxFractionLimbs = 36;
+
+		BigFixed() = default;
+
+		/**
+		 * @brief Converts a double exactly.
+		 * @throws std::out_of_range if the magnitude is not below 2^32 or the value is not finite.
+		 */
+		[[nodiscard]] static BigFixed fromDouble(double value);
+
+		/**
+		 * @brief Parses a decimal number such as "-0.7436438870371587047521915061".
+		 *
+		 * Accepts an optional sign, digits and an optional fraction; digits beyond the precision of the
+		 * type are truncated.
+		 * @throws std::invalid_argument if the text is not a plain decimal number.
+		 * @throws std::out_of_range if the integer part does not fit in 32 bits.
+		 */
+		[[nodiscard]] static BigFixed fromDecimal(std::string_view text);
+
+		/**
+		 * @brief Gets the nearest double (rounding may differ from correct rounding in the last bit).
+		 */
+		[[nodiscard]] double toDouble() const;
+
+		/**
+		 * @brief Multiplies two numbers, keeping `precision` fraction limbs.
+		 * @param other The other factor.
+		 * @param precision Number of fraction limbs of both factors used and of the result; at most
+		 * `maxFractionLimbs`.
+		 */
+		[[nodiscard]] BigFixed multiply(const BigFixed &other, int precision) const;
+
+		BigFixed operator+(const BigFixed &other) const;
+		BigFixed operator-(const BigFixed &other) const;
+		BigFixed operator-() const;
+
+	private:
+		using Limbs = std::array<uint32_t, maxFractionLimbs + 1>;
+
+		bool negative = false;
+		Limbs limbs{}; ///< Magnitude; limbs[0] is the integer part, limbs[k] weighs 2^(-32k).
+
+		static bool lessMagnitude(const Limbs &a, const Limbs &b);
+		static void addMagnitude(Limbs &a, const Limbs &b);
+		static void subtractMagnitude(Limbs &a, const Limbs &b);
+	};
+} // namespace pxe
@@ -0,0 +1,207 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "binnedRasterizer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "pixelKernels.h"
+#include "rasterizer.h"
+#include "surface.h"
+
+namespace pxe {
+	namespace {
+		static_assert(BinnedRasterizer::tileSize % Surface::dirtyTileSize == 0);
+
+		Rect intersect(const Rect &a, const Rect &b) {
+			const int x0 = std::max(a.x, b.x), y0 = std::max(a.y, b.y);
+			const int x1 = std::min(a.right(), b.right()), y1 = std::min(a.bottom(), b.bottom());
+			if (x0 >= x1 || y0 >= y1)
+				return {};
+			return {x0, y0, x1 - x0, y1 - y0};
+		}
+
+		Rect unite(const Rect &a, const Rect &b) {
+			if (a.isEmpty())
+				return b;
+			const int x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+			return {x0, y0, std::max(a.right(), b.right()) - x0, std::max(a.bottom(), b.bottom()) - y0};
+		}
+
+		// The half-open range [low, high) clamped to [0, limit], as 64-bit values so far off-surface vertices
+		// cannot overflow.
+		Rect clampedBox(const int64_t x0, const int64_t y0, const int64_t x1, const int64_t y1, const Rect &bounds) {
+			const auto left = static_cast<int>(std::clamp<int64_t>(x0, 0, bounds.width));
+			const auto top = static_cast<int>(std::clamp<int64_t>(y0, 0, bounds.height));
+			const auto right = static_cast<int>(std::clamp<int64_t>(x1, 0, bounds.width));
+			const auto bottom = static_cast<int>(std::clamp<int64_t>(y1, 0, bounds.height));
+			return {left, top, right - left, bottom - top};
+		}
+	} // namespace
+
+	void BinnedRasterizer::execute(const CommandList &commands, Surface &surface, const ParallelFor &parallelFor) {
+		using CommandType = CommandList::CommandType;
+		const std::span<const CommandList::Command> list = commands.getCommands();
+		const Rect bounds = surface.getBounds();
+		const int columns = (bounds.width + tileSize - 1) / tileSize;
+		const int rows = (bounds.height + tileSize - 1) / tileSize;
+		const auto tileCount = static_cast<size_t>(columns) * rows;
+		for (const int tile: activeTiles) {
+			bins[tile].clear();
+		}
+		bins.resize(tileCount);
+		binBounds.assign(tileCount, Rect{});
+		activeTiles.clear();
+		clippedLines.resize(list.size());
+
+		for (size_t index = 0; index < list.size(); index++) {
+			const CommandList::Command &command = list[index];
+			const int *v = command.values;
+			const auto id = static_cast<uint32_t>(index);
+			switch (command.type) {
+				case CommandType::FillRect:
+					bin(id, intersect({v[0], v[1], v[2], v[3]}, bounds), columns);
+					break;
+				case CommandType::Line: {
+					Line line{v[0], v[1], v[2], v[3]};
+					if (clipLine(bounds, line)) {
+						clippedLines[index] = line;
+						binLine(id, line, columns);
+					}
+					break;
+				}
+				case CommandType::Circle:
+				case CommandType::FilledCircle:
+					if (v[2] >= 0) {
+						const int64_t radius = v[2];
+						bin(id, clampedBox(v[0] - radius, v[1] - radius, v[0] + radius + 1, v[1] + radius + 1, bounds),
+							columns);
+					}
+					break;
+				case CommandType::Triangle: {
+					// Same box as rasterizeTriangle: the maximum coordinates are never covered.
+					const int64_t minX = std::min({v[0], v[2], v[4]}), maxX = std::max({v[0], v[2], v[4]});
+					const int64_t minY = std::min({v[1], v[3], v[5]}), maxY = std::max({v[1], v[3], v[5]});
+					bin(id, clampedBox(minX, minY, maxX, maxY, bounds), columns);
+					break;
+				}
+				case CommandType::Span:
+					bin(id, clampedBox(v[0], v[1], static_cast<int64_t>(v[0]) + v[2], static_cast<int64_t>(v[1]) + 1,
+									   bounds),
+						columns);
+					break;
+			}
+		}
+
+		for (const int tile: activeTiles) {
+			surface.markDirty(binBounds[tile]);
+		}
+		const SurfaceView view = surface.getView();
+		parallelFor(static_cast<int>(activeTiles.size()), [&](const int index) {
+			const int tile = activeTiles[index];
+			const Rect region =
+					intersect({tile % columns * tileSize, tile / columns * tileSize, tileSize, tileSize}, bounds);
+			drawTile(commands, bins[tile], region, view.subView(region));
+		});
+	}
+
+	void BinnedRasterizer::bin(const uint32_t command, const Rect &bounds, const int columns) {
+		if (bounds.isEmpty())
+			return;
+		const int lastColumn = (bounds.right() - 1) / tileSize, lastRow = (bounds.bottom() - 1) / tileSize;
+		for (int row = bounds.y / tileSize; row <= lastRow; row++) {
+			for (int column = bounds.x / tileSize; column <= lastColumn; column++) {
+				const int tile = row * columns + column;
+				if (bins[tile].empty()) {
+					activeTiles.push_back(tile);
+				}
+				bins[tile].push_back(command);
+				binBounds[tile] = unite(binBounds[tile], intersect(bounds, {column * tileSize, row * tileSize,
+																			tileSize, tileSize}));
+			}
+		}
+	}
+
+	void BinnedRasterizer::binLine(const uint32_t command, const Line &line, const int columns) {
+		const bool xMajor = std::abs(line.y1 - line.y0) <= std::abs(line.x1 - line.x0);
+		const int majorStart = xMajor ? line.x0 : line.y0, minorStart = xMajor ? line.y0 : line.x0;
+		const int majorDelta = (xMajor ? line.x1 : line.y1) - majorStart;
+		const int minorDelta = (xMajor ? line.y1 : line.x1) - minorStart;
+		const int majorLow = std::min(majorStart, majorStart + majorDelta);
+		const int majorHigh = std::max(majorStart, majorStart + majorDelta);
+		const Rect bounds{0, 0, columns * tileSize, static_cast<int>(bins.size()) / columns * tileSize};
+
+		// Bresenham stays within one pixel of the exact line, so each tile-sized step of the major axis gets the
+		// exact minor range widened by one pixel on both sides.
+		auto minorAt = [&](const int major) {
+			return majorDelta == 0 ? minorStart
+								   : minorStart + static_cast<int>(static_cast<int64_t>(major - majorStart) *
+																			   minorDelta / majorDelta);
+		};
+		for (int low = majorLow; low <= majorHigh; low = (low / tileSize + 1) * tileSize) {
+			const int high = std::min(majorHigh, (low / tileSize + 1) * tileSize - 1);
+			const int minorA = minorAt(low), minorB = minorAt(high);
+			const int minorLow = std::min(minorA, minorB) - 1, minorHigh = std::max(minorA, minorB) + 1;
+			const Rect box = xMajor ? Rect{low, minorLow, high - low + 1, minorHigh - minorLow + 1}
+									: Rect{minorLow, low, minorHigh - minorLow + 1, high - low + 1};
+			bin(command, intersect(box, bounds), columns);
+		}
+	}
+
+	void BinnedRasterizer::drawTile(const CommandList &commands, const std::vector<uint32_t> &tileCommands,
+									const Rect &tile, const SurfaceView &view) const {
+		using CommandType = CommandList::CommandType;
+		const FillKernels &kernels = fillKernels();
+		const std::span<const CommandList::Command> list = commands.getCommands();
+		const uint32_t *spanPixels = commands.getSpanPixels().data();
+		for (const uint32_t index: tileCommands) {
+			const CommandList::Command &command = list[index];
+			const int *v = command.values;
+			switch (command.type) {
+				case CommandType::FillRect: {
+					const Rect region = intersect({v[0], v[1], v[2], v[3]}, tile);
+					if (!region.isEmpty()) {
+						pxe::fillRect(kernels, view.row(region.y - tile.y) + (region.x - tile.x), region.width,
+									  region.height, view.getPitch(), command.pixel);
+					}
+					break;
+				}
+				case CommandType::Line:
+					rasterizeLineRegion(view, tile, clippedLines[index], command.pixel);
+					break;
+				case CommandType::Circle:
+				case CommandType::FilledCircle:
+					rasterizeCircle(view, v[0] - tile.x, v[1] - tile.y, v[2], command.pixel,
+									command.type == CommandType::FilledCircle);
+					break;
+				case CommandType::Triangle:
+					rasterizeTriangle(view, v[0] - tile.x, v[1] - tile.y, v[2] - tile.x, v[3] - tile.y, v[4] - tile.x,
+									  v[5] - tile.y, command.pixel);
+					break;
+				case CommandType::Span: {
+					const Rect region = intersect({v[0], v[1], v[2], 1}, tile);
+					if (!region.isEmpty()) {
+						std::memcpy(view.row(region.y - tile.y) + (region.x - tile.x),
+									spanPixels + v[3] + (region.x - v[0]), region.width * sizeof(uint32_t));
+					}
+					break;
+				}
+			}
+		}
+	}
+} // namespace pxe
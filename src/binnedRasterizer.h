@@ -0,0 +1,79 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "commandList.h"
+#include "geometry.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	class Surface;
+
+	/**
+	 * @brief Rasterizes command lists in parallel, one screen tile at a time.
+	 *
+	 * `execute` clips the commands, bins each one to the tiles it touches and rasterizes the tiles on the
+	 * thread pool, every tile replaying its commands in submission order. Lines, circles and triangles are
+	 * rasterized per tile with the same rules as `Surface`, so the image is identical to drawing the
+	 * commands one after the other on one thread.
+	 */
+	class BinnedRasterizer {
+	public:
+		/// Runs `body(i)` for every i in [0, count), e.g. `Engine::parallelFor`.
+		using ParallelFor = std::function<void(int count, const std::function<void(int index)> &body)>;
+
+		/// Edge length in pixels of the tiles commands are binned to; a multiple of `Surface::dirtyTileSize`.
+		static constexpr int tileSize = 64;
+
+		/**
+		 * @brief Draws a command list into a surface.
+		 *
+		 * Binning and dirty marking run on the calling thread; only the tiles run in parallel.
+		 * @param commands The commands, in drawing order.
+		 * @param surface The destination.
+		 * @param parallelFor Runs the tiles, in any order and on any threads.
+		 */
+		void execute(const CommandList &commands, Surface &surface, const ParallelFor &parallelFor);
+
+	private:
+		std::vector<Line> clippedLines; ///< Line commands clipped to the surface, by command index.
+		std::vector<std::vector<uint32_t>> bins; ///< Indices of the commands of each tile, in submission order.
+		std::vector<Rect> binBounds; ///< Union of the regions the commands of each bin may modify.
+		std::vector<int> activeTiles; ///< Tiles with a non-empty bin.
+
+		/**
+		 * @brief Appends a command to the bins of the tiles overlapping `bounds`, which lies inside the surface.
+		 */
+		void bin(uint32_t command, const Rect &bounds, int columns);
+
+		/**
+		 * @brief Appends a clipped line to the bins of the tiles along it, one tile-sized step of its major
+		 * axis at a time.
+		 */
+		void binLine(uint32_t command, const Line &line, int columns);
+
+		/**
+		 * @brief Rasterizes the commands of one bin into the tile's view.
+		 */
+		void drawTile(const CommandList &commands, const std::vector<uint32_t> &tileCommands, const Rect &tile,
+					  const SurfaceView &view) const;
+	};
+} // namespace pxe
@@ -0,0 +1,64 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "blitter.h"
+#include <algorithm>
+#include <cstring>
+#include "pixelKernels.h"
+
+namespace pxe {
+	Rect blitImage(const SurfaceView &target, const Image &source, const Rect &sourceRegion, const int x, const int y,
+				   const BlendMode mode) {
+		// Clip the source region to the image, shifting the destination along with it, then clip the
+		// destination to the target and shift the source back.
+		int srcX0 = std::max(sourceRegion.x, 0), srcY0 = std::max(sourceRegion.y, 0);
+		int srcX1 = std::min(sourceRegion.right(), source.getWidth());
+		int srcY1 = std::min(sourceRegion.bottom(), source.getHeight());
+		const int64_t offsetX = static_cast<int64_t>(x) - sourceRegion.x;
+		const int64_t offsetY = static_cast<int64_t>(y) - sourceRegion.y;
+		srcX0 = static_cast<int>(std::max<int64_t>(srcX0, -offsetX));
+		srcY0 = static_cast<int>(std::max<int64_t>(srcY0, -offsetY));
+		srcX1 = static_cast<int>(std::min<int64_t>(srcX1, target.getWidth() - offsetX));
+		srcY1 = static_cast<int>(std::min<int64_t>(srcY1, target.getHeight() - offsetY));
+		if (srcX0 >= srcX1 || srcY0 >= srcY1)
+			return {};
+
+		const Rect written{static_cast<int>(srcX0 + offsetX), static_cast<int>(srcY0 + offsetY), srcX1 - srcX0,
+						   srcY1 - srcY0};
+		const auto width = static_cast<size_t>(written.width);
+		const uint32_t *src = source.getPixels().data() + static_cast<size_t>(srcY0) * source.getPitch() + srcX0;
+		const BlitKernels &kernels = blitKernels();
+		const uint32_t key = source.getColorKey().pixel();
+		for (int row = 0; row < written.height; row++) {
+			uint32_t *dst = target.row(written.y + row) + written.x;
+			switch (mode) {
+				case BlendMode::Copy:
+					std::memcpy(dst, src, width * sizeof(uint32_t));
+					break;
+				case BlendMode::ColorKey:
+					kernels.colorKeyRow(dst, src, width, key);
+					break;
+				case BlendMode::Alpha:
+					kernels.blendRow(dst, src, width);
+					break;
+			}
+			src += source.getPitch();
+		}
+		return written;
+	}
+} // namespace pxe
@@ -0,0 +1,40 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "geometry.h"
+#include "image.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief Draws a region of an image into a view.
+	 *
+	 * The source region is clipped to the image and its destination to the view, once; each row is then
+	 * processed with a block copy or the fastest available `BlitKernels`.
+	 * @param target The destination view.
+	 * @param source The image to read from.
+	 * @param sourceRegion The region of `source` to draw.
+	 * @param x X-coordinate in `target` of the region's top-left corner.
+	 * @param y Y-coordinate in `target` of the region's top-left corner.
+	 * @param mode How source pixels are combined with the destination.
+	 * @return The region of `target` that was written, empty if nothing was.
+	 */
+	Rect blitImage(const SurfaceView &target, const Image &source, const Rect &sourceRegion, int x, int y,
+				   BlendMode mode);
+} // namespace pxe
@@ -0,0 +1,214 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "commandList.h"
+#include <algorithm>
+
+namespace pxe {
+	CommandList::CommandList() = default;
+
+	CommandList::CommandList(const int width, const int height) : cullBounds{0, 0, width, height} {}
+
+	bool CommandList::isVisible(const int64_t x0, const int64_t y0, const int64_t x1, const int64_t y1) const {
+		if (x0 >= x1 || y0 >= y1)
+			return false;
+		if (cullBounds.isEmpty())
+			return true;
+		return x0 < cullBounds.right() && x1 > cullBounds.x && y0 < cullBounds.bottom() && y1 > cullBounds.y;
+	}
+
+	void CommandList::drawPixel(const int x, const int y, const Color color) {
+		// Fast path for plotting loops: the pixel continues a visible span, so only the right edge can cull it.
+		if (!commands.empty()) {
+			Command &last = commands.back();
+			int *v = last.values;
+			if (last.type == CommandType::Span && v[1] == y && v[0] + v[2] == x &&
+				(cullBounds.isEmpty() || x < cullBounds.right())) {
+				v[2]++;
+				spanPixels.push_back(color.pixel());
+				return;
+			}
+		}
+		drawSpan(x, y, {&color, 1});
+	}
+
+	void CommandList::drawSpan(int x, const int y, std::span<const Color> colors) {
+		int64_t end = static_cast<int64_t>(x) + static_cast<int64_t>(colors.size());
+		if (!isVisible(x, y, end, static_cast<int64_t>(y) + 1))
+			return;
+		if (!cullBounds.isEmpty()) {
+			// Only the visible part of the span is stored.
+			const int64_t first = std::max<int64_t>(x, cullBounds.x);
+			end = std::min<int64_t>(end, cullBounds.right());
+			colors = colors.subspan(static_cast<size_t>(first - x), static_cast<size_t>(end - first));
+			x = static_cast<int>(first);
+		}
+		if (!commands.empty()) {
+			Command &last = commands.back();
+			if (last.type == CommandType::Span && last.values[1] == y && last.values[0] + last.values[2] == x) {
+				last.values[2] += static_cast<int>(colors.size());
+				for (const Color color: colors) {
+					spanPixels.push_back(color.pixel());
+				}
+				return;
+			}
+		}
+		commands.push_back({CommandType::Span, 0,
+							{x, y, static_cast<int>(colors.size()), static_cast<int>(spanPixels.size())}});
+		for (const Color color: colors) {
+			spanPixels.push_back(color.pixel());
+		}
+	}
+
+	void CommandList::fillRect(const Rect &region, const Color color) {
+		if (!isVisible(region.x, region.y, static_cast<int64_t>(region.x) + region.width,
+					   static_cast<int64_t>(region.y) + region.height))
+			return;
+		const uint32_t pixel = color.pixel();
+		if (!commands.empty()) {
+			Command &last = commands.back();
+			int *v = last.values;
+			if (last.type == CommandType::FillRect && last.pixel == pixel) {
+				if (v[1] == region.y && v[3] == region.height && v[0] + v[2] == region.x) {
+					v[2] += region.width;
+					return;
+				}
+				if (v[0] == region.x && v[2] == region.width && v[1] + v[3] == region.y) {
+					v[3] += region.height;
+					return;
+				}
+			}
+		}
+		commands.push_back({CommandType::FillRect, pixel, {region.x, region.y, region.width, region.height}});
+	}
+
+	void CommandList::drawRect(const Rect &region, const Color color) {
+		if (region.isEmpty())
+			return;
+		if (region.width <= 2 || region.height <= 2) {
+			fillRect(region, color);
+			return;
+		}
+		fillRect({region.x, region.y, region.width, 1}, color);
+		fillRect({region.x, region.bottom() - 1, region.width, 1}, color);
+		fillRect({region.x, region.y + 1, 1, region.height - 2}, color);
+		fillRect({region.right() - 1, region.y + 1, 1, region.height - 2}, color);
+	}
+
+	void CommandList::drawLine(const Line &line, const Color color) {
+		if (!isVisible(std::min(line.x0, line.x1), std::min(line.y0, line.y1),
+					   static_cast<int64_t>(std::max(line.x0, line.x1)) + 1,
+					   static_cast<int64_t>(std::max(line.y0, line.y1)) + 1))
+			return;
+		commands.push_back({CommandType::Line, color.pixel(), {line.x0, line.y0, line.x1, line.y1}});
+	}
+
+	void CommandList::drawLines(const std::span<const Line> lines, const Color color) {
+		for (const Line &line: lines) {
+			drawLine(line, color);
+		}
+	}
+
+	void CommandList::drawCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		addCircle(CommandType::Circle, centerX, centerY, radius, color);
+	}
+
+	void CommandList::fillCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		addCircle(CommandType::FilledCircle, centerX, centerY, radius, color);
+	}
+
+	void CommandList::addCircle(const CommandType type, const int centerX, const int centerY, const int radius,
+								const Color color) {
+		if (radius < 0 || !isVisible(static_cast<int64_t>(centerX) - radius, static_cast<int64_t>(centerY) - radius,
+									 static_cast<int64_t>(centerX) + radius + 1,
+									 static_cast<int64_t>(centerY) + radius + 1))
+			return;
+		commands.push_back({type, color.pixel(), {centerX, centerY, radius}});
+	}
+
+	void CommandList::drawTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+								   const Color color) {
+		const Line edges[] = {{x0, y0, x1, y1}, {x1, y1, x2, y2}, {x2, y2, x0, y0}};
+		drawLines(edges, color);
+	}
+
+	void CommandList::fillTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+								   const Color color) {
+		// Zero-area triangles cover nothing, and the maximum coordinates are never covered.
+		const int64_t area = (static_cast<int64_t>(x1) - x0) * (static_cast<int64_t>(y2) - y0) -
+							 (static_cast<int64_t>(y1) - y0) * (static_cast<int64_t>(x2) - x0);
+		if (area == 0 || !isVisible(std::min({x0, x1, x2}), std::min({y0, y1, y2}), std::max({x0, x1, x2}),
+									std::max({y0, y1, y2})))
+			return;
+		commands.push_back({CommandType::Triangle, color.pixel(), {x0, y0, x1, y1, x2, y2}});
+	}
+
+	void CommandList::append(const CommandList &other) {
+		const auto base = static_cast<int>(spanPixels.size());
+		for (Command command: other.commands) {
+			if (command.type == CommandType::Span) {
+				command.values[3] += base;
+			}
+			commands.push_back(command);
+		}
+		spanPixels.insert(spanPixels.end(), other.spanPixels.begin(), other.spanPixels.end());
+	}
+
+	bool CommandList::update(const uint64_t key, const std::function<void(CommandList &list)> &recorder) {
+		if (recordedKey == key)
+			return false;
+		clear();
+		recorder(*this);
+		recordedKey = key;
+		return true;
+	}
+
+	void CommandList::clear() {
+		commands.clear();
+		spanPixels.clear();
+		recordedKey.reset();
+	}
+
+	bool CommandList::isEmpty() const { return commands.empty(); }
+
+	size_t CommandList::getCommandCount() const { return commands.size(); }
+
+	uint64_t CommandList::getHash() const {
+		// FNV-1a over 32-bit words, field by field so that padding never enters the hash.
+		uint64_t hash = 0xCBF29CE484222325ull;
+		auto mix = [&hash](const uint32_t word) {
+			hash ^= word;
+			hash *= 0x100000001B3ull;
+		};
+		for (const Command &command: commands) {
+			mix(static_cast<uint32_t>(command.type));
+			mix(command.pixel);
+			for (const int value: command.values) {
+				mix(static_cast<uint32_t>(value));
+			}
+		}
+		for (const uint32_t pixel: spanPixels) {
+			mix(pixel);
+		}
+		return hash;
+	}
+
+	std::span<const CommandList::Command> CommandList::getCommands() const { return commands; }
+
+	std::span<const uint32_t> CommandList::getSpanPixels() const { return spanPixels; }
+} // namespace pxe
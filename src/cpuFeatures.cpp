@@ -0,0 +1,69 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpuFeatures.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PXE_CPU_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+namespace pxe {
+	namespace {
+#if PXE_CPU_X86 && defined(_MSC_VER) && !defined(__clang__)
+		// Checks CPUID leaf 7 EBX for `featureBit` and XCR0 for every state component in `osStateMask`.
+		bool detect(const int featureBit, const unsigned long long osStateMask) {
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+			__cpuid(info, 1);
+			const bool osSavesState = (info[2] & (1 << 27)) && (_xgetbv(0) & osStateMask) == osStateMask;
+			__cpuidex(info, 7, 0);
+			return osSavesState && (info[1] & (1 << featureBit));
+		}
+#endif
+	} // namespace
+
+	bool cpuSupportsAvx2() {
+#if PXE_CPU_X86 && defined(_MSC_VER) && !defined(__clang__)
+		// XMM and YMM state.
+		static const bool supported = detect(5, 0x6);
+#elif PXE_CPU_X86
+		static const bool supported = __builtin_cpu_supports("avx2");
+#else
+		constexpr bool supported = false;
+#endif
+		return supported;
+	}
+
+	bool cpuSupportsAvx512() {
+#if PXE_CPU_X86 && defined(_MSC_VER) && !defined(__clang__)
+		// XMM, YMM, opmask and both halves of the ZMM state.
+		static const bool supported = detect(16, 0xE6);
+#elif PXE_CPU_X86
+		static const bool supported = __builtin_cpu_supports("avx512f");
+#else
+		constexpr bool supported = false;
+#endif
+		return supported;
+	}
+} // namespace pxe
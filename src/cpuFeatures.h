@@ -0,0 +1,36 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace pxe {
+	/**
+	 * @brief Checks whether the running CPU and operating system support AVX2.
+	 *
+	 * The result is detected once and cached. Always false on non-x86 targets.
+	 */
+	[[nodiscard]] bool cpuSupportsAvx2();
+
+	/**
+	 * @brief Checks whether the running CPU and operating system support AVX-512F.
+	 *
+	 * Besides the CPU flag, the operating system must save the ZMM registers on context switches.
+	 * Always false on non-x86 targets.
+	 */
+	[[nodiscard]] bool cpuSupportsAvx512();
+} // namespace pxe
@@ -17,82 +17,772 @@
  */
 
 #include "engine.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include "assetLoader.h"
+#include "binnedRasterizer.h"
+#include "frameCapture.h"
+#include "frameLimiter.h"
+#include "frameProfiler.h"
 #include "graphics.h"
 #include "input.h"
+#ifdef PXE_HEADLESS_EGL
+#include "offscreenContext.h"
+#endif
+#include "resolutionScaler.h"
+#include "textCache.h"
+#include "threadPool.h"
+#include "vblankPredictor.h"
+#include "viewport.h"
 #include "window.h"
 
 namespace pxe {
+#ifndef PXE_HEADLESS_EGL
+	// Never created without EGL, but Engine's destructor still needs a complete type.
+	class OffscreenContext {};
+#endif
+
 	Engine::Engine(int width, int height, const std::string &title, const int pixelSize) {
 		this->pixelSize = pixelSize;
 		window = std::make_unique<Window>(width * pixelSize, height * pixelSize, title);
-		graphics = std::make_unique<Graphics>(width, height);
+		graphics = std::make_unique<Graphics>(width, height, GraphicsTarget::Window,
+											  reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
 		input = std::make_unique<Input>(&*window);
+		initRuntime();
+	}
+
+	Engine::Engine(const int width, const int height, const HeadlessBackend backend) {
+		pixelSize = 1;
+		if (backend == HeadlessBackend::Offscreen) {
+#ifdef PXE_HEADLESS_EGL
+			offscreenContext = std::make_unique<OffscreenContext>();
+			graphics = std::make_unique<Graphics>(width, height, GraphicsTarget::Framebuffer,
+												  OffscreenContext::getLoader());
+#else
+			throw std::runtime_error("Offscreen rendering requires a build with PXE_HEADLESS_EGL");
+#endif
+		} else {
+			graphics = std::make_unique<Graphics>(width, height, GraphicsTarget::None, nullptr);
+		}
+		initRuntime();
 	}
 
 	Engine::~Engine() = default;
 
-	void Engine::run() {
+	void Engine::initRuntime() {
+		frameLimiter = std::make_unique<FrameLimiter>();
+		vblankPredictor = std::make_unique<VblankPredictor>();
+		resolutionScaler = std::make_unique<ResolutionScaler>();
+		fullWidth = graphics->getWidth();
+		fullHeight = graphics->getHeight();
+		updateDisplay();
+		profiler = std::make_unique<FrameProfiler>();
+		graphics->setProfiler(&*profiler);
+	}
+
+	void Engine::run() { run(-1); }
+
+	void Engine::run(const int frameCount) {
+		frameLimit = frameCount;
+		onSetup();
+		if (threadingMode == ThreadingMode::RenderThread) {
+			runWithRenderThread();
+		} else {
+			runSingleThreaded();
+		}
+		onDestroy();
+	}
+
+	void Engine::runSingleThreaded() {
 		using clock = std::chrono::steady_clock;
 		auto previousTime = clock::now();
 
-		onSetup();
-		while (!window->shouldClose()) {
+		for (int frame = 0; keepRunning(frame); frame++) {
+			ProfileScope frameScope(*profiler, FramePhase::Frame);
+			const bool lateInput = window && lowLatency.load(std::memory_order_relaxed);
+			if (lateInput) {
+				const FramePacing pacing = framePacing.load(std::memory_order_relaxed);
+				if (pacing == FramePacing::VSync || pacing == FramePacing::AdaptiveVSync) {
+					vblankPredictor->wait();
+				}
+				pollEvents();
+			}
+
 			auto currentTime = clock::now();
 			const float deltaTime = std::chrono::duration<float>(currentTime - previousTime).count();
 			previousTime = currentTime;
 
-			graphics->beginFrame();
-			onUpdate(deltaTime); // Pass computed deltaTime here.
-			graphics->endFrame();
+			{
+				ProfileScope scope(*profiler, FramePhase::BeginFrame);
+				graphics->beginFrame();
+			}
+			{
+				ProfileScope scope(*profiler, FramePhase::Update);
+				simulate(deltaTime); // Pass computed deltaTime here.
+			}
+			drawProfilerOverlay();
+			deliverFrame(frame);
+			{
+				ProfileScope scope(*profiler, FramePhase::EndFrame);
+				updateDisplay();
+				graphics->endFrame();
+				if (capture) {
+					graphics->captureFrame(*capture);
+				}
+			}
+			const auto frameCost = clock::now() - currentTime;
+			if (lateInput) {
+				vblankPredictor->recordFrameCost(frameCost);
+			}
+			updateRenderScale(frameCost);
+			swapBuffers();
+			recordInputLatency();
+			paceFrame();
+			if (!lateInput) {
+				pollEvents();
+			}
+		}
+	}
+
+	void Engine::runWithRenderThread() {
+		graphics->setTripleBuffering(true);
+		std::atomic<bool> running{true};
+		std::atomic<uint32_t> presentedFrames{0}; ///< Frames picked up by this thread, bumped once more to stop.
+		std::exception_ptr simulationError;
+
+		// The simulation thread only touches CPU surfaces; every GL call stays on this thread.
+		std::thread simulation([&] {
+			using clock = std::chrono::steady_clock;
+			auto previousTime = clock::now();
+			uint32_t publishedFrames = 0;
+			try {
+				for (int frame = 0; running.load(std::memory_order_acquire); frame++) {
+					if (!keepRunning(frame)) {
+						running.store(false, std::memory_order_release);
+						break;
+					}
+					// Start a frame only once the previous one was picked up: the presenting thread's pacing
+					// then paces this one too, instead of frames being rendered only to be overwritten.
+					for (uint32_t seen = presentedFrames.load(std::memory_order_acquire);
+						 seen < publishedFrames && running.load(std::memory_order_acquire);
+						 seen = presentedFrames.load(std::memory_order_acquire)) {
+						presentedFrames.wait(seen, std::memory_order_acquire);
+					}
+					if (!running.load(std::memory_order_acquire))
+						break;
+					auto currentTime = clock::now();
+					const float deltaTime = std::chrono::duration<float>(currentTime - previousTime).count();
+					previousTime = currentTime;
+
+					{
+						ProfileScope scope(*profiler, FramePhase::BeginFrame);
+						graphics->beginFrame();
+					}
+					{
+						ProfileScope scope(*profiler, FramePhase::Update);
+						simulate(deltaTime);
+					}
+					drawProfilerOverlay();
+					deliverFrame(frame);
+					graphics->publishFrame();
+					publishedFrames++;
+				}
+			} catch (...) {
+				simulationError = std::current_exception();
+				running.store(false, std::memory_order_release);
+			}
+		});
+
+		auto stopSimulation = [&] {
+			running.store(false, std::memory_order_release);
+			presentedFrames.fetch_add(1, std::memory_order_release);
+			presentedFrames.notify_one();
+			simulation.join();
+		};
+		try {
+			while (running.load(std::memory_order_acquire) && keepRunning(0)) {
+				// Frame, EndFrame, SwapBuffers and PollEvents are timed here; the simulation thread times the rest.
+				ProfileScope frameScope(*profiler, FramePhase::Frame);
+				{
+					ProfileScope scope(*profiler, FramePhase::EndFrame);
+					updateDisplay();
+					if (graphics->presentFrame()) {
+						presentedFrames.fetch_add(1, std::memory_order_release);
+						presentedFrames.notify_one();
+						if (capture) {
+							graphics->captureFrame(*capture);
+						}
+					}
+				}
+				swapBuffers();
+				paceFrame();
+				pollEvents();
+			}
+		} catch (...) {
+			stopSimulation();
+			graphics->setTripleBuffering(false);
+			throw;
+		}
+		stopSimulation();
+		// Record the last frame published after the final present, e.g. the end of run(frameCount).
+		if (capture && !simulationError && graphics->presentFrame()) {
+			graphics->captureFrame(*capture);
+		}
+		graphics->setTripleBuffering(false);
+		if (simulationError) {
+			std::rethrow_exception(simulationError);
+		}
+	}
+
+	bool Engine::keepRunning(const int frameIndex) const {
+		return (frameLimit < 0 || frameIndex < frameLimit) && (!window || !window->shouldClose());
+	}
+
+	void Engine::deliverFrame(const int frameIndex) {
+		if (frameCallback) {
+			frameCallback(frameIndex, graphics->getFrameView());
+		}
+	}
+
+	void Engine::swapBuffers() {
+		ProfileScope scope(*profiler, FramePhase::SwapBuffers);
+		if (window) {
 			window->swapBuffers();
-			window->pollEvents();
+			vblankPredictor->recordSwap(std::chrono::steady_clock::now());
 		}
-		onDestroy();
 	}
 
+	void Engine::pollEvents() {
+		ProfileScope scope(*profiler, FramePhase::PollEvents);
+		if (!window)
+			return;
+
+		if (inputModeChanged.exchange(false, std::memory_order_acquire)) {
+			const bool lowLatencyMode = lowLatency.load(std::memory_order_relaxed);
+			window->setRawMouseMotion(lowLatencyMode);
+			window->setCursorCaptured(mouseCaptured.load(std::memory_order_relaxed));
+			vblankPredictor->setRefreshRate(lowLatencyMode ? window->getRefreshRate() : 0.0);
+		}
+		const auto now = std::chrono::steady_clock::now();
+		if (lowLatency.load(std::memory_order_relaxed) && now - refreshRateQueried >= std::chrono::seconds(1)) {
+			// The window may have moved to a monitor with another refresh rate.
+			refreshRateQueried = now;
+			vblankPredictor->setRefreshRate(window->getRefreshRate());
+		}
+		window->pollEvents();
+	}
+
+	void Engine::recordInputLatency() {
+		if (!input || !profiler->isEnabled())
+			return;
+
+		const std::span<const InputEvent> events = input->getEvents();
+		if (!events.empty()) {
+			const auto latency = std::chrono::steady_clock::now() - events.front().time;
+			profiler->record(FramePhase::InputLatency, std::chrono::duration<double, std::milli>(latency).count());
+		}
+	}
+
+	void Engine::updateDisplay() {
+		if (window) {
+			graphics->setOutputSize(window->getFramebufferWidth(), window->getFramebufferHeight());
+		}
+		graphics->setScalingFilter(scalingFilter.load(std::memory_order_relaxed));
+	}
+
+	void Engine::updateRenderScale(const std::chrono::steady_clock::duration frameCost) {
+		if (dynamicResolution && !capture) {
+			resolutionScaler->record(std::chrono::duration<double, std::milli>(frameCost).count());
+		}
+		const double scale = dynamicResolution ? resolutionScaler->getScale() : 1.0;
+		const int width = std::max(1, static_cast<int>(std::lround(fullWidth * scale)));
+		const int height = std::max(1, static_cast<int>(std::lround(fullHeight * scale)));
+		if (width != graphics->getWidth() || height != graphics->getHeight()) {
+			graphics->resize(width, height);
+			if (binnedRendering) {
+				// The cull rectangle follows the surface, or draws into the part it grew by would be dropped.
+				frameCommands = CommandList(width, height);
+			}
+		}
+	}
+
+	void Engine::simulate(const float deltaTime) {
+		if (input) {
+			input->update();
+		}
+		if (fixedStep > 0.0) {
+			fixedAccumulator += deltaTime;
+			int steps = 0;
+			while (fixedAccumulator >= fixedStep && steps < maxFixedSteps) {
+				onFixedUpdate(static_cast<float>(fixedStep));
+				fixedAccumulator -= fixedStep;
+				steps++;
+			}
+			// Spiral-of-death clamp: drop whatever backlog the step budget could not absorb.
+			if (fixedAccumulator >= fixedStep) {
+				fixedAccumulator = std::fmod(fixedAccumulator, fixedStep);
+			}
+			interpolationAlpha = static_cast<float>(fixedAccumulator / fixedStep);
+		}
+		onUpdate(deltaTime);
+		executeBinnedDraws();
+		if (textCache) {
+			textCache->trim();
+		}
+	}
+
+	void Engine::paceFrame() {
+		if (framePacingChanged.exchange(false, std::memory_order_acquire)) {
+			const FramePacing pacing = framePacing.load(std::memory_order_relaxed);
+			// Without a window there is no swap to synchronize; only the frame limiter applies.
+			switch (window ? pacing : FramePacing::TargetFps) {
+				case FramePacing::VSync:
+					window->setSwapInterval(1);
+					break;
+				case FramePacing::AdaptiveVSync:
+					window->setSwapInterval(window->supportsAdaptiveVSync() ? -1 : 1);
+					break;
+				case FramePacing::Uncapped:
+					window->setSwapInterval(0);
+					break;
+				case FramePacing::TargetFps:
+					if (window) {
+						window->setSwapInterval(0);
+					}
+					break;
+			}
+			frameLimiter->setTargetFps(pacing == FramePacing::TargetFps ? targetFps.load(std::memory_order_relaxed)
+																		  : 0.0);
+		}
+		frameLimiter->wait();
+	}
+
+	void Engine::drawProfilerOverlay() {
+		if (!profilerOverlay.load(std::memory_order_relaxed) || !profiler->isEnabled())
+			return;
+
+		static constexpr FramePhase stackedPhases[] = {FramePhase::BeginFrame, FramePhase::Update, FramePhase::EndFrame,
+														FramePhase::SwapBuffers, FramePhase::PollEvents};
+		static constexpr uint32_t phaseColors[] = {Color::Blue.pixel(), Color::Green.pixel(), Color::Yellow.pixel(),
+												   Color::Magenta.pixel(), Color::Cyan.pixel()};
+		static constexpr int graphHeight = 64;
+		static constexpr double pixelsPerMillisecond = 2.0; // The graph covers 32 ms.
+		static constexpr uint32_t background = Color(16, 16, 16).pixel();
+		static constexpr uint32_t budgetLine = Color(255, 64, 64).pixel();
+
+		const int width = std::min(static_cast<int>(FrameProfiler::historySize), getWidth());
+		const int height = std::min(graphHeight, getHeight());
+		SurfaceView view = lockRows({0, getHeight() - height, width, height});
+		if (view.isEmpty())
+			return;
+
+		// One column per frame, newest on the right.
+		std::array<std::array<double, FrameProfiler::historySize>, std::size(stackedPhases)> samples;
+		for (size_t phase = 0; phase < std::size(stackedPhases); phase++) {
+			profiler->copyRecent(stackedPhases[phase], std::span(samples[phase]).first(width));
+		}
+		const int budgetRow = height - 1 - static_cast<int>(1000.0 / 60.0 * pixelsPerMillisecond + 0.5);
+
+		for (int y = 0; y < height; y++) {
+			std::fill_n(view.row(y), width, background);
+		}
+		for (int x = 0; x < width; x++) {
+			double total = 0.0;
+			int top = height;
+			for (size_t phase = 0; phase < std::size(stackedPhases) && top > 0; phase++) {
+				total += samples[phase][x];
+				const int end = std::max(height - static_cast<int>(total * pixelsPerMillisecond + 0.5), 0);
+				for (int y = end; y < top; y++) {
+					view.row(y)[x] = phaseColors[phase];
+				}
+				top = std::min(top, end);
+			}
+		}
+		if (budgetRow >= 0) {
+			std::fill_n(view.row(budgetRow), width, budgetLine);
+		}
+
+		// The newest frame time, in the top-left corner of the graph.
+		double frameTime = 0.0;
+		profiler->copyRecent(FramePhase::Frame, std::span(&frameTime, 1));
+		char label[32];
+		std::snprintf(label, sizeof(label), "%.2f ms", frameTime);
+		drawText(2, getHeight() - height + 2, label, Color::White);
+	}
+
+	void Engine::onFixedUpdate(float) {}
+
 	void Engine::onDestroy() { std::cout << "Cleaning up resources..." << std::endl; }
 
-	bool Engine::isKeyPressed(KeyCode key) const { return input->isKeyPressed(static_cast<int>(key)); }
+	bool Engine::isKeyPressed(KeyCode key) const { return input && input->isKeyPressed(static_cast<int>(key)); }
 
-	bool Engine::isMousePressed(MouseButton button) const { return input->isMousePressed(static_cast<int>(button)); }
+	bool Engine::isMousePressed(MouseButton button) const {
+		return input && input->isMousePressed(static_cast<int>(button));
+	}
 
-	std::pair<double, double> Engine::getMousePosition() const { return input->getMousePosition(); }
+	std::pair<double, double> Engine::getMousePosition() const {
+		return input ? input->getMousePosition() : std::pair{0.0, 0.0};
+	}
+
+	bool Engine::wasKeyPressed(KeyCode key) const { return input && input->wasKeyPressed(static_cast<int>(key)); }
+
+	bool Engine::wasKeyReleased(KeyCode key) const { return input && input->wasKeyReleased(static_cast<int>(key)); }
+
+	bool Engine::wasMousePressed(MouseButton button) const {
+		return input && input->wasMousePressed(static_cast<int>(button));
+	}
+
+	bool Engine::wasMouseReleased(MouseButton button) const {
+		return input && input->wasMouseReleased(static_cast<int>(button));
+	}
+
+	std::span<const InputEvent> Engine::getInputEvents() const {
+		return input ? input->getEvents() : std::span<const InputEvent>();
+	}
 
 	void Engine::drawPixel(const int x, const int y, const int r, const int g, const int b) {
+		if (binnedRendering) {
+			frameCommands.drawPixel(x, y, Color(r, g, b));
+			return;
+		}
 		graphics->setPixel(x, y, r, g, b);
 	}
 
-	void Engine::drawPixel(const int x, const int y, const Color color) { graphics->setPixel(x, y, color.r(), color.g(), color.b()); }
+	void Engine::drawPixel(const int x, const int y, const Color color) {
+		drawPixel(x, y, color.r(), color.g(), color.b());
+	}
 
 	void Engine::drawLine(const int x1, const int y1, const int x2, const int y2, const int r, const int g, const int b) {
-		int x = x1, y = y1;
-		int dx = std::abs(x2 - x), dy = std::abs(y2 - y);
-		int sx = (x < x2) ? 1 : -1, sy = (y < y2) ? 1 : -1;
-		int err = dx - dy;
-
-		while (true) {
-			drawPixel(x, y, r, g, b);
-			if (x == x2 && y == y2)
-				break;
-			int e2 = 2 * err;
-			if (e2 > -dy) {
-				err -= dy;
-				x += sx;
-			}
-			if (e2 < dx) {
-				err += dx;
-				y += sy;
-			}
+		drawLine(x1, y1, x2, y2, Color(r, g, b));
+	}
+
+	void Engine::drawLine(const int x1, const int y1, const int x2, const int y2, const Color color) {
+		if (binnedRendering) {
+			frameCommands.drawLine({x1, y1, x2, y2}, color);
+			return;
+		}
+		graphics->drawLine({x1, y1, x2, y2}, color);
+	}
+
+	void Engine::drawLines(const std::span<const Line> lines, const Color color) {
+		if (binnedRendering) {
+			frameCommands.drawLines(lines, color);
+			return;
+		}
+		graphics->drawLines(lines, color);
+	}
+
+	void Engine::drawSpan(const int x, const int y, const std::span<const Color> colors) {
+		if (binnedRendering) {
+			frameCommands.drawSpan(x, y, colors);
+			return;
+		}
+		graphics->drawSpan(x, y, colors);
+	}
+
+	void Engine::fillRect(const int x, const int y, const int width, const int height, const Color color) {
+		if (binnedRendering) {
+			frameCommands.fillRect({x, y, width, height}, color);
+			return;
+		}
+		graphics->fillRect({x, y, width, height}, color);
+	}
+
+	void Engine::drawRect(const int x, const int y, const int width, const int height, const Color color) {
+		if (binnedRendering) {
+			frameCommands.drawRect({x, y, width, height}, color);
+			return;
+		}
+		graphics->drawRect({x, y, width, height}, color);
+	}
+
+	void Engine::drawCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		if (binnedRendering) {
+			frameCommands.drawCircle(centerX, centerY, radius, color);
+			return;
+		}
+		graphics->drawCircle(centerX, centerY, radius, color);
+	}
+
+	void Engine::fillCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		if (binnedRendering) {
+			frameCommands.fillCircle(centerX, centerY, radius, color);
+			return;
+		}
+		graphics->fillCircle(centerX, centerY, radius, color);
+	}
+
+	void Engine::drawTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+							  const Color color) {
+		if (binnedRendering) {
+			frameCommands.drawTriangle(x0, y0, x1, y1, x2, y2, color);
+			return;
+		}
+		graphics->drawTriangle(x0, y0, x1, y1, x2, y2, color);
+	}
+
+	void Engine::fillTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+							  const Color color) {
+		if (binnedRendering) {
+			frameCommands.fillTriangle(x0, y0, x1, y1, x2, y2, color);
+			return;
+		}
+		graphics->fillTriangle(x0, y0, x1, y1, x2, y2, color);
+	}
+
+	void Engine::blit(const Image &image, const int x, const int y, const BlendMode mode) {
+		blit(image, image.getBounds(), x, y, mode);
+	}
+
+	void Engine::blit(const Image &image, const Rect &sourceRegion, const int x, const int y, const BlendMode mode) {
+		executeBinnedDraws();
+		graphics->blit(image, sourceRegion, x, y, mode);
+	}
+
+	void Engine::drawText(const int x, const int y, const std::string_view text, const Color color,
+						  const BitmapFont &font) {
+		if (text.empty() || color.a() == 0)
+			return;
+		if (!textCache) {
+			textCache = std::make_unique<TextCache>();
+		}
+		blit(textCache->get(text, font, color), x, y, color.a() == 255 ? BlendMode::ColorKey : BlendMode::Alpha);
+	}
+
+	SpriteId Engine::addSprite(const Image &image) { return graphics->addSprite(image); }
+
+	void Engine::drawSprite(const SpriteId sprite, const float x, const float y) {
+		graphics->drawSprite(sprite, {.x = x, .y = y});
+	}
+
+	void Engine::drawSprite(const SpriteId sprite, const SpriteTransform &transform) {
+		graphics->drawSprite(sprite, transform);
+	}
+
+	SurfaceView Engine::lockRows() { return lockRows({0, 0, getWidth(), getHeight()}); }
+
+	SurfaceView Engine::lockRows(const Rect &region) {
+		executeBinnedDraws();
+		return graphics->lockRows(region);
+	}
+
+	void Engine::parallelFor(const int count, const std::function<void(int index)> &body) {
+		if (count <= 0)
+			return;
+		getThreadPool().parallelFor(static_cast<size_t>(count),
+									[&](const size_t index) { body(static_cast<int>(index)); });
+	}
+
+	void Engine::renderTiles(const std::function<void(const Rect &tile, SurfaceView &view)> &kernel,
+							 const int tileSize) {
+		if (tileSize <= 0) {
+			throw std::invalid_argument("Tile size must be positive");
+		}
+		// Lock (and mark dirty) the whole surface once, on this thread; tiles are then carved out of it.
+		const SurfaceView surfaceView = lockRows();
+		const int columns = (surfaceView.getWidth() + tileSize - 1) / tileSize;
+		const int rows = (surfaceView.getHeight() + tileSize - 1) / tileSize;
+
+		parallelFor(columns * rows, [&](const int index) {
+			const Rect requested{(index % columns) * tileSize, (index / columns) * tileSize, tileSize, tileSize};
+			SurfaceView tileView = surfaceView.subView(requested);
+			const Rect tile{requested.x, requested.y, tileView.getWidth(), tileView.getHeight()};
+			kernel(tile, tileView);
+		});
+	}
+
+	std::future<Image> Engine::loadImageAsync(const std::string &path) {
+		if (!assetLoader) {
+			assetLoader = std::make_unique<AssetLoader>(std::thread::hardware_concurrency());
+		}
+		return assetLoader->load(path);
+	}
+
+	ThreadPool &Engine::getThreadPool() {
+		if (!threadPool) {
+			threadPool = std::make_unique<ThreadPool>();
+		}
+		return *threadPool;
+	}
+
+	FrameArena &Engine::getFrameArena() { return graphics->getFrameArena(); }
+
+	SurfacePool &Engine::getSurfacePool() { return graphics->getSurfacePool(); }
+
+	void Engine::setIndexedMode(const bool enabled) { graphics->setIndexedMode(enabled); }
+
+	IndexedSurface &Engine::lockIndexedSurface() { return graphics->lockIndexedSurface(); }
+
+	void Engine::setPalette(const std::span<const Color> colors, const int first) {
+		graphics->setPalette(first, colors);
+	}
+
+	void Engine::setPixelShader(const std::string &source) { graphics->setPixelShader(source); }
+
+	void Engine::setShaderUniform(const std::string &name, const std::initializer_list<float> values) {
+		graphics->setShaderUniform(name, std::span(values.begin(), values.size()));
+	}
+
+	int Engine::addLayer(const bool retained) { return graphics->addLayer(retained); }
+
+	void Engine::setDrawLayer(const int layer) {
+		executeBinnedDraws();
+		graphics->setDrawLayer(layer);
+	}
+
+	void Engine::removeLayers() {
+		executeBinnedDraws();
+		graphics->removeLayers();
+	}
+
+	void Engine::setLayerCompositing(const LayerCompositing compositing) {
+		graphics->setLayerCompositing(compositing);
+	}
+
+	void Engine::clear() {
+		// Whatever was recorded would be cleared anyway.
+		frameCommands.clear();
+		graphics->clear();
+	}
+
+	void Engine::setBinnedRendering(const bool enabled) {
+		if (enabled && !binnedRendering) {
+			frameCommands = CommandList(getWidth(), getHeight());
+		} else if (!enabled) {
+			executeBinnedDraws();
+		}
+		binnedRendering = enabled;
+	}
+
+	void Engine::submit(const CommandList &commands) {
+		if (binnedRendering) {
+			frameCommands.append(commands);
+		} else {
+			execute(commands);
+		}
+	}
+
+	void Engine::executeBinnedDraws() {
+		if (frameCommands.isEmpty())
+			return;
+		execute(frameCommands);
+		frameCommands.clear();
+	}
+
+	void Engine::execute(const CommandList &commands) {
+		if (commands.isEmpty())
+			return;
+		if (!binnedRasterizer) {
+			binnedRasterizer = std::make_unique<BinnedRasterizer>();
+		}
+		auto parallel = [this](const int count, const std::function<void(int)> &body) { parallelFor(count, body); };
+		binnedRasterizer->execute(commands, graphics->getSurface(), parallel);
+	}
+
+	void Engine::setRetainedMode(const bool retained) { graphics->setRetainedMode(retained); }
+
+	void Engine::setFramePacing(const FramePacing pacing, const double targetFps) {
+		framePacing.store(pacing, std::memory_order_relaxed);
+		this->targetFps.store(targetFps, std::memory_order_relaxed);
+		framePacingChanged.store(true, std::memory_order_release);
+	}
+
+	void Engine::setFixedTimestep(const double stepsPerSecond, const int maxStepsPerFrame) {
+		fixedStep = stepsPerSecond > 0.0 ? 1.0 / stepsPerSecond : 0.0;
+		maxFixedSteps = std::max(maxStepsPerFrame, 1);
+		fixedAccumulator = 0.0;
+		interpolationAlpha = 0.0f;
+	}
+
+	float Engine::getInterpolationAlpha() const { return interpolationAlpha; }
+
+	void Engine::setFrameCallback(std::function<void(int frameIndex, const SurfaceView &frame)> callback) {
+		frameCallback = std::move(callback);
+	}
+
+	void Engine::setLowLatencyMode(const bool enabled) {
+		lowLatency.store(enabled, std::memory_order_relaxed);
+		inputModeChanged.store(true, std::memory_order_release);
+	}
+
+	void Engine::setMouseCaptured(const bool captured) {
+		mouseCaptured.store(captured, std::memory_order_relaxed);
+		inputModeChanged.store(true, std::memory_order_release);
+	}
+
+	std::pair<double, double> Engine::getMouseSurfacePosition() const {
+		if (!window || !input || window->getWidth() <= 0 || window->getHeight() <= 0)
+			return {0.0, 0.0};
+
+		const int outputWidth = window->getFramebufferWidth();
+		const int outputHeight = window->getFramebufferHeight();
+		// Like Graphics::getViewport: fitted to the full size, whatever the current resolution scale.
+		const Rect view = fitViewport(outputWidth, outputHeight, fullWidth, fullHeight,
+									  scalingFilter.load(std::memory_order_relaxed) == ScalingFilter::IntegerNearest);
+		if (view.isEmpty())
+			return {0.0, 0.0};
+
+		// Window coordinates differ from framebuffer pixels on high-DPI displays.
+		const auto [x, y] = input->getMousePosition();
+		const double pixelX = x * outputWidth / window->getWidth();
+		const double pixelY = y * outputHeight / window->getHeight();
+		return {(pixelX - view.x) * getWidth() / view.width, (pixelY - view.y) * getHeight() / view.height};
+	}
+
+	void Engine::setScalingFilter(const ScalingFilter filter) {
+		scalingFilter.store(filter, std::memory_order_relaxed);
+	}
+
+	void Engine::setDynamicResolution(const bool enabled, const double budgetMilliseconds,
+									  const double minimumScale) {
+		dynamicResolution = enabled;
+		resolutionScaler->configure(budgetMilliseconds, minimumScale);
+	}
+
+	void Engine::setThreadingMode(const ThreadingMode mode) { threadingMode = mode; }
+
+	void Engine::setUploadMode(const UploadMode mode) { graphics->setUploadMode(mode); }
+
+	UploadMode Engine::getUploadMode() const { return graphics->getUploadMode(); }
+
+	void Engine::setProfilerEnabled(const bool enabled) { profiler->setEnabled(enabled); }
+
+	void Engine::setProfilerOverlay(const bool visible) { profilerOverlay.store(visible, std::memory_order_relaxed); }
+
+	FrameStats Engine::getFrameStats() const { return profiler->getStats(); }
+
+	void Engine::startCapture(const CaptureSettings &settings) {
+		stopCapture();
+		lastCaptureStats = {};
+		capture = std::make_unique<FrameCapture>(settings, getWidth(), getHeight(), graphics->supportsReadback());
+	}
+
+	void Engine::stopCapture() {
+		if (!capture)
+			return;
+		const std::unique_ptr<FrameCapture> finished = std::move(capture);
+		try {
+			finished->finish();
+		} catch (...) {
+			lastCaptureStats = finished->getStats();
+			throw;
 		}
+		lastCaptureStats = finished->getStats();
 	}
 
-	void Engine::drawLine(const int x1, const int y1, const int x2, const int y2, const Color color) { drawLine(x1, y1, x2, y2, color.r(), color.g(), color.b()); }
+	CaptureStats Engine::getCaptureStats() const { return capture ? capture->getStats() : lastCaptureStats; }
 
-	int Engine::getWindowWidth() const { return window->getWidth(); }
+	int Engine::getWindowWidth() const { return window ? window->getWidth() : getWidth(); }
 
-	int Engine::getWindowHeight() const { return window->getHeight(); }
+	int Engine::getWindowHeight() const { return window ? window->getHeight() : getHeight(); }
 
 	int Engine::getWidth() const { return graphics->getWidth(); }
 
@@ -0,0 +1,318 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fractalKernels.h"
+#include <bit>
+#include <vector>
+#include "cpuFeatures.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PXE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC accepts intrinsics of any instruction set without per-function target attributes.
+#define PXE_TARGET_AVX2
+#define PXE_TARGET_AVX512
+#else
+#define PXE_TARGET_AVX2 __attribute__((target("avx2")))
+#define PXE_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PXE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace pxe {
+	namespace {
+		// Points in the main cardioid or the period-2 bulb never escape; testing is far cheaper than iterating.
+		bool inMainComponents(const double x, const double y) {
+			const double shifted = x - 0.25;
+			const double y2 = y * y;
+			const double q = shifted * shifted + y2;
+			if (q * (q + shifted) <= 0.25 * y2)
+				return true;
+			const double bulb = x + 1.0;
+			return bulb * bulb + y2 <= 0.0625;
+		}
+
+		float escapeScalar(const double cr, const double ci, const int maxIterations) {
+			if (inMainComponents(cr, ci))
+				return fractalInterior;
+			double zr = 0.0, zi = 0.0;
+			int iterations = 0;
+			for (; iterations < maxIterations; iterations++) {
+				const double zr2 = zr * zr;
+				const double zi2 = zi * zi;
+				if (zr2 + zi2 > fractalBailout)
+					break;
+				zi = (zr + zr) * zi + ci;
+				zr = zr2 - zi2 + cr;
+			}
+			const double magnitude = zr * zr + zi * zi;
+			return magnitude > fractalBailout ? smoothEscapeValue(iterations, magnitude) : fractalInterior;
+		}
+
+		void escapeRowScalar(float *values, const size_t count, const double real, const double realStep,
+							 const double imag, const int maxIterations) {
+			for (size_t i = 0; i < count; i++) {
+				values[i] = escapeScalar(real + static_cast<double>(i) * realStep, imag, maxIterations);
+			}
+		}
+
+		/**
+		 * Feeds the points of a row to the lanes of a vector kernel. Instead of iterating a group of points
+		 * until the slowest one is done, a lane is refilled with the next point as soon as its own point
+		 * escapes or reaches the limit, so no lane idles while the others finish.
+		 */
+		template<size_t Lanes>
+		class LaneScheduler {
+		public:
+			alignas(64) double cr[Lanes];
+			alignas(64) double ci[Lanes];
+			alignas(64) double zr[Lanes];
+			alignas(64) double zi[Lanes];
+			alignas(64) double iterations[Lanes];
+
+			LaneScheduler(float *values, const size_t count, const double real, const double realStep,
+						  const double imag, const int maxIterations) :
+				values(values), count(count), real(real), realStep(realStep), imag(imag),
+				maxIterations(maxIterations) {
+				for (size_t lane = 0; lane < Lanes; lane++) {
+					refill(lane);
+				}
+			}
+
+			[[nodiscard]] bool isBusy() const { return busy > 0; }
+
+			/// Stores the results of the lanes set in `mask` and refills them.
+			void retire(unsigned mask) {
+				for (; mask != 0; mask &= mask - 1) {
+					const auto lane = static_cast<size_t>(std::countr_zero(mask));
+					const double magnitude = zr[lane] * zr[lane] + zi[lane] * zi[lane];
+					values[point[lane]] = magnitude > fractalBailout
+												  ? smoothEscapeValue(static_cast<int>(iterations[lane]), magnitude)
+												  : fractalInterior;
+					busy--;
+					refill(lane);
+				}
+			}
+
+		private:
+			float *values;
+			size_t count;
+			double real;
+			double realStep;
+			double imag;
+			int maxIterations;
+			size_t next = 0;
+			size_t point[Lanes] = {};
+			size_t busy = 0;
+
+			void refill(const size_t lane) {
+				zr[lane] = 0.0;
+				zi[lane] = 0.0;
+				for (; next < count; next++) {
+					const double x = real + static_cast<double>(next) * realStep;
+					if (inMainComponents(x, imag)) {
+						values[next] = fractalInterior;
+						continue;
+					}
+					cr[lane] = x;
+					ci[lane] = imag;
+					iterations[lane] = 0.0;
+					point[lane] = next++;
+					busy++;
+					return;
+				}
+				// An idle lane iterates c = 0 from 0 forever: it never escapes, and its count never reaches the limit.
+				cr[lane] = 0.0;
+				ci[lane] = 0.0;
+				iterations[lane] = -static_cast<double>(maxIterations) * 1e9;
+			}
+		};
+
+		constexpr FractalKernels scalarKernels{"scalar", escapeRowScalar};
+
+#if PXE_KERNELS_X86
+		void escapeRowSse2(float *values, const size_t count, const double real, const double realStep,
+						   const double imag, const int maxIterations) {
+			LaneScheduler<2> lanes(values, count, real, realStep, imag, maxIterations);
+			const __m128d bailout = _mm_set1_pd(fractalBailout);
+			const __m128d limit = _mm_set1_pd(maxIterations);
+			const __m128d one = _mm_set1_pd(1.0);
+			__m128d cr = _mm_load_pd(lanes.cr), ci = _mm_load_pd(lanes.ci);
+			__m128d zr = _mm_load_pd(lanes.zr), zi = _mm_load_pd(lanes.zi);
+			__m128d iterations = _mm_load_pd(lanes.iterations);
+			while (lanes.isBusy()) {
+				const __m128d zr2 = _mm_mul_pd(zr, zr);
+				const __m128d zi2 = _mm_mul_pd(zi, zi);
+				const __m128d done =
+						_mm_or_pd(_mm_cmpgt_pd(_mm_add_pd(zr2, zi2), bailout), _mm_cmpge_pd(iterations, limit));
+				if (const int mask = _mm_movemask_pd(done)) {
+					_mm_store_pd(lanes.zr, zr);
+					_mm_store_pd(lanes.zi, zi);
+					_mm_store_pd(lanes.iterations, iterations);
+					lanes.retire(static_cast<unsigned>(mask));
+					cr = _mm_load_pd(lanes.cr);
+					ci = _mm_load_pd(lanes.ci);
+					zr = _mm_load_pd(lanes.zr);
+					zi = _mm_load_pd(lanes.zi);
+					iterations = _mm_load_pd(lanes.iterations);
+					continue;
+				}
+				zi = _mm_add_pd(_mm_mul_pd(_mm_add_pd(zr, zr), zi), ci);
+				zr = _mm_add_pd(_mm_sub_pd(zr2, zi2), cr);
+				iterations = _mm_add_pd(iterations, one);
+			}
+		}
+
+		PXE_TARGET_AVX2 void escapeRowAvx2(float *values, const size_t count, const double real,
+										   const double realStep, const double imag, const int maxIterations) {
+			LaneScheduler<4> lanes(values, count, real, realStep, imag, maxIterations);
+			const __m256d bailout = _mm256_set1_pd(fractalBailout);
+			const __m256d limit = _mm256_set1_pd(maxIterations);
+			const __m256d one = _mm256_set1_pd(1.0);
+			__m256d cr = _mm256_load_pd(lanes.cr), ci = _mm256_load_pd(lanes.ci);
+			__m256d zr = _mm256_load_pd(lanes.zr), zi = _mm256_load_pd(lanes.zi);
+			__m256d iterations = _mm256_load_pd(lanes.iterations);
+			while (lanes.isBusy()) {
+				const __m256d zr2 = _mm256_mul_pd(zr, zr);
+				const __m256d zi2 = _mm256_mul_pd(zi, zi);
+				const __m256d done = _mm256_or_pd(_mm256_cmp_pd(_mm256_add_pd(zr2, zi2), bailout, _CMP_GT_OQ),
+												  _mm256_cmp_pd(iterations, limit, _CMP_GE_OQ));
+				if (const int mask = _mm256_movemask_pd(done)) {
+					_mm256_store_pd(lanes.zr, zr);
+					_mm256_store_pd(lanes.zi, zi);
+					_mm256_store_pd(lanes.iterations, iterations);
+					lanes.retire(static_cast<unsigned>(mask));
+					cr = _mm256_load_pd(lanes.cr);
+					ci = _mm256_load_pd(lanes.ci);
+					zr = _mm256_load_pd(lanes.zr);
+					zi = _mm256_load_pd(lanes.zi);
+					iterations = _mm256_load_pd(lanes.iterations);
+					continue;
+				}
+				zi = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(zr, zr), zi), ci);
+				zr = _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr);
+				iterations = _mm256_add_pd(iterations, one);
+			}
+		}
+
+		PXE_TARGET_AVX512 void escapeRowAvx512(float *values, const size_t count, const double real,
+											   const double realStep, const double imag, const int maxIterations) {
+			LaneScheduler<8> lanes(values, count, real, realStep, imag, maxIterations);
+			const __m512d bailout = _mm512_set1_pd(fractalBailout);
+			const __m512d limit = _mm512_set1_pd(maxIterations);
+			const __m512d one = _mm512_set1_pd(1.0);
+			__m512d cr = _mm512_load_pd(lanes.cr), ci = _mm512_load_pd(lanes.ci);
+			__m512d zr = _mm512_load_pd(lanes.zr), zi = _mm512_load_pd(lanes.zi);
+			__m512d iterations = _mm512_load_pd(lanes.iterations);
+			while (lanes.isBusy()) {
+				const __m512d zr2 = _mm512_mul_pd(zr, zr);
+				const __m512d zi2 = _mm512_mul_pd(zi, zi);
+				const __mmask8 done = _mm512_cmp_pd_mask(_mm512_add_pd(zr2, zi2), bailout, _CMP_GT_OQ) |
+									  _mm512_cmp_pd_mask(iterations, limit, _CMP_GE_OQ);
+				if (done != 0) {
+					_mm512_store_pd(lanes.zr, zr);
+					_mm512_store_pd(lanes.zi, zi);
+					_mm512_store_pd(lanes.iterations, iterations);
+					lanes.retire(done);
+					cr = _mm512_load_pd(lanes.cr);
+					ci = _mm512_load_pd(lanes.ci);
+					zr = _mm512_load_pd(lanes.zr);
+					zi = _mm512_load_pd(lanes.zi);
+					iterations = _mm512_load_pd(lanes.iterations);
+					continue;
+				}
+				zi = _mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(zr, zr), zi), ci);
+				zr = _mm512_add_pd(_mm512_sub_pd(zr2, zi2), cr);
+				iterations = _mm512_add_pd(iterations, one);
+			}
+		}
+
+		constexpr FractalKernels sse2Kernels{"sse2", escapeRowSse2};
+		constexpr FractalKernels avx2Kernels{"avx2", escapeRowAvx2};
+		constexpr FractalKernels avx512Kernels{"avx512", escapeRowAvx512};
+#endif
+
+#if PXE_KERNELS_NEON
+		void escapeRowNeon(float *values, const size_t count, const double real, const double realStep,
+						   const double imag, const int maxIterations) {
+			LaneScheduler<2> lanes(values, count, real, realStep, imag, maxIterations);
+			const float64x2_t bailout = vdupq_n_f64(fractalBailout);
+			const float64x2_t limit = vdupq_n_f64(maxIterations);
+			const float64x2_t one = vdupq_n_f64(1.0);
+			float64x2_t cr = vld1q_f64(lanes.cr), ci = vld1q_f64(lanes.ci);
+			float64x2_t zr = vld1q_f64(lanes.zr), zi = vld1q_f64(lanes.zi);
+			float64x2_t iterations = vld1q_f64(lanes.iterations);
+			while (lanes.isBusy()) {
+				const float64x2_t zr2 = vmulq_f64(zr, zr);
+				const float64x2_t zi2 = vmulq_f64(zi, zi);
+				const uint64x2_t done =
+						vorrq_u64(vcgtq_f64(vaddq_f64(zr2, zi2), bailout), vcgeq_f64(iterations, limit));
+				if (vmaxvq_u32(vreinterpretq_u32_u64(done)) != 0) {
+					const unsigned mask = (vgetq_lane_u64(done, 0) & 1) | (vgetq_lane_u64(done, 1) & 2);
+					vst1q_f64(lanes.zr, zr);
+					vst1q_f64(lanes.zi, zi);
+					vst1q_f64(lanes.iterations, iterations);
+					lanes.retire(mask);
+					cr = vld1q_f64(lanes.cr);
+					ci = vld1q_f64(lanes.ci);
+					zr = vld1q_f64(lanes.zr);
+					zi = vld1q_f64(lanes.zi);
+					iterations = vld1q_f64(lanes.iterations);
+					continue;
+				}
+				zi = vaddq_f64(vmulq_f64(vaddq_f64(zr, zr), zi), ci);
+				zr = vaddq_f64(vsubq_f64(zr2, zi2), cr);
+				iterations = vaddq_f64(iterations, one);
+			}
+		}
+
+		constexpr FractalKernels neonKernels{"neon", escapeRowNeon};
+#endif
+
+		std::vector<const FractalKernels *> detectKernels() {
+			std::vector<const FractalKernels *> kernels{&scalarKernels};
+#if PXE_KERNELS_X86
+			kernels.push_back(&sse2Kernels);
+			if (cpuSupportsAvx2()) {
+				kernels.push_back(&avx2Kernels);
+				if (cpuSupportsAvx512()) {
+					kernels.push_back(&avx512Kernels);
+				}
+			}
+#elif PXE_KERNELS_NEON
+			kernels.push_back(&neonKernels);
+#endif
+			return kernels;
+		}
+
+		const std::vector<const FractalKernels *> &kernelRegistry() {
+			static const std::vector<const FractalKernels *> kernels = detectKernels();
+			return kernels;
+		}
+	} // namespace
+
+	const FractalKernels &fractalKernels() {
+		static const FractalKernels &best = *kernelRegistry().back();
+		return best;
+	}
+
+	std::span<const FractalKernels *const> availableFractalKernels() { return kernelRegistry(); }
+} // namespace pxe
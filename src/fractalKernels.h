@@ -0,0 +1,71 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+
+namespace pxe {
+	/// Escape value of points that did not escape within the iteration limit (members of the set).
+	inline constexpr float fractalInterior = -1.0f;
+
+	/// Squared escape radius. Much larger than the mathematical 4 so the smooth escape value is continuous.
+	inline constexpr double fractalBailout = 256.0 * 256.0;
+
+	/**
+	 * @brief Computes the continuous (smooth) escape value of a point.
+	 *
+	 * The integer iteration count produces visible bands; subtracting log2(log|z|) interpolates between
+	 * them, so neighbouring pixels vary smoothly.
+	 * @param iterations Number of iterations applied before |z|² exceeded the bailout.
+	 * @param magnitude |z|² of the escaping value.
+	 */
+	[[nodiscard]] inline float smoothEscapeValue(const int iterations, const double magnitude) {
+		// log|z| = log2(|z|²) * ln(2) / 2; single precision is plenty for a color and much faster.
+		const float logModulus = std::log2(static_cast<float>(magnitude)) * (0.5f * std::numbers::ln2_v<float>);
+		const float value = static_cast<float>(iterations) + 1.0f - std::log2(logModulus);
+		return value < 0.0f ? 0.0f : value;
+	}
+
+	/**
+	 * @brief A table of Mandelbrot iteration kernels implemented for one instruction set.
+	 *
+	 * The vector kernels iterate one point per double lane (2 for SSE2/NEON, 4 for AVX2, 8 for AVX-512),
+	 * masking out the lanes that escaped until every lane is done. Points in the main cardioid and the
+	 * period-2 bulb are detected analytically and never iterated.
+	 */
+	struct FractalKernels {
+		/// Name of the instruction set, e.g. "avx2".
+		const char *name;
+		/// Writes the smooth escape value of `count` points c = (real + i * realStep, imag) to `values`, or
+		/// `fractalInterior` for points that do not escape within `maxIterations`.
+		void (*escapeRow)(float *values, size_t count, double real, double realStep, double imag, int maxIterations);
+	};
+
+	/**
+	 * @brief Gets the fastest fractal kernels supported by the running CPU.
+	 */
+	[[nodiscard]] const FractalKernels &fractalKernels();
+
+	/**
+	 * @brief Lists every fractal kernel table the running CPU can execute, scalar first.
+	 */
+	[[nodiscard]] std::span<const FractalKernels *const> availableFractalKernels();
+} // namespace pxe
@@ -0,0 +1,246 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fractalRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include "color.h"
+#include "fractalKernels.h"
+#include "referenceOrbit.h"
+
+namespace pxe {
+	namespace {
+		constexpr size_t paletteSize = 1024;
+		// Palette entries per unit of sqrt(escape value). The square root keeps the color bands of deep,
+		// high-iteration views from getting narrower than a pixel.
+		constexpr double paletteDensity = 64.0;
+		constexpr float notComputed = std::numeric_limits<float>::quiet_NaN();
+
+		void checkSize(const int width, const int height) {
+			if (width <= 0 || height <= 0)
+				throw std::invalid_argument("FractalRenderer: size must be positive");
+		}
+	} // namespace
+
+	FractalRenderer::FractalRenderer(const int width, const int height) :
+		width(width), height(height), scale(maxScale), reference(std::make_unique<ReferenceOrbit>()) {
+		checkSize(width, height);
+		scale = std::min(maxScale, 4.0 / std::min(width, height));
+		// A cyclic cosine palette: each channel is a cosine of the same period with its own phase.
+		palette.resize(paletteSize);
+		for (size_t i = 0; i < paletteSize; i++) {
+			const double t = static_cast<double>(i) / paletteSize;
+			auto channel = [t](const double phase) {
+				const double level = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * (t + phase));
+				return static_cast<uint8_t>(std::lround(255.0 * level));
+			};
+			palette[i] = Color(channel(0.0), channel(0.1), channel(0.2)).pixel();
+		}
+		setCenter(-0.5, 0.0);
+	}
+
+	FractalRenderer::~FractalRenderer() = default;
+
+	void FractalRenderer::resize(const int width, const int height) {
+		checkSize(width, height);
+		this->width = width;
+		this->height = height;
+		pixels.assign(static_cast<size_t>(width) * height, Color::Black.pixel());
+		restart();
+	}
+
+	void FractalRenderer::setCenter(const double real, const double imag) {
+		reference->setPoint(BigFixed::fromDouble(real), BigFixed::fromDouble(imag));
+		panX = panY = 0.0;
+		restart();
+	}
+
+	void FractalRenderer::setCenter(const std::string_view real, const std::string_view imag) {
+		reference->setPoint(BigFixed::fromDecimal(real), BigFixed::fromDecimal(imag));
+		panX = panY = 0.0;
+		restart();
+	}
+
+	void FractalRenderer::pan(const double dx, const double dy) {
+		panX += dx;
+		panY += dy;
+		const double wholeX = std::trunc(panX);
+		const double wholeY = std::trunc(panY);
+		if (wholeX == 0.0 && wholeY == 0.0)
+			return;
+		panX -= wholeX;
+		panY -= wholeY;
+		reference->offset(wholeX * scale, wholeY * scale);
+		orbitReady = false;
+
+		// Before the last pass every computed value is exact at its pixel, so the last pass also fills in
+		// the exposed strips. Coarser blocks would no longer line up with the sample grid.
+		const bool reusable = block <= 1;
+		const bool overlaps = std::fabs(wholeX) < width && std::fabs(wholeY) < height;
+		if (overlaps) {
+			shift(static_cast<int>(wholeX), static_cast<int>(wholeY));
+			changed = true;
+		}
+		if (reusable && overlaps) {
+			block = 1;
+		} else {
+			restart();
+		}
+	}
+
+	void FractalRenderer::setScale(double scale) {
+		scale = std::clamp(scale, minScale, maxScale);
+		if (scale == this->scale)
+			return;
+		this->scale = scale;
+		restart();
+	}
+
+	void FractalRenderer::setMaxIterations(const int maxIterations) {
+		if (maxIterations <= 0)
+			throw std::invalid_argument("FractalRenderer: the iteration limit must be positive");
+		if (maxIterations == this->maxIterations)
+			return;
+		this->maxIterations = maxIterations;
+		restart();
+	}
+
+	void FractalRenderer::setTimeBudget(const double milliseconds) { budgetMilliseconds = std::max(0.0, milliseconds); }
+
+	bool FractalRenderer::update(const ParallelFor &parallelFor) {
+		if (block > 0) {
+			using clock = std::chrono::steady_clock;
+			const auto start = clock::now();
+			if (isPerturbed() && !orbitReady) {
+				// Pixel offsets reach half the diagonal; the series has to hold that far out.
+				const double radius = scale * std::hypot(width / 2 + 1, height / 2 + 1);
+				reference->compute(ReferenceOrbit::precisionFor(scale), maxIterations, radius);
+				orbitReady = true;
+			}
+			do {
+				runPass(block, parallelFor);
+				block /= 2;
+				changed = true;
+			} while (block > 0 && std::chrono::duration<double, std::milli>(clock::now() - start).count() <
+										  budgetMilliseconds);
+		}
+		const bool result = changed;
+		changed = false;
+		return result;
+	}
+
+	void FractalRenderer::copyTo(const SurfaceView &view) const {
+		const int rows = std::min(height, view.getHeight());
+		const auto columns = static_cast<size_t>(std::min(width, view.getWidth()));
+		for (int y = 0; y < rows; y++) {
+			std::memcpy(view.row(y), &pixels[static_cast<size_t>(y) * width], columns * sizeof(uint32_t));
+		}
+	}
+
+	void FractalRenderer::restart() {
+		values.assign(static_cast<size_t>(width) * height, notComputed);
+		pixels.resize(values.size());
+		block = coarsestBlock;
+		orbitReady = false;
+	}
+
+	void FractalRenderer::shift(const int dx, const int dy) {
+		// The pixel that was at (x + dx, y + dy) moves to (x, y).
+		scratchValues.assign(values.size(), notComputed);
+		scratchPixels.assign(pixels.size(), Color::Black.pixel());
+		const int firstX = std::max(0, -dx);
+		const int lastX = std::min(width, width - dx);
+		for (int y = std::max(0, -dy); y < std::min(height, height - dy); y++) {
+			const size_t target = static_cast<size_t>(y) * width + firstX;
+			const size_t source = static_cast<size_t>(y + dy) * width + firstX + dx;
+			std::copy_n(&values[source], lastX - firstX, &scratchValues[target]);
+			std::copy_n(&pixels[source], lastX - firstX, &scratchPixels[target]);
+		}
+		values.swap(scratchValues);
+		pixels.swap(scratchPixels);
+	}
+
+	void FractalRenderer::runPass(const int blockSize, const ParallelFor &parallelFor) {
+		// Each task owns the rows of one band of blocks, so tasks never write the same pixels.
+		const int bands = (height + blockSize - 1) / blockSize;
+		auto body = [this, blockSize](const int band) {
+			thread_local std::vector<float> samples;
+			renderRow(band * blockSize, blockSize, samples);
+		};
+		if (parallelFor) {
+			parallelFor(bands, body);
+		} else {
+			for (int band = 0; band < bands; band++) {
+				body(band);
+			}
+		}
+	}
+
+	void FractalRenderer::renderRow(const int y, const int blockSize, std::vector<float> &samples) {
+		float *rowValues = &values[static_cast<size_t>(y) * width];
+		const double deltaImag = static_cast<double>(y - height / 2) * scale;
+		const int sampleCount = (width + blockSize - 1) / blockSize;
+		const int blockHeight = std::min(blockSize, height - y);
+		// Samples of this pass lie on the grid of `blockSize`; runs of missing ones are computed together.
+		for (int first = 0; first < sampleCount;) {
+			if (!std::isnan(rowValues[first * blockSize])) {
+				first++;
+				continue;
+			}
+			int end = first + 1;
+			while (end < sampleCount && std::isnan(rowValues[end * blockSize])) {
+				end++;
+			}
+			const auto run = static_cast<size_t>(end - first);
+			samples.resize(run);
+			const int x0 = first * blockSize;
+			if (isPerturbed()) {
+				for (size_t i = 0; i < run; i++) {
+					const int x = x0 + static_cast<int>(i) * blockSize;
+					samples[i] = reference->escape(static_cast<double>(x - width / 2) * scale, deltaImag);
+				}
+			} else {
+				fractalKernels().escapeRow(samples.data(), run,
+										   reference->getReal() + static_cast<double>(x0 - width / 2) * scale,
+										   blockSize * scale, reference->getImag() + deltaImag, maxIterations);
+			}
+
+			for (size_t i = 0; i < run; i++) {
+				const int x = x0 + static_cast<int>(i) * blockSize;
+				rowValues[x] = samples[i];
+				const uint32_t color = colorOf(samples[i]);
+				const int blockWidth = std::min(blockSize, width - x);
+				for (int row = 0; row < blockHeight; row++) {
+					std::fill_n(&pixels[static_cast<size_t>(y + row) * width + x], blockWidth, color);
+				}
+			}
+			first = end;
+		}
+	}
+
+	uint32_t FractalRenderer::colorOf(const float value) const {
+		if (value < 0.0f)
+			return Color::Black.pixel();
+		return palette[static_cast<size_t>(std::sqrt(value) * paletteDensity) % paletteSize];
+	}
+} // namespace pxe
@@ -0,0 +1,215 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frameCapture.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "glPixelFormat.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <pthread.h>
+#endif
+
+namespace pxe {
+	namespace {
+		constexpr GLbitfield readbackFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	} // namespace
+
+	FrameCapture::FrameCapture(const CaptureSettings &settings, const int width, const int height,
+							   const bool gpuReadback) :
+		width(width), height(height), sink(createFrameSink(settings, width, height)),
+		freeSlots(static_cast<size_t>(std::max(settings.queueDepth, 1))),
+		filledSlots(static_cast<size_t>(std::max(settings.queueDepth, 1))), dropWhenBehind(settings.dropWhenBehind) {
+		const size_t slotCount = std::max(settings.queueDepth, 1);
+		const size_t framePixels = static_cast<size_t>(width) * height;
+
+		if (gpuReadback) {
+			const auto bufferSize = static_cast<GLsizeiptr>(slotCount * framePixels * sizeof(uint32_t));
+			glGenBuffers(1, &readbackBuffer);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffer);
+			glBufferStorage(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, readbackFlags);
+			void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, readbackFlags);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			if (!mapped) {
+				releaseReadbackBuffer();
+				throw std::runtime_error("Failed to map capture readback buffer");
+			}
+			for (size_t slot = 0; slot < slotCount; slot++) {
+				slots.push_back(static_cast<uint32_t *>(mapped) + slot * framePixels);
+			}
+		} else {
+			frameMemory.resize(slotCount * framePixels);
+			for (size_t slot = 0; slot < slotCount; slot++) {
+				slots.push_back(frameMemory.data() + slot * framePixels);
+			}
+		}
+		for (size_t slot = 0; slot < slotCount; slot++) {
+			freeSlots.tryPush(static_cast<int>(slot));
+		}
+		writer = std::thread([this] { writerLoop(); });
+	}
+
+	FrameCapture::~FrameCapture() {
+		if (finished)
+			return;
+		try {
+			finish();
+		} catch (...) {
+			// Errors can only be reported through finish(); the capture is being discarded anyway.
+		}
+	}
+
+	bool FrameCapture::usesGpuReadback() const { return readbackBuffer != 0; }
+
+	void FrameCapture::captureTexture(const GLuint texture) {
+		submitReadbacks(false);
+		const int slot = acquireSlot();
+		if (slot < 0)
+			return;
+
+		// Slots are consecutive in the buffer, so the pack offset is the slot's distance from the first one.
+		const size_t offset = (slots[slot] - slots[0]) * sizeof(uint32_t);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffer);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glGetTexImage(GL_TEXTURE_2D, 0, surfaceGLFormat.format, surfaceGLFormat.type,
+					  reinterpret_cast<void *>(offset));
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		pendingReadbacks.push_back({slot, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+	}
+
+	void FrameCapture::captureView(const SurfaceView &frame) {
+		const int slot = acquireSlot();
+		if (slot < 0)
+			return;
+
+		const int rows = std::min(height, frame.getHeight());
+		const size_t rowBytes = static_cast<size_t>(std::min(width, frame.getWidth())) * sizeof(uint32_t);
+		if (frame.getPitch() == width && rows == height && rowBytes == width * sizeof(uint32_t)) {
+			std::memcpy(slots[slot], frame.row(0), rowBytes * rows);
+		} else {
+			for (int y = 0; y < rows; y++) {
+				std::memcpy(slots[slot] + static_cast<size_t>(y) * width, frame.row(y), rowBytes);
+			}
+		}
+		submit(slot);
+	}
+
+	void FrameCapture::finish() {
+		if (finished)
+			return;
+		finished = true;
+
+		submitReadbacks(true);
+		stopping.store(true, std::memory_order_release);
+		submitted.fetch_add(1, std::memory_order_release);
+		submitted.notify_one();
+		writer.join();
+		releaseReadbackBuffer();
+		if (writerError) {
+			std::rethrow_exception(writerError);
+		}
+	}
+
+	CaptureStats FrameCapture::getStats() const {
+		return {framesWritten.load(std::memory_order_relaxed), framesDropped.load(std::memory_order_relaxed)};
+	}
+
+	int FrameCapture::acquireSlot() {
+		int slot;
+		while (!failed.load(std::memory_order_acquire)) {
+			const uint32_t seen = released.load(std::memory_order_acquire);
+			if (freeSlots.tryPop(slot))
+				return slot;
+			if (dropWhenBehind)
+				break;
+			// Every slot may be waiting on the GPU, and none of those can come back before being submitted.
+			submitReadbacks(true);
+			released.wait(seen, std::memory_order_acquire);
+		}
+		framesDropped.fetch_add(1, std::memory_order_relaxed);
+		return -1;
+	}
+
+	void FrameCapture::submit(const int slot) {
+		// Never fails: at most every slot is in flight, and the queue has room for all of them.
+		filledSlots.tryPush(slot);
+		submitted.fetch_add(1, std::memory_order_release);
+		submitted.notify_one();
+	}
+
+	void FrameCapture::submitReadbacks(const bool waitForAll) {
+		while (!pendingReadbacks.empty()) {
+			const Readback readback = pendingReadbacks.front();
+			const GLuint64 timeout = waitForAll ? GL_TIMEOUT_IGNORED : 0;
+			if (glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout) == GL_TIMEOUT_EXPIRED)
+				break;
+			glDeleteSync(readback.fence);
+			pendingReadbacks.pop_front();
+			submit(readback.slot);
+		}
+	}
+
+	void FrameCapture::writerLoop() {
+#ifndef _WIN32
+		// A pipe whose reader died (e.g. ffmpeg missing or failing) must fail the write, not kill the process.
+		sigset_t pipeSignal;
+		sigemptyset(&pipeSignal);
+		sigaddset(&pipeSignal, SIGPIPE);
+		pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+#endif
+		try {
+			while (true) {
+				const uint32_t seen = submitted.load(std::memory_order_acquire);
+				int slot;
+				if (filledSlots.tryPop(slot)) {
+					sink->write(slots[slot]);
+					freeSlots.tryPush(slot);
+					framesWritten.fetch_add(1, std::memory_order_relaxed);
+					released.fetch_add(1, std::memory_order_release);
+					released.notify_one();
+					continue;
+				}
+				// A frame pushed just before stopping may not have been visible to the pop above.
+				if (stopping.load(std::memory_order_acquire)) {
+					if (filledSlots.isEmpty())
+						break;
+					continue;
+				}
+				submitted.wait(seen, std::memory_order_acquire);
+			}
+			sink->close();
+		} catch (...) {
+			writerError = std::current_exception();
+			failed.store(true, std::memory_order_release);
+			released.fetch_add(1, std::memory_order_release);
+			released.notify_one();
+		}
+	}
+
+	void FrameCapture::releaseReadbackBuffer() {
+		if (!readbackBuffer)
+			return;
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffer);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glDeleteBuffers(1, &readbackBuffer);
+		readbackBuffer = 0;
+	}
+} // namespace pxe
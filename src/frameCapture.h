@@ -0,0 +1,129 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "captureSettings.h"
+#include "frameSink.h"
+#include "openGLContext.h"
+#include "spscQueue.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief Streams frames to a `FrameSink` on a writer thread without ever blocking the render loop.
+	 *
+	 * A fixed pool of frame slots circulates between the render thread and the writer thread through two
+	 * lock-free SPSC queues. With GPU readback the slots are regions of one persistently mapped pixel pack
+	 * buffer: the display texture is copied into a slot by the GPU, a fence marks the copy, and the slot is
+	 * handed to the writer once the fence has signaled, so the render thread never touches the pixels.
+	 * Without OpenGL the slots are heap buffers filled with one copy of the surface. When no slot is free
+	 * because the writer fell behind, the frame is dropped and counted, unless the settings ask to wait.
+	 *
+	 * Every method except `getStats()` must be called on the same thread, which owns the GL context when
+	 * GPU readback is used.
+	 */
+	class FrameCapture {
+	public:
+		/**
+		 * @brief Opens the output and starts the writer thread.
+		 * @param settings Output format, path and queue depth.
+		 * @param width Width of the captured frames.
+		 * @param height Height of the captured frames.
+		 * @param gpuReadback True to read frames back from the display texture; requires persistent mapping.
+		 * @throws std::runtime_error if the output cannot be opened.
+		 */
+		FrameCapture(const CaptureSettings &settings, int width, int height, bool gpuReadback);
+
+		/**
+		 * @brief Finishes the capture if `finish()` was not called, ignoring write errors.
+		 */
+		~FrameCapture();
+
+		FrameCapture(const FrameCapture &) = delete;
+		FrameCapture &operator=(const FrameCapture &) = delete;
+
+		/**
+		 * @brief Checks whether frames are read back from a texture rather than copied from a surface.
+		 */
+		[[nodiscard]] bool usesGpuReadback() const;
+
+		/**
+		 * @brief Queues an asynchronous copy of a texture the size of the capture. GPU readback only.
+		 */
+		void captureTexture(GLuint texture);
+
+		/**
+		 * @brief Copies a finished frame into a free slot and queues it.
+		 */
+		void captureView(const SurfaceView &frame);
+
+		/**
+		 * @brief Writes every queued frame, closes the output and stops the writer thread.
+		 * @throws std::runtime_error if any frame could not be written.
+		 */
+		void finish();
+
+		/**
+		 * @brief Gets the number of frames written and dropped so far. May be called from any thread.
+		 */
+		[[nodiscard]] CaptureStats getStats() const;
+
+	private:
+		struct Readback {
+			int slot;
+			GLsync fence;
+		};
+
+		int width, height;
+		std::unique_ptr<FrameSink> sink;
+		std::vector<uint32_t> frameMemory; ///< Slot storage without GPU readback.
+		GLuint readbackBuffer = 0; ///< Slot storage with GPU readback, persistently mapped.
+		std::vector<uint32_t *> slots;
+		SpscQueue<int> freeSlots; ///< Pushed by the writer, popped by the render thread.
+		SpscQueue<int> filledSlots; ///< Pushed by the render thread, popped by the writer.
+		std::deque<Readback> pendingReadbacks; ///< GPU copies not known to be complete, oldest first.
+		std::atomic<uint32_t> submitted{0}; ///< Bumped after every push to `filledSlots`; the writer waits on it.
+		std::atomic<uint32_t> released{0}; ///< Bumped after every push to `freeSlots`, for `dropWhenBehind` off.
+		bool dropWhenBehind;
+		std::atomic<bool> stopping{false};
+		std::atomic<bool> failed{false};
+		std::atomic<size_t> framesWritten{0};
+		std::atomic<size_t> framesDropped{0};
+		std::exception_ptr writerError;
+		std::thread writer;
+		bool finished = false;
+
+		[[nodiscard]] int acquireSlot();
+		void submit(int slot);
+
+		/**
+		 * @brief Hands completed GPU copies to the writer, optionally waiting for all of them.
+		 */
+		void submitReadbacks(bool waitForAll);
+
+		void writerLoop();
+		void releaseReadbackBuffer();
+	};
+} // namespace pxe
@@ -0,0 +1,49 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frameLimiter.h"
+#include <thread>
+
+namespace pxe {
+	void FrameLimiter::setTargetFps(const double framesPerSecond) {
+		framePeriod = framesPerSecond > 0.0
+							  ? std::chrono::duration_cast<clock::duration>(
+										std::chrono::duration<double>(1.0 / framesPerSecond))
+							  : clock::duration::zero();
+		nextDeadline = clock::now() + framePeriod;
+	}
+
+	void FrameLimiter::wait() {
+		if (framePeriod == clock::duration::zero())
+			return;
+
+		auto now = clock::now();
+		if (now < nextDeadline - spinMargin) {
+			std::this_thread::sleep_until(nextDeadline - spinMargin);
+		}
+		while ((now = clock::now()) < nextDeadline) {
+			std::this_thread::yield();
+		}
+
+		nextDeadline += framePeriod;
+		if (now > nextDeadline) {
+			// More than a whole period late: restart the schedule instead of bursting frames.
+			nextDeadline = now + framePeriod;
+		}
+	}
+} // namespace pxe
@@ -0,0 +1,53 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+
+namespace pxe {
+	/**
+	 * @brief Caps the frame rate with a hybrid sleep/spin wait.
+	 *
+	 * OS sleeps are cheap but can overshoot by a millisecond or more, so the limiter sleeps until shortly
+	 * before the deadline and spins for the remainder. Deadlines advance by exactly one frame period to
+	 * avoid drift; if a frame runs late by more than a period, the schedule restarts from now instead of
+	 * rushing to catch up.
+	 */
+	class FrameLimiter {
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/// Time before the deadline at which the limiter stops sleeping and starts spinning.
+		static constexpr std::chrono::microseconds spinMargin{1500};
+
+		/**
+		 * @brief Sets the target frame rate.
+		 * @param framesPerSecond Frames per second; zero or negative disables the limiter.
+		 */
+		void setTargetFps(double framesPerSecond);
+
+		/**
+		 * @brief Blocks until the current frame's deadline, then schedules the next one.
+		 */
+		void wait();
+
+	private:
+		clock::duration framePeriod{};
+		clock::time_point nextDeadline{};
+	};
+} // namespace pxe
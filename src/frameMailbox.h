@@ -0,0 +1,75 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace pxe {
+	/**
+	 * @brief A lock-free triple-buffer mailbox passing completed frames from one producer to one consumer.
+	 *
+	 * The mailbox only exchanges buffer indices (0, 1 or 2). At any time the producer owns one buffer,
+	 * the consumer owns another, and the third sits in the shared slot. Publishing swaps the producer's
+	 * buffer into the slot and marks it fresh; acquiring swaps the consumer's buffer with a fresh slot.
+	 * Neither side ever waits: the producer overwrites frames the consumer did not pick up in time, and
+	 * the consumer keeps showing its current frame when nothing new was published.
+	 */
+	class FrameMailbox {
+	public:
+		/// Buffer the producer owns initially.
+		static constexpr int initialProducerIndex = 0;
+		/// Buffer the consumer owns initially.
+		static constexpr int initialConsumerIndex = 2;
+
+		/**
+		 * @brief Publishes a completed buffer. Producer side only.
+		 * @param completed Index of the buffer the producer just finished.
+		 * @return Index of the buffer the producer owns from now on.
+		 */
+		int publish(const int completed) {
+			const auto published = static_cast<uint8_t>(completed | freshFlag);
+			const uint8_t previous = shared.exchange(published, std::memory_order_acq_rel);
+			return previous & indexMask;
+		}
+
+		/**
+		 * @brief Takes the most recently published buffer, if there is one. Consumer side only.
+		 * @param presented Index of the buffer the consumer owns; replaced by the fresh one on success.
+		 * @return True if a new frame was acquired.
+		 */
+		bool acquire(int &presented) {
+			if (!(shared.load(std::memory_order_acquire) & freshFlag))
+				return false;
+			const uint8_t previous = shared.exchange(static_cast<uint8_t>(presented), std::memory_order_acq_rel);
+			presented = previous & indexMask;
+			return true;
+		}
+
+		/**
+		 * @brief Returns the mailbox to its initial state. Neither side may be using it.
+		 */
+		void reset() { shared.store(1, std::memory_order_relaxed); }
+
+	private:
+		static constexpr uint8_t indexMask = 0x3;
+		static constexpr uint8_t freshFlag = 0x4;
+
+		std::atomic<uint8_t> shared{1};
+	};
+} // namespace pxe
@@ -0,0 +1,81 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frameProfiler.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace pxe {
+	namespace {
+		// Nearest-rank percentile of an already sorted, non-empty sample set.
+		double percentile(const std::vector<double> &sorted, const double fraction) {
+			const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+			return sorted[std::min(rank, sorted.size() - 1)];
+		}
+	} // namespace
+
+	void FrameProfiler::setEnabled(const bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+	void FrameProfiler::record(const FramePhase phase, const double milliseconds) {
+		std::lock_guard lock(historyMutex);
+		History &history = histories[static_cast<size_t>(phase)];
+		history.samples[history.next] = milliseconds;
+		history.next = (history.next + 1) % historySize;
+		history.count = std::min(history.count + 1, historySize);
+	}
+
+	FrameStats FrameProfiler::getStats() const {
+		FrameStats stats;
+		std::vector<double> sorted;
+		sorted.reserve(historySize);
+
+		std::lock_guard lock(historyMutex);
+		for (size_t phase = 0; phase < framePhaseCount; phase++) {
+			const History &history = histories[phase];
+			if (history.count == 0)
+				continue;
+
+			sorted.assign(history.samples.begin(), history.samples.begin() + history.count);
+			std::ranges::sort(sorted);
+
+			PhaseTiming &timing = stats.phases[phase];
+			timing.last = history.samples[(history.next + historySize - 1) % historySize];
+			timing.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+			timing.p50 = percentile(sorted, 0.50);
+			timing.p95 = percentile(sorted, 0.95);
+			timing.p99 = percentile(sorted, 0.99);
+			timing.samples = history.count;
+		}
+		return stats;
+	}
+
+	size_t FrameProfiler::copyRecent(const FramePhase phase, std::span<double> samples) const {
+		std::ranges::fill(samples, 0.0);
+
+		std::lock_guard lock(historyMutex);
+		const History &history = histories[static_cast<size_t>(phase)];
+		const size_t count = std::min(samples.size(), history.count);
+		for (size_t i = 0; i < count; i++) {
+			// The last `count` samples, oldest first, right-aligned in the output.
+			const size_t source = (history.next + historySize - count + i) % historySize;
+			samples[samples.size() - count + i] = history.samples[source];
+		}
+		return count;
+	}
+} // namespace pxe
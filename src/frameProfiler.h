@@ -0,0 +1,110 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include "frameStats.h"
+
+namespace pxe {
+	/**
+	 * @brief Collects per-phase frame timings into fixed-size rolling windows.
+	 *
+	 * Samples may be recorded from several threads (in render-thread mode the simulation and presenting
+	 * threads each time their own phases). When the profiler is disabled, recording costs one relaxed load.
+	 */
+	class FrameProfiler {
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/// Number of samples kept per phase (about four seconds at 60 FPS).
+		static constexpr size_t historySize = 240;
+
+		/**
+		 * @brief Enables or disables recording. Disabling keeps the samples collected so far.
+		 */
+		void setEnabled(bool enabled);
+
+		/**
+		 * @brief Checks whether samples are being recorded.
+		 */
+		[[nodiscard]] bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Adds a sample to a phase.
+		 * @param phase The measured phase.
+		 * @param milliseconds Duration of the phase.
+		 */
+		void record(FramePhase phase, double milliseconds);
+
+		/**
+		 * @brief Computes the rolling statistics of every phase.
+		 */
+		[[nodiscard]] FrameStats getStats() const;
+
+		/**
+		 * @brief Copies the most recent samples of a phase, oldest first.
+		 * @param phase The phase to read.
+		 * @param samples Receives up to `samples.size()` samples; missing ones are set to zero.
+		 * @return Number of samples actually copied.
+		 */
+		size_t copyRecent(FramePhase phase, std::span<double> samples) const;
+
+	private:
+		struct History {
+			std::array<double, historySize> samples{};
+			size_t next = 0;
+			size_t count = 0;
+		};
+
+		std::atomic<bool> enabled{false};
+		mutable std::mutex historyMutex;
+		std::array<History, framePhaseCount> histories{};
+	};
+
+	/**
+	 * @brief Times the enclosing scope and records it into a phase of a `FrameProfiler`.
+	 */
+	class ProfileScope {
+	public:
+		ProfileScope(FrameProfiler &profiler, const FramePhase phase) :
+			profiler(profiler.isEnabled() ? &profiler : nullptr), phase(phase) {
+			if (this->profiler) {
+				start = FrameProfiler::clock::now();
+			}
+		}
+
+		~ProfileScope() {
+			if (profiler) {
+				const auto elapsed = FrameProfiler::clock::now() - start;
+				profiler->record(phase, std::chrono::duration<double, std::milli>(elapsed).count());
+			}
+		}
+
+		ProfileScope(const ProfileScope &) = delete;
+		ProfileScope &operator=(const ProfileScope &) = delete;
+
+	private:
+		FrameProfiler *profiler;
+		FramePhase phase;
+		FrameProfiler::clock::time_point start{};
+	};
+} // namespace pxe
@@ -0,0 +1,251 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frameSink.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pixelFormat.h"
+#include "pngWriter.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+constexpr auto pipeWriteMode = "wb";
+#else
+constexpr auto pipeWriteMode = "w"; // POSIX pipes have no text mode, and glibc rejects "b".
+#endif
+
+namespace pxe {
+	namespace {
+		// The ffmpeg name of the byte order pixels have in memory.
+		constexpr const char *rawPixelFormatName() {
+			if constexpr (std::endian::native == std::endian::little) {
+				return PixelFormat::redShift == 16 ? "bgra" : "rgba";
+			} else {
+				return PixelFormat::redShift == 16 ? "argb" : "abgr";
+			}
+		}
+
+		std::string quoteForShell(const std::string &argument) {
+			std::string quoted = "\"";
+			for (const char c: argument) {
+#ifndef _WIN32
+				if (c == '"' || c == '\\' || c == '$' || c == '`') {
+					quoted += '\\';
+				}
+#endif
+				quoted += c;
+			}
+			return quoted + '"';
+		}
+
+		// Frame rate as the exact "numerator:denominator" pair Y4M headers expect.
+		std::string frameRateRatio(const double frameRate) {
+			if (frameRate == std::floor(frameRate))
+				return std::to_string(static_cast<long long>(frameRate)) + ":1";
+			return std::to_string(std::llround(frameRate * 1000.0)) + ":1000";
+		}
+
+		/**
+		 * @brief Base of the sinks writing a byte stream to a file or a pipe.
+		 */
+		class StreamSink : public FrameSink {
+		public:
+			StreamSink(const int width, const int height) : width(width), height(height) {}
+
+			~StreamSink() override {
+				if (stream) {
+					closeStream();
+				}
+			}
+
+			void close() override {
+				if (!stream)
+					return;
+				if (closeStream() != 0) {
+					throw std::runtime_error("Failed to finish writing the capture");
+				}
+			}
+
+		protected:
+			std::FILE *stream = nullptr;
+			bool isPipe = false;
+			int width, height;
+
+			void writeBytes(const void *data, const size_t size) {
+				if (std::fwrite(data, 1, size, stream) != size) {
+					throw std::runtime_error("Failed to write captured frame");
+				}
+			}
+
+		private:
+			int closeStream() {
+				const int status = isPipe ? pclose(stream) : std::fclose(stream);
+				stream = nullptr;
+				return status;
+			}
+		};
+
+		class RawSink final : public StreamSink {
+		public:
+			RawSink(const std::string &path, const int width, const int height) : StreamSink(width, height) {
+				stream = std::fopen(path.c_str(), "wb");
+				if (!stream) {
+					throw std::runtime_error("Failed to open capture file: " + path);
+				}
+			}
+
+			void write(const uint32_t *pixels) override {
+				writeBytes(pixels, static_cast<size_t>(width) * height * sizeof(uint32_t));
+			}
+		};
+
+		class FfmpegSink final : public StreamSink {
+		public:
+			FfmpegSink(const CaptureSettings &settings, const int width, const int height) : StreamSink(width, height) {
+				const std::string command = "ffmpeg -loglevel error -y -f rawvideo -pix_fmt " +
+											std::string(rawPixelFormatName()) + " -s " + std::to_string(width) +
+											"x" + std::to_string(height) + " -framerate " +
+											std::to_string(settings.frameRate) + " -i - " +
+											quoteForShell(settings.path);
+				stream = popen(command.c_str(), pipeWriteMode);
+				if (!stream) {
+					throw std::runtime_error("Failed to start ffmpeg");
+				}
+				isPipe = true;
+			}
+
+			void write(const uint32_t *pixels) override {
+				writeBytes(pixels, static_cast<size_t>(width) * height * sizeof(uint32_t));
+			}
+		};
+
+		class Y4mSink final : public StreamSink {
+		public:
+			Y4mSink(const CaptureSettings &settings, const int width, const int height) :
+				StreamSink(width, height), chromaWidth((width + 1) / 2), chromaHeight((height + 1) / 2),
+				planes(static_cast<size_t>(width) * height + 2 * static_cast<size_t>(chromaWidth) * chromaHeight) {
+				stream = std::fopen(settings.path.c_str(), "wb");
+				if (!stream) {
+					throw std::runtime_error("Failed to open capture file: " + settings.path);
+				}
+				const std::string header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) +
+										   " F" + frameRateRatio(settings.frameRate) + " Ip A1:1 C420jpeg\n";
+				writeBytes(header.data(), header.size());
+			}
+
+			void write(const uint32_t *pixels) override {
+				convert(pixels);
+				static constexpr char frameHeader[] = "FRAME\n";
+				writeBytes(frameHeader, sizeof(frameHeader) - 1);
+				writeBytes(planes.data(), planes.size());
+			}
+
+		private:
+			int chromaWidth, chromaHeight;
+			std::vector<uint8_t> planes; ///< Y, then Cb, then Cr.
+
+			// Full-range BT.601 (JFIF) in 16-bit fixed point; chroma is averaged over 2x2 blocks.
+			void convert(const uint32_t *pixels) {
+				uint8_t *luma = planes.data();
+				uint8_t *cb = luma + static_cast<size_t>(width) * height;
+				uint8_t *cr = cb + static_cast<size_t>(chromaWidth) * chromaHeight;
+				for (int y = 0; y < height; y++) {
+					const uint32_t *row = pixels + static_cast<size_t>(y) * width;
+					for (int x = 0; x < width; x++) {
+						const int r = PixelFormat::red(row[x]), g = PixelFormat::green(row[x]);
+						const int b = PixelFormat::blue(row[x]);
+						luma[static_cast<size_t>(y) * width + x] =
+								static_cast<uint8_t>((19595 * r + 38470 * g + 7471 * b + 32768) >> 16);
+					}
+				}
+				for (int cy = 0; cy < chromaHeight; cy++) {
+					for (int cx = 0; cx < chromaWidth; cx++) {
+						int r = 0, g = 0, b = 0, count = 0;
+						for (int y = cy * 2; y < std::min(cy * 2 + 2, height); y++) {
+							for (int x = cx * 2; x < std::min(cx * 2 + 2, width); x++) {
+								const uint32_t pixel = pixels[static_cast<size_t>(y) * width + x];
+								r += PixelFormat::red(pixel);
+								g += PixelFormat::green(pixel);
+								b += PixelFormat::blue(pixel);
+								count++;
+							}
+						}
+						r /= count;
+						g /= count;
+						b /= count;
+						const size_t index = static_cast<size_t>(cy) * chromaWidth + cx;
+						constexpr int offset = (128 << 16) + 32768; // Chroma bias plus rounding.
+						cb[index] = static_cast<uint8_t>((-11059 * r - 21709 * g + 32768 * b + offset) >> 16);
+						cr[index] = static_cast<uint8_t>((32768 * r - 27439 * g - 5329 * b + offset) >> 16);
+					}
+				}
+			}
+		};
+
+		class PngSequenceSink final : public FrameSink {
+		public:
+			PngSequenceSink(std::string prefix, const int width, const int height) :
+				prefix(std::move(prefix)), width(width), height(height) {}
+
+			void write(const uint32_t *pixels) override {
+				encodePng(pixels, width, height, width, png);
+				char number[16];
+				std::snprintf(number, sizeof(number), "%06zu", frameIndex++);
+				const std::string path = prefix + number + ".png";
+
+				std::FILE *file = std::fopen(path.c_str(), "wb");
+				if (!file) {
+					throw std::runtime_error("Failed to open capture file: " + path);
+				}
+				const bool written = std::fwrite(png.data(), 1, png.size(), file) == png.size();
+				if (std::fclose(file) != 0 || !written) {
+					throw std::runtime_error("Failed to write capture file: " + path);
+				}
+			}
+
+			void close() override {}
+
+		private:
+			std::string prefix;
+			int width, height;
+			size_t frameIndex = 0;
+			std::vector<uint8_t> png; ///< Encoded frame, kept to reuse its allocation.
+		};
+	} // namespace
+
+	std::unique_ptr<FrameSink> createFrameSink(const CaptureSettings &settings, const int width, const int height) {
+		switch (settings.format) {
+			case CaptureFormat::Raw:
+				return std::make_unique<RawSink>(settings.path, width, height);
+			case CaptureFormat::Y4M:
+				return std::make_unique<Y4mSink>(settings, width, height);
+			case CaptureFormat::PngSequence:
+				return std::make_unique<PngSequenceSink>(settings.path, width, height);
+			case CaptureFormat::Ffmpeg:
+				return std::make_unique<FfmpegSink>(settings, width, height);
+		}
+		throw std::invalid_argument("Unknown capture format");
+	}
+} // namespace pxe
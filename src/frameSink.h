@@ -0,0 +1,52 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include "captureSettings.h"
+
+namespace pxe {
+	/**
+	 * @brief Destination of captured frames in one of the `CaptureFormat` containers.
+	 *
+	 * Sinks run on the capture writer thread, so they may block on I/O and encoding.
+	 */
+	class FrameSink {
+	public:
+		virtual ~FrameSink() = default;
+
+		/**
+		 * @brief Writes one frame of tightly packed pixels in the engine's `PixelFormat`.
+		 * @throws std::runtime_error if the frame could not be written.
+		 */
+		virtual void write(const uint32_t *pixels) = 0;
+
+		/**
+		 * @brief Flushes and closes the output.
+		 * @throws std::runtime_error if pending data could not be written or the encoder failed.
+		 */
+		virtual void close() = 0;
+	};
+
+	/**
+	 * @brief Opens the output described by `settings` for frames of the given size.
+	 * @throws std::runtime_error if the file or the ffmpeg process cannot be opened.
+	 */
+	[[nodiscard]] std::unique_ptr<FrameSink> createFrameSink(const CaptureSettings &settings, int width, int height);
+} // namespace pxe
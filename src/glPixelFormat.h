@@ -0,0 +1,74 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <bit>
+#include "basicSurface.h"
+#include "openGLContext.h"
+#include "pixelFormat.h"
+
+namespace pxe {
+	/**
+	 * @brief OpenGL enums describing how a pixel layout is allocated and transferred.
+	 */
+	struct GLPixelFormat {
+		GLint internalFormat; ///< Texture storage format.
+		GLenum format; ///< Channel order of the client data.
+		GLenum type; ///< Component packing of the client data.
+	};
+
+	/**
+	 * @brief The upload format matching `PixelFormat`, selected at compile time.
+	 *
+	 * 0xAARRGGBB integers are exactly `GL_BGRA` + `GL_UNSIGNED_INT_8_8_8_8_REV` on any host, which is
+	 * the layout desktop drivers store internally and copy without conversion. The ES-friendly
+	 * 0xAABBGGRR layout maps to `GL_RGBA` bytes on little-endian hosts.
+	 */
+#ifdef PXE_PIXEL_FORMAT_RGBA
+	inline constexpr GLPixelFormat surfaceGLFormat{
+			GL_RGBA8, GL_RGBA,
+			std::endian::native == std::endian::little ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT_8_8_8_8_REV};
+#else
+	inline constexpr GLPixelFormat surfaceGLFormat{GL_RGBA8, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV};
+#endif
+
+	/**
+	 * @brief The upload format of a `BasicSurface` pixel format, as `GLPixelFormatOf<Format>::value`.
+	 *
+	 * Rows of those surfaces are padded to 64 bytes, which satisfies any `GL_UNPACK_ALIGNMENT`; set
+	 * `GL_UNPACK_ROW_LENGTH` to `getPitch()`. Indexed pixels land in the red channel, to be looked up in a
+	 * palette by the shader.
+	 */
+	template<typename Format>
+	struct GLPixelFormatOf;
+
+	template<>
+	struct GLPixelFormatOf<Argb8888Format> {
+		static constexpr GLPixelFormat value = surfaceGLFormat;
+	};
+
+	template<>
+	struct GLPixelFormatOf<Rgb565Format> {
+		static constexpr GLPixelFormat value{GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5};
+	};
+
+	template<>
+	struct GLPixelFormatOf<Indexed8Format> {
+		static constexpr GLPixelFormat value{GL_R8, GL_RED, GL_UNSIGNED_BYTE};
+	};
+} // namespace pxe
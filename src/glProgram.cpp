@@ -0,0 +1,70 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "glProgram.h"
+#include <stdexcept>
+#include <string>
+
+namespace pxe {
+	namespace {
+		GLuint compileShader(const GLenum type, const char *source) {
+			const GLuint shader = glCreateShader(type);
+			glShaderSource(shader, 1, &source, nullptr);
+			glCompileShader(shader);
+			// Check for compile errors.
+			GLint success;
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+			if (!success) {
+				char infoLog[512];
+				glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+				glDeleteShader(shader);
+				const std::string shaderType = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
+				throw std::runtime_error("Shader compilation failed (" + shaderType + "): " + infoLog);
+			}
+			return shader;
+		}
+	} // namespace
+
+	GLuint linkProgram(const char *vertexSource, const char *fragmentSource) {
+		const GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+		GLuint fragmentShader;
+		try {
+			fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+		} catch (...) {
+			glDeleteShader(vertexShader);
+			throw;
+		}
+
+		// Link shaders into a program.
+		const GLuint program = glCreateProgram();
+		glAttachShader(program, vertexShader);
+		glAttachShader(program, fragmentShader);
+		glLinkProgram(program);
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		GLint success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			char infoLog[512];
+			glGetProgramInfoLog(program, 512, nullptr, infoLog);
+			glDeleteProgram(program);
+			throw std::runtime_error(std::string("Shader program linking failed: ") + infoLog);
+		}
+		return program;
+	}
+} // namespace pxe
@@ -0,0 +1,33 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "openGLContext.h"
+
+namespace pxe {
+	/**
+	 * @brief Compiles and links a vertex and fragment shader pair into a program.
+	 *
+	 * Each rendering pipeline (the display quad, the sprite batch) owns one program built with this.
+	 * @param vertexSource GLSL source of the vertex shader.
+	 * @param fragmentSource GLSL source of the fragment shader.
+	 * @return The linked program; the shader objects are already deleted.
+	 * @throws std::runtime_error with the driver's log if compilation or linking fails.
+	 */
+	[[nodiscard]] GLuint linkProgram(const char *vertexSource, const char *fragmentSource);
+} // namespace pxe
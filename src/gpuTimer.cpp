@@ -0,0 +1,72 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gpuTimer.h"
+
+namespace pxe {
+	GpuTimerQueries::GpuTimerQueries() {
+		for (auto &frame: frames) {
+			glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+		}
+	}
+
+	GpuTimerQueries::~GpuTimerQueries() {
+		for (auto &frame: frames) {
+			glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+		}
+	}
+
+	void GpuTimerQueries::begin(const FramePhase phase) {
+		for (size_t i = 0; i < timedPhases.size(); i++) {
+			if (timedPhases[i] == phase) {
+				FrameQueries &frame = frames[currentFrame];
+				glBeginQuery(GL_TIME_ELAPSED, frame.queries[i]);
+				frame.issued[i] = true;
+				activeQuery = static_cast<int>(i);
+				return;
+			}
+		}
+	}
+
+	void GpuTimerQueries::end() {
+		if (activeQuery < 0)
+			return;
+		glEndQuery(GL_TIME_ELAPSED);
+		activeQuery = -1;
+	}
+
+	void GpuTimerQueries::endFrame(FrameProfiler &profiler) {
+		currentFrame = (currentFrame + 1) % framesInFlight;
+
+		// The slot about to be reused was issued `framesInFlight` frames ago.
+		FrameQueries &frame = frames[currentFrame];
+		for (size_t i = 0; i < timedPhases.size(); i++) {
+			if (!frame.issued[i])
+				continue;
+			frame.issued[i] = false;
+
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				continue;
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+			profiler.record(timedPhases[i], static_cast<double>(nanoseconds) / 1e6);
+		}
+	}
+} // namespace pxe
@@ -0,0 +1,70 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include "frameProfiler.h"
+#include "openGLContext.h"
+
+namespace pxe {
+	/**
+	 * @brief Measures GPU execution time of frame phases with `GL_TIME_ELAPSED` queries.
+	 *
+	 * Query results only become available once the GPU has caught up, so every frame uses its own set
+	 * of queries and results are read back `framesInFlight` frames later without blocking. Results that
+	 * are still not available by then are dropped rather than stalling the pipeline.
+	 */
+	class GpuTimerQueries {
+	public:
+		static constexpr int framesInFlight = 4;
+
+		GpuTimerQueries();
+		~GpuTimerQueries();
+
+		/**
+		 * @brief Starts timing a GPU phase. Only `GpuUpload` and `GpuDraw` are supported, and timers
+		 * may not nest.
+		 */
+		void begin(FramePhase phase);
+
+		/**
+		 * @brief Stops timing the phase started by the matching `begin`.
+		 */
+		void end();
+
+		/**
+		 * @brief Moves on to the next frame, recording the results of the oldest frame into `profiler`.
+		 */
+		void endFrame(FrameProfiler &profiler);
+
+		GpuTimerQueries(const GpuTimerQueries &) = delete;
+		GpuTimerQueries &operator=(const GpuTimerQueries &) = delete;
+
+	private:
+		static constexpr std::array timedPhases{FramePhase::GpuUpload, FramePhase::GpuDraw};
+
+		struct FrameQueries {
+			std::array<GLuint, timedPhases.size()> queries{};
+			std::array<bool, timedPhases.size()> issued{};
+		};
+
+		std::array<FrameQueries, framesInFlight> frames{};
+		int currentFrame = 0;
+		int activeQuery = -1;
+	};
+} // namespace pxe
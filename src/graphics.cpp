@@ -17,10 +17,16 @@
  */
 
 #include "graphics.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include "glPixelFormat.h"
+#include "glProgram.h"
 #include "openGLContext.h"
+#include "pixelKernels.h"
 #include "surface.h"
+#include "viewport.h"
 
 namespace pxe {
 	// Shader source strings
@@ -45,57 +51,143 @@ namespace pxe {
         }
     )";
 
-	Graphics::Graphics(const int width, const int height) :
-		width(width), height(height), surface(std::make_unique<Surface>(width, height)) {
+	// Samples the bilinear texture at the nearest texel center, except within half a screen pixel of a
+	// texel edge, where it blends across the edge; `scale` is screen pixels per texel.
+	auto sharpBilinearFragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 TexCoord;
+        uniform sampler2D screenTexture;
+        uniform vec2 sourceSize;
+        uniform vec2 scale;
+        void main() {
+            vec2 texel = TexCoord * sourceSize;
+            vec2 centerDistance = fract(texel) - 0.5;
+            vec2 edge = max(0.5 - 0.5 / scale, 0.0);
+            vec2 offset = (centerDistance - clamp(centerDistance, -edge, edge)) * scale;
+            FragColor = texture(screenTexture, (floor(texel) + 0.5 + offset) / sourceSize);
+        }
+    )";
+
+	auto crtFragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 TexCoord;
+        uniform sampler2D screenTexture;
+        uniform vec2 sourceSize;
+        uniform vec2 scale;
+        void main() {
+            vec2 texel = TexCoord * sourceSize;
+            vec2 centerDistance = fract(texel) - 0.5;
+            vec2 edge = max(0.5 - 0.5 / scale, 0.0);
+            vec2 offset = (centerDistance - clamp(centerDistance, -edge, edge)) * scale;
+            vec3 color = texture(screenTexture, (floor(texel) + 0.5 + offset) / sourceSize).rgb;
+
+            // Gaussian scanline profile around each row's center, faded out below 2x vertical scale.
+            float scanline = exp(-8.0 * centerDistance.y * centerDistance.y);
+            float strength = 0.6 * clamp(scale.y - 1.0, 0.0, 1.0);
+            // Aperture grille: every third screen column favors one primary.
+            vec3 mask = vec3(0.75);
+            mask[int(mod(gl_FragCoord.x, 3.0))] = 1.0;
+            // Brighten to make up for the light lost to the scanlines and the mask.
+            FragColor = vec4(color * mix(1.0, scanline, strength) * mask * (1.0 + 0.5 * strength), 1.0);
+        }
+    )";
+
+	// Looks the surface's palette indices up in a 256x1 palette, writing the display texture.
+	auto paletteFragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D indices;
+        uniform sampler2D palette;
+        void main() {
+            float index = texelFetch(indices, ivec2(gl_FragCoord.xy), 0).r;
+            FragColor = vec4(texelFetch(palette, ivec2(int(index * 255.0 + 0.5), 0), 0).rgb, 1.0);
+        }
+    )";
+
+	// Copies one layer texture into the display texture; fixed-function blending composites it over the layers below.
+	auto layerFragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D layer;
+        void main() {
+            FragColor = texelFetch(layer, ivec2(gl_FragCoord.xy), 0);
+        }
+    )";
+
+	Graphics::Graphics(const int width, const int height, const GraphicsTarget target, const GLADloadproc loader) :
+		width(width), height(height), fullWidth(width), fullHeight(height), outputWidth(width), outputHeight(height),
+		surfaces{std::make_unique<Surface>(width, height, surfacePool)}, surface(surfaces[0].get()), target(target) {
 		// Ensure the surface is cleared (all pixels set to opaque black) before first use.
 		surface->clear();
-		initOpenGL();
+		// Until a palette is set, indices are gray levels.
+		for (int i = 0; i < paletteSize; i++) {
+			const auto level = static_cast<uint8_t>(i);
+			palette[i] = Color(level, level, level).pixel();
+		}
+		if (target != GraphicsTarget::None) {
+			initOpenGL(loader);
+		}
 	}
 
 	Graphics::~Graphics() {
+		if (target == GraphicsTarget::None)
+			return;
 		// Clean up OpenGL resources. The surface is automatically deleted.
+		pixelBufferRing.reset();
+		gpuTimers.reset();
+		spriteRenderer.reset();
 		glDeleteTextures(1, &textureID);
 		glDeleteVertexArrays(1, &VAO);
 		glDeleteBuffers(1, &VBO);
 		glDeleteBuffers(1, &EBO);
-		glDeleteProgram(shaderProgram);
+		for (const DisplayProgram &program: displayPrograms) {
+			glDeleteProgram(program.program);
+		}
+		for (const auto &[hash, program]: pixelShaderPrograms) {
+			glDeleteProgram(program.program);
+		}
+		glDeleteFramebuffers(1, &textureFramebufferID);
+		glDeleteProgram(paletteProgram);
+		glDeleteTextures(1, &indexTextureID);
+		glDeleteTextures(1, &paletteTextureID);
+		for (const Layer &layer: layers) {
+			glDeleteTextures(1, &layer.textureID);
+		}
+		glDeleteTextures(1, &surfaceLayerTextureID);
+		glDeleteProgram(layerProgram);
+		glDeleteFramebuffers(1, &framebufferID);
+		glDeleteRenderbuffers(1, &renderbufferID);
 	}
 
-	void Graphics::initOpenGL() {
+	void Graphics::initOpenGL(const GLADloadproc loader) {
 		// Initialize GLAD (OpenGL function loader)
-		if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+		if (!gladLoadGLLoader(loader)) {
 			throw std::runtime_error("Failed to initialize GLAD");
 		}
+		if (target == GraphicsTarget::Framebuffer) {
+			initFramebuffer();
+		}
 
-
-		// Compile vertex and fragment shaders.
-		GLuint vertexShader, fragmentShader;
-		compileShader(vertexShader, GL_VERTEX_SHADER, vertexShaderSource);
-		compileShader(fragmentShader, GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-		// Link shaders into a program.
-		shaderProgram = glCreateProgram();
-		glAttachShader(shaderProgram, vertexShader);
-		glAttachShader(shaderProgram, fragmentShader);
-		glLinkProgram(shaderProgram);
-		GLint success;
-		glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-		if (!success) {
-			char infoLog[512];
-			glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-			throw std::runtime_error(std::string("Shader program linking failed: ") + infoLog);
+		const char *fragmentSources[] = {fragmentShaderSource, sharpBilinearFragmentShaderSource,
+										 crtFragmentShaderSource};
+		for (size_t i = 0; i < displayPrograms.size(); i++) {
+			DisplayProgram &program = displayPrograms[i];
+			program.program = linkProgram(vertexShaderSource, fragmentSources[i]);
+			program.sourceSizeLocation = glGetUniformLocation(program.program, "sourceSize");
+			program.scaleLocation = glGetUniformLocation(program.program, "scale");
 		}
-		glDeleteShader(vertexShader);
-		glDeleteShader(fragmentShader);
 
 		// Setup full-screen quad geometry (two triangles covering the screen).
 		// Corrected vertex data: 4 vertices with 4 floats each (positions and texture coordinates).
+		// Surface row 0 is the top row, so it maps to the top of the quad.
 		constexpr float vertices[] = {
 				// positions       // texture coords
-				-1.0f, -1.0f, 0.0f, 0.0f, // Bottom-left
-				1.0f,  -1.0f, 1.0f, 0.0f, // Bottom-right
-				1.0f,  1.0f,  1.0f, 1.0f, // Top-right
-				-1.0f, 1.0f,  0.0f, 1.0f // Top-left
+				-1.0f, -1.0f, 0.0f, 1.0f, // Bottom-left
+				1.0f,  -1.0f, 1.0f, 1.0f, // Bottom-right
+				1.0f,  1.0f,  1.0f, 0.0f, // Top-right
+				-1.0f, 1.0f,  0.0f, 0.0f // Top-left
 		};
 		const unsigned int indices[] = {0, 1, 2, 2, 3, 0};
 
@@ -119,45 +211,583 @@ namespace pxe {
 		// Create texture to display the surface's pixels.
 		glGenTextures(1, &textureID);
 		glBindTexture(GL_TEXTURE_2D, textureID);
-		// IMPORTANT: Use GL_RGBA to match the 32-bit RGBA format of the Surface.
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-					 surface->getBuffer().data());
+		// Every upload, including sub-rectangles, reads whole surface rows.
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->getPitch());
+		// IMPORTANT: Use the GL format matching the Surface pixel layout so the driver copies without swizzling.
+		glTexImage2D(GL_TEXTURE_2D, 0, surfaceGLFormat.internalFormat, width, height, 0, surfaceGLFormat.format,
+					 surfaceGLFormat.type, surface->getBuffer().data());
 		// Set texture filtering parameters.
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	}
 
-	void Graphics::compileShader(GLuint &shader, const GLenum type, const char *source) {
-		shader = glCreateShader(type);
-		glShaderSource(shader, 1, &source, nullptr);
-		glCompileShader(shader);
-		// Check for compile errors.
-		GLint success;
-		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-		if (!success) {
-			char infoLog[512];
-			glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-			const std::string shaderType = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
-			throw std::runtime_error("Shader compilation failed (" + shaderType + "): " + infoLog);
+	void Graphics::initFramebuffer() {
+		glGenRenderbuffers(1, &renderbufferID);
+		glBindRenderbuffer(GL_RENDERBUFFER, renderbufferID);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+		glGenFramebuffers(1, &framebufferID);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbufferID);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			throw std::runtime_error("Offscreen framebuffer is incomplete");
 		}
+		// A surfaceless context starts with an empty viewport.
+		glViewport(0, 0, width, height);
 	}
 
 	void Graphics::beginFrame() {
+		frameArena.reset();
 		// Clear the surface (reset pixel buffer for the new frame).
-		surface->clear();
+		if (!retainedMode || tripleBuffering) {
+			surfaces[drawIndex]->clear();
+			if (indexedSurface) {
+				indexedSurface->clear();
+				indexedChanged = true;
+			}
+		}
+		for (const Layer &layer: layers) {
+			if (!layer.retained) {
+				layer.surface->clear();
+			}
+		}
+		spriteBatches[drawIndex].clear();
 	}
 
 	void Graphics::endFrame() {
-		// Clear the screen.
+		Surface &frame = *surfaces[drawIndex];
+		if (pixelShader.source) {
+			// The shader replaces the surface; drop its dirty regions so they do not pile up.
+			frame.takeDirtyRects(dirtyRects);
+			renderPixelShader(pixelShader);
+		} else if (indexedSurface) {
+			frame.takeDirtyRects(dirtyRects);
+			resolvePalette();
+		} else if (layers.empty()) {
+			// Update the texture with the latest pixel data from the Surface.
+			uploadSurface(frame, false);
+		} else if (getLayerCompositing() == LayerCompositing::Gpu) {
+			compositeLayersOnGpu();
+		} else {
+			if (textureContent != TextureContent::Surface) {
+				// Regions dropped while the texture held something else are missing from the composite too.
+				frame.markDirty(frame.getBounds());
+			}
+			compositeChangedLayers();
+			uploadSurface(*compositeSurface, false);
+		}
+		drawDisplayTexture();
+	}
+
+	void Graphics::setTripleBuffering(const bool enabled) {
+		if (enabled == tripleBuffering)
+			return;
+
+		if (enabled && indexedSurface) {
+			throw std::logic_error("Indexed mode does not support triple buffering");
+		}
+		if (enabled && !layers.empty()) {
+			throw std::logic_error("Layers do not support triple buffering");
+		}
+		tripleBuffering = enabled;
+		if (enabled) {
+			for (auto &buffer: surfaces) {
+				if (!buffer) {
+					buffer = std::make_unique<Surface>(width, height, surfacePool);
+				}
+			}
+			frameMailbox.reset();
+			for (auto &batch: spriteBatches) {
+				batch.clear();
+			}
+			drawIndex = FrameMailbox::initialProducerIndex;
+			presentIndex = FrameMailbox::initialConsumerIndex;
+		} else {
+			// Keep drawing to the first surface; it may hold an older frame, so re-upload everything.
+			surfaces[0]->markDirty(surfaces[0]->getBounds());
+			surfaces[1].reset();
+			surfaces[2].reset();
+			drawIndex = presentIndex = 0;
+		}
+		surface = surfaces[drawIndex].get();
+	}
+
+	void Graphics::publishFrame() {
+		publishedShaders[drawIndex] = pixelShader;
+		drawIndex = frameMailbox.publish(drawIndex);
+		surface = surfaces[drawIndex].get();
+	}
+
+	bool Graphics::presentFrame() {
+		const bool acquired = frameMailbox.acquire(presentIndex);
+		if (acquired) {
+			const PixelShaderFrame &shader = publishedShaders[presentIndex];
+			if (shader.source) {
+				renderPixelShader(shader);
+			} else {
+				uploadSurface(*surfaces[presentIndex], true);
+			}
+		}
+		drawDisplayTexture();
+		return acquired;
+	}
+
+	bool Graphics::supportsReadback() const {
+		return target != GraphicsTarget::None && PixelBufferRing::isSupported();
+	}
+
+	void Graphics::captureFrame(FrameCapture &capture) {
+		if (capture.usesGpuReadback()) {
+			capture.captureTexture(textureID);
+		} else if (tripleBuffering) {
+			capture.captureView(surfaces[presentIndex]->getView());
+		} else {
+			capture.captureView(getFrameView());
+		}
+	}
+
+	void Graphics::drawDisplayTexture() {
+		if (target == GraphicsTarget::None)
+			return;
+		GpuTimerQueries *timers = activeGpuTimers();
+		if (timers) {
+			timers->begin(FramePhase::GpuDraw);
+		}
+		// Clear the screen, including the letterbox bars.
 		glClear(GL_COLOR_BUFFER_BIT);
-		// Update the texture with the latest pixel data from the Surface.
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		// Use GL_RGBA here as well.
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, surface->getBuffer().data());
+		const Rect view = getViewport();
+		// GL counts viewport rows from the bottom of the framebuffer.
+		glViewport(view.x, outputHeight - view.bottom(), view.width, view.height);
 		// Render the textured quad to the screen.
-		glUseProgram(shaderProgram);
+		const DisplayProgram &program = displayPrograms[static_cast<size_t>(scalingFilter)];
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glUseProgram(program.program);
+		if (program.sourceSizeLocation >= 0) {
+			glUniform2f(program.sourceSizeLocation, static_cast<float>(width), static_cast<float>(height));
+			glUniform2f(program.scaleLocation, static_cast<float>(view.width) / static_cast<float>(width),
+						static_cast<float>(view.height) / static_cast<float>(height));
+		}
 		glBindVertexArray(VAO);
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		const std::vector<SpriteInstance> &sprites = spriteBatches[tripleBuffering ? presentIndex : drawIndex];
+		if (!sprites.empty() && !view.isEmpty()) {
+			if (!spriteRenderer) {
+				spriteRenderer = std::make_unique<SpriteRenderer>();
+			}
+			spriteRenderer->upload(spriteAtlas);
+			spriteRenderer->draw(sprites, width, height);
+		}
+		if (timers) {
+			timers->end();
+			timers->endFrame(*profiler);
+		}
+		if (target == GraphicsTarget::Framebuffer) {
+			// Nothing swaps buffers offscreen, so submit the frame explicitly.
+			glFlush();
+		}
+	}
+
+	void Graphics::renderPixelShader(const PixelShaderFrame &frame) {
+		auto [entry, inserted] = pixelShaderPrograms.try_emplace(frame.hash);
+		PixelShaderProgram &program = entry->second;
+		if (program.source != frame.source) {
+			// A new shader, or a hash hit on another copy of the source (or, rarely, on another source).
+			if (inserted || *program.source != *frame.source) {
+				GLuint linked;
+				try {
+					linked = linkProgram(vertexShaderSource, frame.source->c_str());
+				} catch (...) {
+					if (inserted) {
+						pixelShaderPrograms.erase(entry);
+					}
+					throw;
+				}
+				glDeleteProgram(program.program);
+				program.program = linked;
+				program.surfaceSizeLocation = glGetUniformLocation(linked, "surfaceSize");
+				program.uniformLocations.clear();
+			}
+			program.source = frame.source;
+		}
+
+		GpuTimerQueries *timers = activeGpuTimers();
+		if (timers) {
+			timers->begin(FramePhase::GpuUpload);
+		}
+		bindTextureFramebuffer();
+		glUseProgram(program.program);
+		glUniform2f(program.surfaceSizeLocation, static_cast<float>(width), static_cast<float>(height));
+		for (const ShaderUniform &uniform: frame.uniforms) {
+			auto [location, added] = program.uniformLocations.try_emplace(uniform.name);
+			if (added) {
+				location->second = glGetUniformLocation(program.program, uniform.name.c_str());
+			}
+			switch (uniform.components) {
+				case 1:
+					glUniform1fv(location->second, 1, uniform.values.data());
+					break;
+				case 2:
+					glUniform2fv(location->second, 1, uniform.values.data());
+					break;
+				case 3:
+					glUniform3fv(location->second, 1, uniform.values.data());
+					break;
+				default:
+					glUniform4fv(location->second, 1, uniform.values.data());
+					break;
+			}
+		}
+		glBindVertexArray(VAO);
+		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		glBindFramebuffer(GL_FRAMEBUFFER, target == GraphicsTarget::Framebuffer ? framebufferID : 0);
+		textureContent = TextureContent::PixelShader;
+		if (timers) {
+			timers->end();
+		}
+	}
+
+	void Graphics::bindTextureFramebuffer() {
+		if (!textureFramebufferID) {
+			glGenFramebuffers(1, &textureFramebufferID);
+			glBindFramebuffer(GL_FRAMEBUFFER, textureFramebufferID);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureID, 0);
+			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+				throw std::runtime_error("Display texture framebuffer is incomplete");
+			}
+		} else {
+			glBindFramebuffer(GL_FRAMEBUFFER, textureFramebufferID);
+		}
+		// Framebuffer row 0 is texture row 0, the top surface row, so gl_FragCoord is in surface coordinates.
+		glViewport(0, 0, width, height);
+		// Nothing may sample the texture being rendered to.
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void Graphics::resolvePalette() {
+		if (!indexedChanged && !paletteChanged && textureContent == TextureContent::Palette)
+			return;
+		if (target == GraphicsTarget::None) {
+			indexedChanged = paletteChanged = false;
+			return;
+		}
+
+		GpuTimerQueries *timers = activeGpuTimers();
+		if (timers) {
+			timers->begin(FramePhase::GpuUpload);
+		}
+		constexpr GLPixelFormat indexFormat = GLPixelFormatOf<Indexed8Format>::value;
+		if (!paletteProgram) {
+			paletteProgram = linkProgram(vertexShaderSource, paletteFragmentShaderSource);
+			glUseProgram(paletteProgram);
+			glUniform1i(glGetUniformLocation(paletteProgram, "indices"), 0);
+			glUniform1i(glGetUniformLocation(paletteProgram, "palette"), 1);
+			GLuint textures[2];
+			glGenTextures(2, textures);
+			indexTextureID = textures[0];
+			paletteTextureID = textures[1];
+			glBindTexture(GL_TEXTURE_2D, indexTextureID);
+			glTexImage2D(GL_TEXTURE_2D, 0, indexFormat.internalFormat, width, height, 0, indexFormat.format,
+						 indexFormat.type, nullptr);
+			glBindTexture(GL_TEXTURE_2D, paletteTextureID);
+			glTexImage2D(GL_TEXTURE_2D, 0, surfaceGLFormat.internalFormat, paletteSize, 1, 0, surfaceGLFormat.format,
+						 surfaceGLFormat.type, nullptr);
+			// texelFetch ignores filtering, but an incomplete mipmap chain would still make the textures unusable.
+			for (const GLuint texture: textures) {
+				glBindTexture(GL_TEXTURE_2D, texture);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			}
+			paletteChanged = true;
+		}
+		if (paletteChanged) {
+			glBindTexture(GL_TEXTURE_2D, paletteTextureID);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, paletteSize, 1, surfaceGLFormat.format, surfaceGLFormat.type,
+							palette.data());
+		}
+		if (indexedChanged) {
+			glBindTexture(GL_TEXTURE_2D, indexTextureID);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, indexedSurface->getPitch());
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, indexFormat.format, indexFormat.type,
+							indexedSurface->data());
+		}
+		// Surface uploads expect the row length of the surface.
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->getPitch());
+
+		// Look every index up in the palette, writing the colors into the display texture.
+		bindTextureFramebuffer();
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, paletteTextureID);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, indexTextureID);
+		glUseProgram(paletteProgram);
+		glBindVertexArray(VAO);
+		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		glBindFramebuffer(GL_FRAMEBUFFER, target == GraphicsTarget::Framebuffer ? framebufferID : 0);
+		textureContent = TextureContent::Palette;
+		indexedChanged = paletteChanged = false;
+		if (timers) {
+			timers->end();
+		}
+	}
+
+	void Graphics::uploadSurface(Surface &source, const bool wholeSurface) {
+		if (wholeSurface || textureContent != TextureContent::Surface) {
+			// The texture may hold another frame or a GPU pass; only a full upload restores this one.
+			textureContent = TextureContent::Surface;
+			dirtyRects.assign(1, source.getBounds());
+		} else {
+			source.takeDirtyRects(dirtyRects);
+		}
+		if (dirtyRects.empty() || target == GraphicsTarget::None)
+			return;
+
+		GpuTimerQueries *timers = activeGpuTimers();
+		if (timers) {
+			timers->begin(FramePhase::GpuUpload);
+		}
+		uploadDirtyRects(source, textureID);
+		if (timers) {
+			timers->end();
+		}
+	}
+
+	void Graphics::uploadDirtyRects(const Surface &source, const GLuint texture) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+		const uint32_t *pixels = source.getBuffer().data();
+		const int pitch = source.getPitch();
+		if (!pixelBufferRing) {
+			for (const Rect &rect: dirtyRects) {
+				glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, surfaceGLFormat.format,
+								surfaceGLFormat.type, pixels + static_cast<size_t>(rect.y) * pitch + rect.x);
+			}
+		} else {
+			// Stage the dirty regions in a slot the GPU is done with, at the same offsets they have in the
+			// surface, then let the driver pull them from the buffer object.
+			auto *staging = static_cast<uint32_t *>(pixelBufferRing->acquire());
+			for (const Rect &rect: dirtyRects) {
+				for (int y = rect.y; y < rect.bottom(); y++) {
+					const size_t offset = static_cast<size_t>(y) * pitch + rect.x;
+					std::memcpy(staging + offset, pixels + offset, rect.width * sizeof(uint32_t));
+				}
+			}
+			for (const Rect &rect: dirtyRects) {
+				const size_t offset = (static_cast<size_t>(rect.y) * pitch + rect.x) * sizeof(uint32_t);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, surfaceGLFormat.format,
+								surfaceGLFormat.type, reinterpret_cast<const void *>(offset));
+			}
+			pixelBufferRing->release();
+		}
+	}
+
+	void Graphics::compositeLayersOnGpu() {
+		GpuTimerQueries *timers = activeGpuTimers();
+		if (timers) {
+			timers->begin(FramePhase::GpuUpload);
+		}
+		if (!layerProgram) {
+			layerProgram = linkProgram(vertexShaderSource, layerFragmentShaderSource);
+			glUseProgram(layerProgram);
+			glUniform1i(glGetUniformLocation(layerProgram, "layer"), 0);
+		}
+		Surface &frame = *surfaces[drawIndex];
+		const Rect bounds{0, 0, width, height};
+		layerRects.clear();
+		if (textureContent != TextureContent::Layers) {
+			layerRects.push_back(bounds);
+		}
+		auto upload = [&](Surface &source, GLuint &texture) {
+			if (!texture) {
+				glGenTextures(1, &texture);
+				glBindTexture(GL_TEXTURE_2D, texture);
+				glTexImage2D(GL_TEXTURE_2D, 0, surfaceGLFormat.internalFormat, width, height, 0,
+							 surfaceGLFormat.format, surfaceGLFormat.type, nullptr);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				source.markDirty(source.getBounds());
+			} else if (textureContent != TextureContent::Layers) {
+				// Dirty regions may have been dropped while the display texture held something else.
+				source.markDirty(source.getBounds());
+			}
+			source.takeDirtyRects(dirtyRects);
+			if (!dirtyRects.empty()) {
+				uploadDirtyRects(source, texture);
+				layerRects.insert(layerRects.end(), dirtyRects.begin(), dirtyRects.end());
+			}
+		};
+		upload(frame, surfaceLayerTextureID);
+		for (Layer &layer: layers) {
+			upload(*layer.surface, layer.textureID);
+		}
+
+		if (!layerRects.empty()) {
+			// Only the changed regions are composited again: the surface is opaque and simply copied, and
+			// every layer above is blended over the result. Overlapping regions are redone from scratch.
+			bindTextureFramebuffer();
+			glUseProgram(layerProgram);
+			glBindVertexArray(VAO);
+			glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			glEnable(GL_SCISSOR_TEST);
+			for (const Rect &region: layerRects) {
+				// The texture framebuffer counts rows from the top surface row, like the rectangles.
+				glScissor(region.x, region.y, region.width, region.height);
+				glBindTexture(GL_TEXTURE_2D, surfaceLayerTextureID);
+				glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+				glEnable(GL_BLEND);
+				for (const Layer &layer: layers) {
+					glBindTexture(GL_TEXTURE_2D, layer.textureID);
+					glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+				}
+				glDisable(GL_BLEND);
+			}
+			glDisable(GL_SCISSOR_TEST);
+			glBindFramebuffer(GL_FRAMEBUFFER, target == GraphicsTarget::Framebuffer ? framebufferID : 0);
+			textureContent = TextureContent::Layers;
+		}
+		if (timers) {
+			timers->end();
+		}
+	}
+
+	void Graphics::compositeChangedLayers() {
+		surfaces[drawIndex]->takeDirtyRects(layerRects);
+		for (Layer &layer: layers) {
+			layer.surface->takeDirtyRects(dirtyRects);
+			layerRects.insert(layerRects.end(), dirtyRects.begin(), dirtyRects.end());
+		}
+		compositeLayers(layerRects);
+	}
+
+	void Graphics::compositeLayers(std::span<const Rect> regions) {
+		const Rect bounds{0, 0, width, height};
+		if (!compositeSurface) {
+			compositeSurface = std::make_unique<Surface>(width, height, surfacePool);
+			regions = {&bounds, 1};
+		}
+		// Regions of different layers may overlap; blending them twice gives the same pixels.
+		const BlitKernels &kernels = blitKernels();
+		const SurfaceView frame = surfaces[drawIndex]->getView();
+		for (const Rect &region: regions) {
+			const SurfaceView composite = compositeSurface->lockRows(region);
+			const auto count = static_cast<size_t>(region.width);
+			for (int y = 0; y < region.height; y++) {
+				uint32_t *dst = composite.row(y);
+				std::memcpy(dst, frame.row(region.y + y) + region.x, count * sizeof(uint32_t));
+				for (const Layer &layer: layers) {
+					kernels.blendRow(dst, layer.surface->getView().row(region.y + y) + region.x, count);
+				}
+			}
+		}
+	}
+
+	GpuTimerQueries *Graphics::activeGpuTimers() {
+		if (!profiler || !profiler->isEnabled())
+			return nullptr;
+		if (!gpuTimers) {
+			gpuTimers = std::make_unique<GpuTimerQueries>();
+		}
+		return gpuTimers.get();
+	}
+
+	void Graphics::setOutputSize(const int width, const int height) {
+		outputWidth = std::max(width, 0);
+		outputHeight = std::max(height, 0);
+	}
+
+	void Graphics::setScalingFilter(const ScalingFilter filter) {
+		if (filter == scalingFilter)
+			return;
+
+		scalingFilter = filter;
+		if (target != GraphicsTarget::None) {
+			const GLint sampling = filter == ScalingFilter::IntegerNearest ? GL_NEAREST : GL_LINEAR;
+			glBindTexture(GL_TEXTURE_2D, textureID);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampling);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampling);
+		}
+	}
+
+	ScalingFilter Graphics::getScalingFilter() const { return scalingFilter; }
+
+	Rect Graphics::getViewport() const {
+		// Fitted to the full size, so a dynamically scaled surface is stretched into the same rectangle.
+		return fitViewport(outputWidth, outputHeight, fullWidth, fullHeight,
+						   scalingFilter == ScalingFilter::IntegerNearest);
+	}
+
+	void Graphics::resize(const int width, const int height) {
+		if (width <= 0 || height <= 0) {
+			throw std::invalid_argument("Surface size must be positive");
+		}
+		if (tripleBuffering) {
+			throw std::logic_error("Cannot resize the surface while triple buffering");
+		}
+		if (width == this->width && height == this->height)
+			return;
+
+		this->width = width;
+		this->height = height;
+		// Release the old surface first, so the pool can hand its buffer straight back when the size class matches.
+		surfaces[0].reset();
+		surfaces[0] = std::make_unique<Surface>(width, height, surfacePool);
+		surface = surfaces[0].get(); // Starts cleared and entirely dirty.
+		for (Layer &layer: layers) {
+			layer.surface.reset();
+			layer.surface = std::make_unique<Surface>(width, height, surfacePool, Color::Transparent);
+		}
+		if (drawLayer > 0) {
+			surface = layers[drawLayer - 1].surface.get();
+		}
+		compositeSurface.reset();
+		if (indexedSurface) {
+			indexedSurface.reset();
+			indexedSurface = std::make_unique<IndexedSurface>(width, height, surfacePool);
+			indexedChanged = true;
+		}
+		if (target == GraphicsTarget::None)
+			return;
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glTexImage2D(GL_TEXTURE_2D, 0, surfaceGLFormat.internalFormat, width, height, 0, surfaceGLFormat.format,
+					 surfaceGLFormat.type, nullptr);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->getPitch());
+		// Layer textures are recreated, at the new size, by their next upload.
+		for (Layer &layer: layers) {
+			glDeleteTextures(1, &layer.textureID);
+			layer.textureID = 0;
+		}
+		glDeleteTextures(1, &surfaceLayerTextureID);
+		surfaceLayerTextureID = 0;
+		if (indexTextureID) {
+			constexpr GLPixelFormat indexFormat = GLPixelFormatOf<Indexed8Format>::value;
+			glBindTexture(GL_TEXTURE_2D, indexTextureID);
+			glTexImage2D(GL_TEXTURE_2D, 0, indexFormat.internalFormat, width, height, 0, indexFormat.format,
+						 indexFormat.type, nullptr);
+		}
+		if (pixelBufferRing) {
+			pixelBufferRing = std::make_unique<PixelBufferRing>(surface->getBuffer().size() * sizeof(uint32_t));
+		}
+	}
+
+	void Graphics::setProfiler(FrameProfiler *profiler) { this->profiler = profiler; }
+
+	void Graphics::clear() { surface->clear(); }
+
+	void Graphics::setRetainedMode(const bool retained) { retainedMode = retained; }
+
+	bool Graphics::isRetainedMode() const { return retainedMode; }
+
+	void Graphics::setUploadMode(const UploadMode mode) {
+		if (mode == getUploadMode())
+			return;
+
+		pixelBufferRing.reset();
+		if (mode == UploadMode::PixelBufferRing && target != GraphicsTarget::None && PixelBufferRing::isSupported()) {
+			pixelBufferRing = std::make_unique<PixelBufferRing>(surface->getBuffer().size() * sizeof(uint32_t));
+		}
+	}
+
+	UploadMode Graphics::getUploadMode() const {
+		return pixelBufferRing ? UploadMode::PixelBufferRing : UploadMode::Direct;
 	}
 
 	void Graphics::setPixel(const int x, const int y, const int r, const int g, const int b) {
@@ -170,6 +800,184 @@ namespace pxe {
 		surface->setPixel(x, y, color);
 	}
 
+	void Graphics::drawSpan(const int x, const int y, const std::span<const Color> colors) {
+		surface->drawSpan(x, y, colors);
+	}
+
+	void Graphics::fillRect(const Rect &region, const Color color) { surface->fillRect(region, color); }
+
+	void Graphics::drawLine(const Line &line, const Color color) { surface->drawLine(line, color); }
+
+	void Graphics::drawLines(const std::span<const Line> lines, const Color color) { surface->drawLines(lines, color); }
+
+	void Graphics::drawRect(const Rect &region, const Color color) { surface->drawRect(region, color); }
+
+	void Graphics::drawCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		surface->drawCircle(centerX, centerY, radius, color);
+	}
+
+	void Graphics::fillCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		surface->fillCircle(centerX, centerY, radius, color);
+	}
+
+	void Graphics::drawTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+								const Color color) {
+		surface->drawTriangle(x0, y0, x1, y1, x2, y2, color);
+	}
+
+	void Graphics::fillTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+								const Color color) {
+		surface->fillTriangle(x0, y0, x1, y1, x2, y2, color);
+	}
+
+	void Graphics::blit(const Image &image, const Rect &sourceRegion, const int x, const int y, const BlendMode mode) {
+		surface->blit(image, sourceRegion, x, y, mode);
+	}
+
+	SpriteId Graphics::addSprite(const Image &image) { return spriteAtlas.add(image); }
+
+	void Graphics::drawSprite(const SpriteId sprite, const SpriteTransform &transform) {
+		const Rect &region = spriteAtlas.getRegion(sprite);
+		constexpr float texel = 1.0f / SpriteAtlas::size;
+		spriteBatches[drawIndex].push_back(
+				{transform.x, transform.y, static_cast<float>(region.width) * transform.scaleX,
+				 static_cast<float>(region.height) * transform.scaleY, static_cast<float>(region.x) * texel,
+				 static_cast<float>(region.y) * texel, static_cast<float>(region.right()) * texel,
+				 static_cast<float>(region.bottom()) * texel, transform.rotation, transform.tint.pixel()});
+	}
+
+	void Graphics::setIndexedMode(const bool enabled) {
+		if (enabled == isIndexedMode())
+			return;
+		if (enabled && tripleBuffering) {
+			throw std::logic_error("Indexed mode does not support triple buffering");
+		}
+
+		if (enabled) {
+			indexedSurface = std::make_unique<IndexedSurface>(width, height, surfacePool);
+			indexedChanged = true;
+		} else {
+			indexedSurface.reset();
+		}
+	}
+
+	bool Graphics::isIndexedMode() const { return indexedSurface != nullptr; }
+
+	IndexedSurface &Graphics::lockIndexedSurface() {
+		if (!indexedSurface) {
+			throw std::logic_error("Indexed mode is not enabled");
+		}
+		indexedChanged = true;
+		return *indexedSurface;
+	}
+
+	void Graphics::setPalette(const int first, const std::span<const Color> colors) {
+		if (first < 0 || first > paletteSize || colors.size() > static_cast<size_t>(paletteSize - first)) {
+			throw std::out_of_range("Palette entries must lie within [0, 256)");
+		}
+		std::ranges::transform(colors, palette.begin() + first, &Color::pixel);
+		paletteChanged = true;
+	}
+
+	int Graphics::addLayer(const bool retained) {
+		if (tripleBuffering) {
+			throw std::logic_error("Layers do not support triple buffering");
+		}
+		// The new layer starts entirely dirty, so the next frame blends it in.
+		layers.push_back({std::make_unique<Surface>(width, height, surfacePool, Color::Transparent), retained});
+		return static_cast<int>(layers.size());
+	}
+
+	void Graphics::removeLayers() {
+		if (layers.empty())
+			return;
+		if (target != GraphicsTarget::None) {
+			for (const Layer &layer: layers) {
+				glDeleteTextures(1, &layer.textureID);
+			}
+		}
+		layers.clear();
+		compositeSurface.reset();
+		drawLayer = 0;
+		surface = surfaces[0].get();
+		// Some of its dirty regions only went into the composite.
+		surface->markDirty(surface->getBounds());
+	}
+
+	void Graphics::setDrawLayer(const int layer) {
+		if (layer < 0 || layer > static_cast<int>(layers.size())) {
+			throw std::out_of_range("No such layer");
+		}
+		drawLayer = layer;
+		surface = layer == 0 ? surfaces[drawIndex].get() : layers[layer - 1].surface.get();
+	}
+
+	int Graphics::getDrawLayer() const { return drawLayer; }
+
+	int Graphics::getLayerCount() const { return static_cast<int>(layers.size()) + 1; }
+
+	void Graphics::setLayerCompositing(const LayerCompositing compositing) {
+		if (compositing == layerCompositing)
+			return;
+		layerCompositing = compositing;
+		if (target == GraphicsTarget::None)
+			return;
+		// Each path consumed the dirty regions the other one needs, so start both from scratch.
+		surfaces[drawIndex]->markDirty(surfaces[drawIndex]->getBounds());
+		for (const Layer &layer: layers) {
+			layer.surface->markDirty(layer.surface->getBounds());
+		}
+	}
+
+	LayerCompositing Graphics::getLayerCompositing() const {
+		return target == GraphicsTarget::None ? LayerCompositing::Cpu : layerCompositing;
+	}
+
+	void Graphics::setPixelShader(const std::string &source) {
+		if (target == GraphicsTarget::None) {
+			throw std::logic_error("Pixel shaders need an OpenGL backend");
+		}
+		if (source.empty()) {
+			pixelShader.source.reset();
+		} else if (!pixelShader.source || *pixelShader.source != source) {
+			pixelShader.source = std::make_shared<const std::string>(source);
+			pixelShader.hash = std::hash<std::string>{}(source);
+		}
+	}
+
+	void Graphics::setShaderUniform(const std::string &name, const std::span<const float> values) {
+		if (values.empty() || values.size() > 4) {
+			throw std::invalid_argument("Shader uniforms have one to four components");
+		}
+		auto uniform = std::ranges::find(pixelShader.uniforms, name, &ShaderUniform::name);
+		if (uniform == pixelShader.uniforms.end()) {
+			uniform = pixelShader.uniforms.insert(uniform, {name});
+		}
+		std::ranges::copy(values, uniform->values.begin());
+		uniform->components = values.size();
+	}
+
+	SurfaceView Graphics::lockRows(const Rect &region) { return surface->lockRows(region); }
+
+	Surface &Graphics::getSurface() { return *surface; }
+
+	SurfaceView Graphics::getFrameView() {
+		if (layers.empty() || tripleBuffering)
+			return surface->getView();
+		if (getLayerCompositing() == LayerCompositing::Cpu) {
+			compositeChangedLayers();
+		} else {
+			// The layers' dirty regions belong to their textures, so blend everything.
+			const Rect bounds{0, 0, width, height};
+			compositeLayers({&bounds, 1});
+		}
+		return compositeSurface->getView();
+	}
+
+	FrameArena &Graphics::getFrameArena() { return frameArena; }
+
+	SurfacePool &Graphics::getSurfacePool() { return surfacePool; }
+
 	int Graphics::getWidth() const { return width; }
 
 	int Graphics::getHeight() const { return height; }
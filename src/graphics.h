@@ -17,11 +17,35 @@
  */
 
 #pragma once
+#include <array>
 #include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "basicSurface.h"
+#include "frameCapture.h"
+#include "frameMailbox.h"
+#include "frameProfiler.h"
+#include "gpuTimer.h"
 #include "openGLContext.h"
+#include "pixelBufferRing.h"
+#include "renderSettings.h"
+#include "spriteAtlas.h"
+#include "spriteRenderer.h"
 #include "surface.h"
+#include "surfaceAllocator.h"
 
 namespace pxe {
+	/**
+	 * @brief Where Graphics presents the surface.
+	 */
+	enum class GraphicsTarget {
+		Window, ///< The default framebuffer of the current window's context.
+		Framebuffer, ///< A framebuffer object of the surface size, for contexts without a window.
+		None, ///< No OpenGL at all; only the CPU surfaces exist.
+	};
+
 	/**
 	 * @brief Handles OpenGL-based rendering and manages the rendering pipeline.
 	 */
@@ -31,8 +55,10 @@ namespace pxe {
 		 * @brief Constructs a Graphics object and initializes OpenGL resources.
 		 * @param width Width of the rendering area.
 		 * @param height Height of the rendering area.
+		 * @param target Where frames are presented; with `GraphicsTarget::None` no OpenGL call is ever made.
+		 * @param loader Function loader of the current context, used to initialize GLAD. Ignored without OpenGL.
 		 */
-		Graphics(int width, int height);
+		Graphics(int width, int height, GraphicsTarget target, GLADloadproc loader);
 
 		/**
 		 * @brief Destructor that cleans up OpenGL resources.
@@ -40,15 +66,285 @@ namespace pxe {
 		~Graphics();
 
 		/**
-		 * @brief Begins a new frame by clearing the surface.
+		 * @brief Begins a new frame by clearing the surface, unless retained mode is enabled.
 		 */
 		void beginFrame();
 
 		/**
-		 * @brief Finalizes the frame and updates the OpenGL texture.
+		 * @brief Finalizes the frame, uploading only the dirty regions of the surface to the OpenGL texture.
 		 */
 		void endFrame();
 
+		/**
+		 * @brief Enables or disables triple buffering for a decoupled simulation thread.
+		 *
+		 * With triple buffering the drawing calls target a back surface that the simulation thread hands
+		 * over with `publishFrame()`, while the thread owning the GL context displays the latest published
+		 * surface with `presentFrame()`. Retained mode is ignored while triple buffering is enabled, since
+		 * each surface would otherwise keep a frame that is three frames old.
+		 * @param enabled True to use three surfaces.
+		 */
+		void setTripleBuffering(bool enabled);
+
+		/**
+		 * @brief Hands the completed back surface to the presenting thread and starts drawing to a free one.
+		 *
+		 * Only valid with triple buffering. Does not touch OpenGL, so it may run on any single thread.
+		 */
+		void publishFrame();
+
+		/**
+		 * @brief Uploads the most recently published surface, if any, and draws the display texture.
+		 *
+		 * Only valid with triple buffering; must run on the thread owning the GL context.
+		 * @return True if a newly published surface was uploaded.
+		 */
+		bool presentFrame();
+
+		/**
+		 * @brief Checks whether frames can be captured from the display texture with GPU readback.
+		 */
+		[[nodiscard]] bool supportsReadback() const;
+
+		/**
+		 * @brief Hands the frame on display to a capture.
+		 *
+		 * Reads the display texture back when the capture uses GPU readback, and copies the displayed
+		 * surface otherwise. Call after `endFrame()` or after a `presentFrame()` that returned true.
+		 * @param capture The capture receiving the frame.
+		 */
+		void captureFrame(FrameCapture &capture);
+
+		/**
+		 * @brief Copies a horizontal run of pixels into the surface.
+		 * @param x X-coordinate of the first pixel.
+		 * @param y Y-coordinate of the row.
+		 * @param colors The colors to store, left to right.
+		 */
+		void drawSpan(int x, int y, std::span<const Color> colors);
+
+		/**
+		 * @brief Fills a rectangle of the surface with a solid color.
+		 * @param region The rectangle to fill.
+		 * @param color The fill color.
+		 */
+		void fillRect(const Rect &region, Color color);
+
+		/**
+		 * @brief Draws a clipped line on the surface.
+		 * @param line The segment to draw.
+		 * @param color The line color.
+		 */
+		void drawLine(const Line &line, Color color);
+
+		/**
+		 * @brief Draws a batch of clipped lines sharing one color.
+		 * @param lines The segments to draw.
+		 * @param color The line color.
+		 */
+		void drawLines(std::span<const Line> lines, Color color);
+
+		/**
+		 * @brief Draws the outline of a rectangle.
+		 * @param region The rectangle to outline.
+		 * @param color The outline color.
+		 */
+		void drawRect(const Rect &region, Color color);
+
+		/**
+		 * @brief Draws the outline of a circle.
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The outline color.
+		 */
+		void drawCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Fills a circle.
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The fill color.
+		 */
+		void fillCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Draws the outline of a triangle.
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The outline color.
+		 */
+		void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Fills a triangle.
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The fill color.
+		 */
+		void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Draws a region of an image onto the surface.
+		 * @param image The image to draw.
+		 * @param sourceRegion The region of `image` to draw.
+		 * @param x X-coordinate of the region's top-left corner on the surface.
+		 * @param y Y-coordinate of the region's top-left corner on the surface.
+		 * @param mode How image pixels are combined with the surface.
+		 */
+		void blit(const Image &image, const Rect &sourceRegion, int x, int y, BlendMode mode);
+
+		/**
+		 * @brief Adds an image to the sprite atlas; it is uploaded the next time sprites are drawn.
+		 * @param image The sprite, with premultiplied alpha.
+		 * @return The handle to pass to `drawSprite`.
+		 */
+		SpriteId addSprite(const Image &image);
+
+		/**
+		 * @brief Queues a sprite for the GPU batch composited over the surface when the frame is displayed.
+		 *
+		 * Sprites are immediate mode: each frame draws the sprites queued since its `beginFrame()`.
+		 * @param sprite A handle returned by `addSprite`.
+		 * @param transform Where and how to draw it.
+		 * @throws std::out_of_range if the handle is unknown.
+		 */
+		void drawSprite(SpriteId sprite, const SpriteTransform &transform);
+
+		/**
+		 * @brief Enables or disables the 8-bit palette mode.
+		 *
+		 * In indexed mode the frame is an `IndexedSurface` of palette indices instead of the 32-bit surface:
+		 * `beginFrame()` clears it to index 0 (unless retained mode is on), and the frame it holds is uploaded
+		 * to a `GL_R8` texture and resolved through a 256-entry palette texture on the GPU. That moves a
+		 * quarter of the bytes, and an unchanged frame only uploads the palette when it changes. The 32-bit
+		 * surface, and what is drawn on it, is not displayed; sprites still are. Not available with triple
+		 * buffering. Enabling starts from a cleared indexed surface; the palette is kept.
+		 * @param enabled True to display the indexed surface.
+		 * @throws std::logic_error when enabling while triple buffering.
+		 */
+		void setIndexedMode(bool enabled);
+
+		/**
+		 * @brief Checks whether indexed mode is enabled.
+		 */
+		[[nodiscard]] bool isIndexedMode() const;
+
+		/**
+		 * @brief Gets the indexed surface for drawing, marking it for upload at the end of the frame.
+		 *
+		 * The reference stays valid until indexed mode is disabled or the surface is resized.
+		 * @throws std::logic_error outside indexed mode.
+		 */
+		[[nodiscard]] IndexedSurface &lockIndexedSurface();
+
+		/**
+		 * @brief Replaces a run of palette entries; only the 1 KB palette is uploaded for the next frame.
+		 *
+		 * Valid in every mode; a grayscale ramp (index `i` is `Color(i, i, i)`) until set.
+		 * @param first Index of the first entry to replace.
+		 * @param colors The new colors.
+		 * @throws std::out_of_range if the entries do not lie within [0, 256).
+		 */
+		void setPalette(int first, std::span<const Color> colors);
+
+		/**
+		 * @brief Adds a layer on top of the stack, composited over the layers below when the frame is displayed.
+		 *
+		 * Layer 0 is the surface itself, the opaque bottom of the stack. Added layers start transparent and
+		 * hold premultiplied pixels, blended over what is below them. Each layer keeps its own dirty state, so
+		 * a layer nothing was drawn to costs neither an upload nor a blend: a static background is drawn once
+		 * and kept. Layers are not displayed in indexed mode or with a pixel shader, and are not available
+		 * with triple buffering; `resize` clears them.
+		 * @param retained True to keep the layer's pixels across frames; otherwise `beginFrame()` clears it,
+		 * rewriting only the tiles drawn to.
+		 * @return The index of the new layer, for `setDrawLayer`.
+		 * @throws std::logic_error while triple buffering.
+		 */
+		int addLayer(bool retained);
+
+		/**
+		 * @brief Removes every added layer, drawing to and displaying the surface alone again.
+		 */
+		void removeLayers();
+
+		/**
+		 * @brief Selects the layer the drawing calls, `lockRows` and `clear` target.
+		 * @param layer 0 for the surface, or an index returned by `addLayer`.
+		 * @throws std::out_of_range if there is no such layer.
+		 */
+		void setDrawLayer(int layer);
+
+		/**
+		 * @brief Gets the layer the drawing calls target.
+		 */
+		[[nodiscard]] int getDrawLayer() const;
+
+		/**
+		 * @brief Gets the number of layers, including the surface; 1 until a layer is added.
+		 */
+		[[nodiscard]] int getLayerCount() const;
+
+		/**
+		 * @brief Selects where the layers are blended; ignored without OpenGL, which always blends on the CPU.
+		 */
+		void setLayerCompositing(LayerCompositing compositing);
+
+		/**
+		 * @brief Gets where the layers are actually blended.
+		 */
+		[[nodiscard]] LayerCompositing getLayerCompositing() const;
+
+		/**
+		 * @brief Computes the display texture with a GLSL fragment shader instead of uploading the surface.
+		 *
+		 * While a shader is set, every displayed frame runs it once per surface pixel into the display
+		 * texture and the surface is neither uploaded nor shown; sprites are still composited on top. The
+		 * shader is a complete `#version 330 core` fragment shader writing `out vec4 FragColor`;
+		 * `gl_FragCoord.xy` is the pixel center in surface coordinates (y down) and the engine sets
+		 * `uniform vec2 surfaceSize`. Programs are compiled on first display, on the thread owning the GL
+		 * context, and cached by source hash, so switching between shaders only compiles each once.
+		 * Does not touch OpenGL itself, so it may be called from the drawing thread.
+		 * @param source The fragment shader source, or an empty string to display the surface again.
+		 * @throws std::logic_error without OpenGL (`GraphicsTarget::None`).
+		 */
+		void setPixelShader(const std::string &source);
+
+		/**
+		 * @brief Sets a `float` or `vecN` uniform of the pixel shaders for this and the following frames.
+		 *
+		 * Values persist across frames and shader changes; uniforms a shader does not declare are ignored.
+		 * @param name The uniform name.
+		 * @param values One to four components.
+		 * @throws std::invalid_argument for zero or more than four components.
+		 */
+		void setShaderUniform(const std::string &name, std::span<const float> values);
+
+		/**
+		 * @brief Locks a region of the surface for direct writes.
+		 * @param region The region to lock; it is clipped to the surface.
+		 * @return A row-pitched view over the clipped region.
+		 */
+		[[nodiscard]] SurfaceView lockRows(const Rect &region);
+
+		/**
+		 * @brief Clears the surface to opaque black.
+		 */
+		void clear();
+
+		/**
+		 * @brief Enables or disables retained mode.
+		 *
+		 * In retained mode `beginFrame()` no longer clears the surface, so pixels persist across frames
+		 * and only what is redrawn has to be uploaded again.
+		 * @param retained True to keep the surface contents between frames.
+		 */
+		void setRetainedMode(bool retained);
+
+		/**
+		 * @brief Checks whether retained mode is enabled.
+		 */
+		[[nodiscard]] bool isRetainedMode() const;
+
 		/**
 		 * @brief Places a pixel at the specified coordinates with the given color.
 		 * @param x X-coordinate of the pixel.
@@ -67,6 +363,89 @@ namespace pxe {
 		 */
 		void setPixel(int x, int y, Color color);
 
+		/**
+		 * @brief Selects how the surface is uploaded to the display texture.
+		 *
+		 * Requesting `UploadMode::PixelBufferRing` on a context without GL_ARB_buffer_storage keeps the
+		 * direct upload path; use `getUploadMode()` to find out which mode is active.
+		 * @param mode The requested upload mode.
+		 */
+		void setUploadMode(UploadMode mode);
+
+		/**
+		 * @brief Gets the upload mode that is actually in use.
+		 */
+		[[nodiscard]] UploadMode getUploadMode() const;
+
+		/**
+		 * @brief Sets the size of the framebuffer the surface is scaled into, e.g. after the window was resized.
+		 *
+		 * Defaults to the surface size. Must run on the thread owning the GL context.
+		 * @param width Framebuffer width in pixels.
+		 * @param height Framebuffer height in pixels.
+		 */
+		void setOutputSize(int width, int height);
+
+		/**
+		 * @brief Selects how the surface is scaled to the output. Must run on the thread owning the GL context.
+		 */
+		void setScalingFilter(ScalingFilter filter);
+
+		/**
+		 * @brief Gets the active scaling filter.
+		 */
+		[[nodiscard]] ScalingFilter getScalingFilter() const;
+
+		/**
+		 * @brief Gets where the surface is displayed, in output pixels from the top-left corner.
+		 *
+		 * The rectangle is fitted to the size the surface was created with, so it does not move when
+		 * `resize` scales the surface; a smaller surface is stretched into it.
+		 */
+		[[nodiscard]] Rect getViewport() const;
+
+		/**
+		 * @brief Replaces the surface with a cleared one of another size, e.g. for dynamic resolution.
+		 *
+		 * Not available with triple buffering. Call between frames on the thread owning the GL context.
+		 * @param width New surface width.
+		 * @param height New surface height.
+		 * @throws std::invalid_argument if a size is not positive.
+		 * @throws std::logic_error while triple buffering.
+		 */
+		void resize(int width, int height);
+
+		/**
+		 * @brief Attaches the profiler that receives GPU timings of the upload and draw.
+		 *
+		 * Timer queries are only issued while the profiler is enabled.
+		 * @param profiler The profiler, or null to detach it.
+		 */
+		void setProfiler(FrameProfiler *profiler);
+
+		/**
+		 * @brief Gets the surface the drawing calls currently target, that of the draw layer.
+		 */
+		[[nodiscard]] Surface &getSurface();
+
+		/**
+		 * @brief Gets a view of the frame currently drawn, without marking anything dirty.
+		 *
+		 * With layers, this is their composite, blended on the CPU first; with GPU compositing that is a
+		 * whole-frame blend on every call, so only frame callbacks and captures without readback use it.
+		 */
+		[[nodiscard]] SurfaceView getFrameView();
+
+		/**
+		 * @brief Gets the arena for scratch surfaces of the frame being drawn; `beginFrame()` resets it.
+		 */
+		[[nodiscard]] FrameArena &getFrameArena();
+
+		/**
+		 * @brief Gets the pool the engine's own surfaces are allocated from, also open to offscreen buffers.
+		 */
+		[[nodiscard]] SurfacePool &getSurfacePool();
+
 		/**
 		 * @brief Gets the graphics surface width.
 		 */
@@ -78,25 +457,177 @@ namespace pxe {
 		[[nodiscard]] int getHeight() const;
 
 	private:
+		/**
+		 * @brief A display shader for one `ScalingFilter`.
+		 */
+		struct DisplayProgram {
+			GLuint program = 0;
+			GLint sourceSizeLocation = -1; /**< `sourceSize` uniform, -1 if the filter does not use it. */
+			GLint scaleLocation = -1; /**< `scale` uniform: output pixels per surface pixel. */
+		};
+
+		/**
+		 * @brief A pixel shader uniform value.
+		 */
+		struct ShaderUniform {
+			std::string name;
+			std::array<float, 4> values{};
+			size_t components = 0; /**< Number of used `values`, 1 to 4. */
+		};
+
+		/**
+		 * @brief The pixel shader of one frame and the uniform values set while drawing it.
+		 */
+		struct PixelShaderFrame {
+			std::shared_ptr<const std::string> source; /**< Null when the surface is displayed instead. */
+			size_t hash = 0; /**< Hash of `*source`, the key in `pixelShaderPrograms`. */
+			std::vector<ShaderUniform> uniforms;
+		};
+
+		/**
+		 * @brief A compiled pixel shader.
+		 */
+		struct PixelShaderProgram {
+			GLuint program = 0;
+			std::shared_ptr<const std::string> source; /**< Source compiled, compared on hash hits. */
+			GLint surfaceSizeLocation = -1;
+			std::unordered_map<std::string, GLint> uniformLocations; /**< Looked up on first use. */
+		};
+
+		/**
+		 * @brief A layer above the surface.
+		 */
+		struct Layer {
+			std::unique_ptr<Surface> surface; /**< Transparent when cleared. */
+			bool retained = false; /**< Kept across frames instead of cleared by `beginFrame()`. */
+			GLuint textureID = 0; /**< Texture of the layer for GPU compositing, created on first upload. */
+		};
+
+		/**
+		 * @brief What the display texture currently holds.
+		 */
+		enum class TextureContent {
+			Surface, ///< Uploaded surface pixels; dirty regions are enough to bring it up to date.
+			PixelShader, ///< Output of a pixel shader.
+			Palette, ///< The indexed surface resolved through the palette.
+			Layers, ///< The layer textures blended on the GPU.
+		};
+
+		static constexpr int paletteSize = 256;
+
 		int width, height; /**< Width and height of the rendering area. */
-		std::unique_ptr<Surface> surface; /**< Encapsulated surface that stores pixel data. */
+		int fullWidth, fullHeight; /**< Size at construction; the viewport keeps it whatever `resize` sets. */
+		int outputWidth, outputHeight; /**< Size of the framebuffer the surface is scaled into. */
+		ScalingFilter scalingFilter = ScalingFilter::IntegerNearest;
+		SurfacePool surfacePool; /**< Recycles surface buffers across resizes; declared first, destroyed last. */
+		FrameArena frameArena; /**< Scratch memory of the frame being drawn. */
+		std::array<std::unique_ptr<Surface>, 3> surfaces; /**< Surfaces; only the first unless triple buffered. */
+		Surface *surface; /**< Surface the drawing calls currently target. */
+		FrameMailbox frameMailbox; /**< Exchanges surfaces between the drawing and presenting threads. */
+		int drawIndex = 0; /**< Index in `surfaces` of the surface being drawn. */
+		int presentIndex = 0; /**< Index in `surfaces` of the surface on display. */
+		bool tripleBuffering = false;
+		FrameProfiler *profiler = nullptr; /**< Receives GPU timings; not owned. */
+		std::unique_ptr<GpuTimerQueries> gpuTimers; /**< Created the first time the profiler is enabled. */
+		GraphicsTarget target; /**< Where frames are presented. */
+		GLuint framebufferID{}; /**< Offscreen framebuffer with `GraphicsTarget::Framebuffer`. */
+		GLuint renderbufferID{}; /**< Color attachment of the offscreen framebuffer. */
 		GLuint textureID{}; /**< OpenGL texture ID used for rendering. */
 		GLuint VAO{}; /**< Vertex Array Object. */
 		GLuint VBO{}; /**< Vertex Buffer Object. */
 		GLuint EBO{}; /**< Element Buffer Object. */
-		GLuint shaderProgram{}; /**< OpenGL shader program. */
+		std::array<DisplayProgram, 3> displayPrograms{}; /**< Display shaders, indexed by `ScalingFilter`. */
+		std::unique_ptr<PixelBufferRing> pixelBufferRing; /**< Streaming upload ring, null in direct mode. */
+		std::vector<Rect> dirtyRects; /**< Regions uploaded this frame, kept to reuse its allocation. */
+		SpriteAtlas spriteAtlas; /**< Sprite images and their atlas placement. */
+		std::array<std::vector<SpriteInstance>, 3> spriteBatches; /**< Queued sprites, one list per surface. */
+		std::unique_ptr<SpriteRenderer> spriteRenderer; /**< Created the first time sprites are displayed. */
+		bool retainedMode = false; /**< Skips the automatic clear in `beginFrame()` when set. */
+		PixelShaderFrame pixelShader; /**< Pixel shader state of the frame being drawn. */
+		std::array<PixelShaderFrame, 3> publishedShaders; /**< Pixel shader state per published surface. */
+		std::unordered_map<size_t, PixelShaderProgram> pixelShaderPrograms; /**< Compiled shaders by source hash. */
+		GLuint textureFramebufferID{}; /**< Framebuffer with the display texture attached, for GPU passes. */
+		TextureContent textureContent = TextureContent::Surface;
+		std::unique_ptr<IndexedSurface> indexedSurface; /**< Frame of palette indices, null outside indexed mode. */
+		std::array<uint32_t, paletteSize> palette{}; /**< Palette entries as packed `Color` pixels. */
+		bool indexedChanged = false; /**< The indexed surface was written since its last upload. */
+		bool paletteChanged = false; /**< The palette was written since its last upload. */
+		GLuint indexTextureID{}; /**< `GL_R8` copy of the indexed surface, created on first use. */
+		GLuint paletteTextureID{}; /**< 256x1 palette texture. */
+		GLuint paletteProgram{}; /**< Resolves the indices into the display texture. */
+		std::vector<Layer> layers; /**< Layers above the surface, bottom to top; empty without layers. */
+		int drawLayer = 0; /**< Layer the drawing calls target; 0 is the surface. */
+		LayerCompositing layerCompositing = LayerCompositing::Gpu; /**< Requested compositing. */
+		std::unique_ptr<Surface> compositeSurface; /**< CPU composite of the layers, created on first use. */
+		std::vector<Rect> layerRects; /**< Regions changed in any layer, kept to reuse its allocation. */
+		GLuint surfaceLayerTextureID{}; /**< Texture of the surface for GPU compositing. */
+		GLuint layerProgram{}; /**< Copies one layer texture into the display texture. */
 
 		/**
 		 * @brief Initializes OpenGL settings and resources.
 		 */
-		void initOpenGL();
+		void initOpenGL(GLADloadproc loader);
+
+		/**
+		 * @brief Creates and binds the offscreen framebuffer drawn to instead of a window.
+		 */
+		void initFramebuffer();
+
+		/**
+		 * @brief Copies the dirty regions of a surface into the display texture using the active upload mode.
+		 * @param source The surface to upload.
+		 * @param wholeSurface Uploads every pixel regardless of the dirty state, e.g. when the texture holds
+		 * another surface's frame.
+		 */
+		void uploadSurface(Surface &source, bool wholeSurface);
+
+		/**
+		 * @brief Uploads the dirty regions of a surface, left in `dirtyRects`, into a texture of the surface size.
+		 */
+		void uploadDirtyRects(const Surface &source, GLuint texture);
+
+		/**
+		 * @brief Uploads what changed in each layer to its texture and blends the textures into the display
+		 * texture; does nothing if no layer changed and the texture already holds them.
+		 */
+		void compositeLayersOnGpu();
+
+		/**
+		 * @brief Blends the layers into `compositeSurface` within the given regions, marking them dirty there.
+		 */
+		void compositeLayers(std::span<const Rect> regions);
+
+		/**
+		 * @brief Takes the dirty regions of every layer into `layerRects` and blends the layers there.
+		 */
+		void compositeChangedLayers();
+
+		/**
+		 * @brief Runs a pixel shader over the display texture, compiling it first if it is not cached yet.
+		 * @param frame The shader and uniforms of the frame to display.
+		 * @throws std::runtime_error with the driver's log if the shader does not compile.
+		 */
+		void renderPixelShader(const PixelShaderFrame &frame);
+
+		/**
+		 * @brief Uploads what changed of the indexed surface and the palette and resolves them into the display
+		 * texture; does nothing if neither changed and the texture already holds them.
+		 */
+		void resolvePalette();
+
+		/**
+		 * @brief Binds the framebuffer rendering into the display texture, with a viewport of the surface size.
+		 */
+		void bindTextureFramebuffer();
+
+		/**
+		 * @brief Draws the display texture into the viewport and composites the displayed frame's sprites.
+		 */
+		void drawDisplayTexture();
 
 		/**
-		 * @brief Compiles a shader from source code.
-		 * @param shader Reference to the shader ID.
-		 * @param type Shader type (e.g., GL_VERTEX_SHADER, GL_FRAGMENT_SHADER).
-		 * @param source Shader source code.
+		 * @brief Gets the GPU timers if the profiler is enabled, creating them on first use.
 		 */
-		static void compileShader(GLuint &shader, GLenum type, const char *source);
+		GpuTimerQueries *activeGpuTimers();
 	};
 } // namespace pxe
@@ -0,0 +1,150 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "image.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "blitter.h"
+
+namespace pxe {
+	Image::Image(const int width, const int height, const Color fill) : width(width), height(height) {
+		if (width < 0 || height < 0)
+			throw std::invalid_argument("Image dimensions must not be negative");
+		allocateStorage();
+		std::fill_n(storage.as<uint32_t>(), static_cast<size_t>(pitch) * height, fill.pixel());
+	}
+
+	Image::Image(const int width, const int height, const std::span<const Color> colors) :
+		width(width), height(height) {
+		if (width < 0 || height < 0)
+			throw std::invalid_argument("Image dimensions must not be negative");
+		if (colors.size() != static_cast<size_t>(width) * height)
+			throw std::invalid_argument("Image pixel count does not match its dimensions");
+		allocateStorage();
+		for (int y = 0; y < height; y++) {
+			const Color *source = colors.data() + static_cast<size_t>(y) * width;
+			std::transform(source, source + width, row(y), [](const Color color) { return color.pixel(); });
+		}
+	}
+
+	Image::Image(const int width, const int height, const uint32_t *pixels, std::shared_ptr<const void> owner) :
+		width(width), height(height), pitch(width), data(pixels), owner(std::move(owner)) {
+		if (width < 0 || height < 0)
+			throw std::invalid_argument("Image dimensions must not be negative");
+		if (!pixels)
+			throw std::invalid_argument("Wrapped image pixels must not be null");
+	}
+
+	Image::Image(const Image &other) :
+		width(other.width), height(other.height), pitch(other.pitch), data(other.data), owner(other.owner),
+		colorKey(other.colorKey) {
+		if (!owner) {
+			allocateStorage();
+			std::copy_n(other.data, static_cast<size_t>(pitch) * height, storage.as<uint32_t>());
+		}
+	}
+
+	Image::Image(Image &&other) noexcept :
+		width(other.width), height(other.height), pitch(other.pitch), storage(std::move(other.storage)),
+		data(other.data), owner(std::move(other.owner)), colorKey(other.colorKey) {
+		other.width = other.height = other.pitch = 0;
+		other.data = nullptr;
+	}
+
+	Image &Image::operator=(const Image &other) {
+		if (this != &other) {
+			Image copy(other);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	Image &Image::operator=(Image &&other) noexcept {
+		if (this != &other) {
+			width = other.width;
+			height = other.height;
+			pitch = other.pitch;
+			storage = std::move(other.storage);
+			data = other.data;
+			owner = std::move(other.owner);
+			colorKey = other.colorKey;
+			other.width = other.height = other.pitch = 0;
+			other.data = nullptr;
+		}
+		return *this;
+	}
+
+	void Image::allocateStorage() {
+		pitch = alignedPitch(width, sizeof(uint32_t));
+		storage = PixelStorage(SurfaceAllocator::getDefault(), static_cast<size_t>(pitch) * height * sizeof(uint32_t));
+		data = storage.as<uint32_t>();
+	}
+
+	void Image::makeWritable() {
+		if (!owner)
+			return;
+		const uint32_t *wrapped = data;
+		const int wrappedPitch = pitch;
+		allocateStorage();
+		for (int y = 0; y < height; y++) {
+			std::copy_n(wrapped + static_cast<size_t>(y) * wrappedPitch, width, row(y));
+		}
+		owner.reset();
+	}
+
+	void Image::setPixel(const int x, const int y, const Color color) {
+		if (x < 0 || x >= width || y < 0 || y >= height)
+			return;
+		makeWritable();
+		row(y)[x] = color.pixel();
+	}
+
+	Color Image::getPixel(const int x, const int y) const {
+		if (x < 0 || x >= width || y < 0 || y >= height)
+			return Color::Transparent;
+		return Color::fromPixel(data[static_cast<size_t>(y) * pitch + x]);
+	}
+
+	SurfaceView Image::getView() {
+		makeWritable();
+		return {storage.as<uint32_t>(), width, height, pitch};
+	}
+
+	void Image::premultiplyAlpha() {
+		makeWritable();
+		for (int y = 0; y < height; y++) {
+			for (uint32_t &pixel: std::span(row(y), static_cast<size_t>(width))) {
+				const uint32_t alpha = pixel >> PixelFormat::alphaShift;
+				if (alpha == 255)
+					continue;
+				uint32_t result = alpha << PixelFormat::alphaShift;
+				for (const int shift: {PixelFormat::redShift, PixelFormat::greenShift, PixelFormat::blueShift}) {
+					// Rounded channel * alpha / 255.
+					const uint32_t product = ((pixel >> shift) & 0xFF) * alpha + 128;
+					result |= ((product + (product >> 8)) >> 8) << shift;
+				}
+				pixel = result;
+			}
+		}
+	}
+
+	void Image::blit(const Image &source, const Rect &sourceRegion, const int x, const int y, const BlendMode mode) {
+		blitImage(getView(), source, sourceRegion, x, y, mode);
+	}
+} // namespace pxe
@@ -0,0 +1,203 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "imageFile.h"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "imageLimits.h"
+#include "lz4.h"
+#include "mappedFile.h"
+#include "pixelFormat.h"
+#include "pngReader.h"
+#include "qoiReader.h"
+
+namespace pxe {
+	namespace {
+		constexpr char nativeMagic[4] = {'P', 'X', 'E', 'I'};
+		constexpr uint16_t nativeVersion = 1;
+		constexpr size_t nativeHeaderSize = 32;
+		constexpr uint8_t pngSignature[4] = {0x89, 'P', 'N', 'G'};
+
+		enum NativeLayout : uint8_t { LayoutArgb = 0, LayoutAbgr = 1 };
+
+		constexpr uint8_t currentLayout = PixelFormat::redShift == 16 ? LayoutArgb : LayoutAbgr;
+
+		struct NativeHeader {
+			uint8_t layout;
+			ImageCompression compression;
+			uint32_t width, height;
+			uint64_t payloadSize;
+		};
+
+		uint64_t loadLittleEndian(const uint8_t *bytes, const int size) {
+			uint64_t value = 0;
+			for (int i = size - 1; i >= 0; i--) {
+				value = (value << 8) | bytes[i];
+			}
+			return value;
+		}
+
+		void storeLittleEndian(uint8_t *bytes, uint64_t value, const int size) {
+			for (int i = 0; i < size; i++, value >>= 8) {
+				bytes[i] = static_cast<uint8_t>(value);
+			}
+		}
+
+		bool isNative(const std::span<const uint8_t> file) {
+			return file.size() >= nativeHeaderSize && std::memcmp(file.data(), nativeMagic, 4) == 0;
+		}
+
+		NativeHeader parseNativeHeader(const std::span<const uint8_t> file) {
+			const uint8_t *bytes = file.data();
+			if (loadLittleEndian(bytes + 4, 2) != nativeVersion)
+				throw std::runtime_error("Unsupported native image version");
+			NativeHeader header{};
+			header.layout = bytes[6];
+			header.compression = static_cast<ImageCompression>(bytes[7]);
+			header.width = static_cast<uint32_t>(loadLittleEndian(bytes + 8, 4));
+			header.height = static_cast<uint32_t>(loadLittleEndian(bytes + 12, 4));
+			header.payloadSize = loadLittleEndian(bytes + 16, 8);
+			if (header.layout > LayoutAbgr || bytes[7] > static_cast<uint8_t>(ImageCompression::Lz4) ||
+				header.width > 0x7FFFFFFF || header.height > 0x7FFFFFFF ||
+				header.payloadSize > file.size() - nativeHeaderSize ||
+				(header.width != 0 && header.height > maxImagePixels / header.width))
+				throw std::runtime_error("Invalid native image header");
+			const uint64_t pixelBytes = static_cast<uint64_t>(header.width) * header.height * sizeof(uint32_t);
+			if (header.compression == ImageCompression::None && header.payloadSize != pixelBytes)
+				throw std::runtime_error("Invalid native image header");
+			if (header.compression == ImageCompression::Lz4 && pixelBytes / maxLz4Ratio > header.payloadSize)
+				throw std::runtime_error("Invalid native image header");
+			return header;
+		}
+
+		// Pixels can be used in place when nothing about their representation differs from the surface's.
+		bool canWrap(const NativeHeader &header) {
+			return header.compression == ImageCompression::None && header.layout == currentLayout &&
+				   std::endian::native == std::endian::little;
+		}
+
+		Image decodeNative(const NativeHeader &header, const std::span<const uint8_t> file) {
+			const size_t pixelCount = static_cast<size_t>(header.width) * header.height;
+			const auto payload = file.subspan(nativeHeaderSize, header.payloadSize);
+			Image image(static_cast<int>(header.width), static_cast<int>(header.height));
+			if (pixelCount == 0)
+				return image;
+			// The payload is packed; it is decoded into the start of the buffer and then spread out to the
+			// aligned pitch, last row first so that no row is overwritten before it has moved.
+			const SurfaceView view = image.getView();
+			const std::span<uint8_t> bytes(reinterpret_cast<uint8_t *>(view.row(0)), pixelCount * sizeof(uint32_t));
+			if (header.compression == ImageCompression::Lz4) {
+				lz4Decompress(payload, bytes);
+			} else {
+				std::memcpy(bytes.data(), payload.data(), bytes.size());
+			}
+			const size_t packedPitch = static_cast<size_t>(view.getWidth()) * sizeof(uint32_t);
+			for (int y = view.getHeight() - 1; y > 0; y--) {
+				std::memmove(view.row(y), bytes.data() + y * packedPitch, packedPitch);
+			}
+
+			for (int y = 0; y < view.getHeight(); y++) {
+				uint32_t *pixels = view.row(y);
+				if constexpr (std::endian::native != std::endian::little) {
+					const auto *rowBytes = reinterpret_cast<const uint8_t *>(pixels);
+					for (int x = 0; x < view.getWidth(); x++) {
+						pixels[x] = static_cast<uint32_t>(loadLittleEndian(&rowBytes[x * sizeof(uint32_t)], 4));
+					}
+				}
+				if (header.layout != currentLayout) {
+					// The layouts only differ in the positions of red and blue.
+					for (int x = 0; x < view.getWidth(); x++) {
+						const uint32_t pixel = pixels[x];
+						pixels[x] = (pixel & 0xFF00FF00u) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+					}
+				}
+			}
+			return image;
+		}
+	} // namespace
+
+	Image decodeImage(const std::span<const uint8_t> file) {
+		if (isNative(file))
+			return decodeNative(parseNativeHeader(file), file);
+		if (file.size() >= 4 && std::memcmp(file.data(), pngSignature, 4) == 0)
+			return decodePng(file);
+		if (file.size() >= 4 && std::memcmp(file.data(), "qoif", 4) == 0)
+			return decodeQoi(file);
+		throw std::runtime_error("Unknown image format");
+	}
+
+	Image loadImage(const std::string &path) {
+		const auto mapping = std::make_shared<const MappedFile>(path);
+		const auto file = mapping->getBytes();
+		try {
+			if (isNative(file)) {
+				const NativeHeader header = parseNativeHeader(file);
+				if (canWrap(header)) {
+					// The page-aligned mapping plus the 32-byte header keeps the pixels aligned.
+					const auto *pixels = reinterpret_cast<const uint32_t *>(file.data() + nativeHeaderSize);
+					return {static_cast<int>(header.width), static_cast<int>(header.height), pixels, mapping};
+				}
+			}
+			return decodeImage(file);
+		} catch (const std::runtime_error &error) {
+			throw std::runtime_error(path + ": " + error.what());
+		}
+	}
+
+	void saveImage(const std::string &path, const Image &image, const ImageCompression compression) {
+		const auto pixels = image.getPixels();
+		const size_t width = image.getWidth();
+		std::vector<uint8_t> raw(width * image.getHeight() * sizeof(uint32_t));
+		for (int y = 0; y < image.getHeight(); y++) {
+			const uint32_t *source = pixels.data() + static_cast<size_t>(y) * image.getPitch();
+			uint8_t *target = raw.data() + y * width * sizeof(uint32_t);
+			if constexpr (std::endian::native == std::endian::little) {
+				std::memcpy(target, source, width * sizeof(uint32_t));
+			} else {
+				for (size_t x = 0; x < width; x++) {
+					storeLittleEndian(&target[x * sizeof(uint32_t)], source[x], 4);
+				}
+			}
+		}
+		std::vector<uint8_t> compressed;
+		if (compression == ImageCompression::Lz4) {
+			lz4Compress(raw, compressed);
+		}
+		const std::vector<uint8_t> &payload = compression == ImageCompression::Lz4 ? compressed : raw;
+
+		uint8_t header[nativeHeaderSize]{};
+		std::memcpy(header, nativeMagic, 4);
+		storeLittleEndian(header + 4, nativeVersion, 2);
+		header[6] = currentLayout;
+		header[7] = static_cast<uint8_t>(compression);
+		storeLittleEndian(header + 8, static_cast<uint32_t>(image.getWidth()), 4);
+		storeLittleEndian(header + 12, static_cast<uint32_t>(image.getHeight()), 4);
+		storeLittleEndian(header + 16, payload.size(), 8);
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char *>(header), sizeof(header));
+		out.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size()));
+		out.close();
+		if (!out)
+			throw std::runtime_error("Failed to write " + path);
+	}
+} // namespace pxe
@@ -0,0 +1,32 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace pxe {
+	/**
+	 * @brief Largest pixel count an image file may declare: the limit of the QOI reference implementation,
+	 * 1.6 GB of native pixels.
+	 *
+	 * Every decoder checks the header against it, and the data size against the largest ratio its codec can
+	 * reach (`maxInflateRatio`, `maxLz4Ratio`, a 62-pixel QOI run per byte), before allocating, so a corrupted
+	 * header cannot request gigabytes for a few bytes of data.
+	 */
+	inline constexpr uint32_t maxImagePixels = 400'000'000;
+} // namespace pxe
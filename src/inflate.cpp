@@ -0,0 +1,282 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inflate.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace pxe {
+	namespace {
+		constexpr int maxCodeLength = 15;
+		constexpr int fastBits = 10;
+
+		constexpr uint16_t lengthBase[] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+										   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+		constexpr uint8_t lengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+										   2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+		constexpr uint16_t distanceBase[] = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+											 33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+											 1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+		constexpr uint8_t distanceExtra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+											 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+		[[noreturn]] void malformed() { throw std::runtime_error("Malformed deflate stream"); }
+
+		/// Reads the stream least significant bit first, as deflate packs it.
+		class BitReader {
+		public:
+			explicit BitReader(const std::span<const uint8_t> data) :
+				next(data.data()), end(data.data() + data.size()) {}
+
+			/// Peeks at the next bits; bits past the end of the stream read as zero.
+			uint32_t peek(const int count) {
+				refill();
+				return static_cast<uint32_t>(buffer & ((uint64_t{1} << count) - 1));
+			}
+
+			void consume(const int count) {
+				if (count > bitCount)
+					malformed(); // Ran past the end of the stream.
+				buffer >>= count;
+				bitCount -= count;
+			}
+
+			uint32_t read(const int count) {
+				const uint32_t value = peek(count);
+				consume(count);
+				return value;
+			}
+
+			/// Drops the bits up to the next byte boundary; stored blocks start there.
+			void alignToByte() { consume(bitCount % 8); }
+
+			/// Copies whole bytes, which must start on a byte boundary.
+			void copyBytes(uint8_t *destination, size_t count) {
+				for (; count > 0 && bitCount >= 8; count--) {
+					*destination++ = static_cast<uint8_t>(read(8));
+				}
+				if (count > static_cast<size_t>(end - next))
+					malformed();
+				std::memcpy(destination, next, count);
+				next += count;
+			}
+
+		private:
+			const uint8_t *next;
+			const uint8_t *end;
+			uint64_t buffer = 0;
+			int bitCount = 0;
+
+			void refill() {
+				while (bitCount <= 56 && next != end) {
+					buffer |= static_cast<uint64_t>(*next++) << bitCount;
+					bitCount += 8;
+				}
+			}
+		};
+
+		/// A canonical Huffman code with a direct lookup table for codes up to `fastBits` long.
+		class Huffman {
+		public:
+			void build(const uint8_t *lengths, const int symbolCount) {
+				counts.fill(0);
+				for (int symbol = 0; symbol < symbolCount; symbol++) {
+					counts[lengths[symbol]]++;
+				}
+				counts[0] = 0;
+				std::array<uint16_t, maxCodeLength + 2> offsets{};
+				for (int length = 1; length <= maxCodeLength; length++) {
+					offsets[length + 1] = offsets[length] + counts[length];
+				}
+				for (int symbol = 0; symbol < symbolCount; symbol++) {
+					if (lengths[symbol] != 0) {
+						symbols[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+					}
+				}
+
+				// Codes are assigned in symbol order within each length; store them bit-reversed since the
+				// stream delivers the first bit of a code in the least significant position.
+				fast.fill(0);
+				int code = 0, index = 0;
+				for (int length = 1; length <= maxCodeLength; length++) {
+					for (int i = 0; i < counts[length]; i++, code++, index++) {
+						if (length > fastBits)
+							continue;
+						int reversed = 0;
+						for (int bit = 0; bit < length; bit++) {
+							reversed |= ((code >> bit) & 1) << (length - 1 - bit);
+						}
+						const auto entry = static_cast<uint16_t>((symbols[index] << 4) | length);
+						for (int slot = reversed; slot < (1 << fastBits); slot += 1 << length) {
+							fast[slot] = entry;
+						}
+					}
+					code <<= 1;
+				}
+			}
+
+			int decode(BitReader &reader) const {
+				const uint16_t entry = fast[reader.peek(fastBits)];
+				if (entry != 0) {
+					reader.consume(entry & 15);
+					return entry >> 4;
+				}
+				// Longer code: walk the canonical code one bit at a time.
+				const uint32_t bits = reader.peek(maxCodeLength);
+				int code = 0, first = 0, index = 0;
+				for (int length = 1; length <= maxCodeLength; length++) {
+					code |= (bits >> (length - 1)) & 1;
+					const int count = counts[length];
+					if (code - first < count) {
+						reader.consume(length);
+						return symbols[index + code - first];
+					}
+					index += count;
+					first = (first + count) << 1;
+					code <<= 1;
+				}
+				malformed();
+			}
+
+		private:
+			std::array<uint16_t, maxCodeLength + 1> counts{};
+			std::array<uint16_t, 288> symbols{};
+			std::array<uint16_t, 1 << fastBits> fast{}; ///< (symbol << 4) | length, 0 for longer codes.
+		};
+
+		void buildFixedCodes(Huffman &literals, Huffman &distances) {
+			uint8_t lengths[288];
+			std::fill_n(lengths, 144, 8);
+			std::fill_n(lengths + 144, 112, 9);
+			std::fill_n(lengths + 256, 24, 7);
+			std::fill_n(lengths + 280, 8, 8);
+			literals.build(lengths, 288);
+			std::fill_n(lengths, 30, 5);
+			distances.build(lengths, 30);
+		}
+
+		void readDynamicCodes(BitReader &reader, Huffman &literals, Huffman &distances) {
+			static constexpr uint8_t codeLengthOrder[] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+														  11, 4,  12, 3, 13, 2, 14, 1, 15};
+			const int literalCount = static_cast<int>(reader.read(5)) + 257;
+			const int distanceCount = static_cast<int>(reader.read(5)) + 1;
+			const int codeLengthCount = static_cast<int>(reader.read(4)) + 4;
+			if (literalCount > 286 || distanceCount > 30)
+				malformed();
+
+			uint8_t codeLengthLengths[19]{};
+			for (int i = 0; i < codeLengthCount; i++) {
+				codeLengthLengths[codeLengthOrder[i]] = static_cast<uint8_t>(reader.read(3));
+			}
+			Huffman codeLengths;
+			codeLengths.build(codeLengthLengths, 19);
+
+			uint8_t lengths[286 + 30]{};
+			for (int i = 0; i < literalCount + distanceCount;) {
+				const int symbol = codeLengths.decode(reader);
+				if (symbol < 16) {
+					lengths[i++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+				int repeat;
+				uint8_t value = 0;
+				if (symbol == 16) {
+					if (i == 0)
+						malformed();
+					value = lengths[i - 1];
+					repeat = 3 + static_cast<int>(reader.read(2));
+				} else if (symbol == 17) {
+					repeat = 3 + static_cast<int>(reader.read(3));
+				} else {
+					repeat = 11 + static_cast<int>(reader.read(7));
+				}
+				if (i + repeat > literalCount + distanceCount)
+					malformed();
+				std::fill_n(lengths + i, repeat, value);
+				i += repeat;
+			}
+			literals.build(lengths, literalCount);
+			distances.build(lengths + literalCount, distanceCount);
+		}
+	} // namespace
+
+	void inflateZlib(const std::span<const uint8_t> input, const std::span<uint8_t> output) {
+		if (input.size() < 2 || (input[0] & 15) != 8 || ((input[0] << 8) | input[1]) % 31 != 0)
+			throw std::runtime_error("Invalid zlib header");
+		if (input[1] & 0x20)
+			throw std::runtime_error("zlib preset dictionaries are not supported");
+
+		BitReader reader(input.subspan(2));
+		uint8_t *out = output.data();
+		uint8_t *const outEnd = out + output.size();
+		Huffman literals, distances;
+		bool last;
+		do {
+			last = reader.read(1) != 0;
+			const uint32_t type = reader.read(2);
+			if (type == 0) {
+				reader.alignToByte();
+				const uint32_t length = reader.read(16);
+				if ((length ^ reader.read(16)) != 0xFFFF || length > static_cast<size_t>(outEnd - out))
+					malformed();
+				reader.copyBytes(out, length);
+				out += length;
+				continue;
+			}
+			if (type == 1) {
+				buildFixedCodes(literals, distances);
+			} else if (type == 2) {
+				readDynamicCodes(reader, literals, distances);
+			} else {
+				malformed();
+			}
+
+			while (true) {
+				const int symbol = literals.decode(reader);
+				if (symbol < 256) {
+					if (out == outEnd)
+						malformed();
+					*out++ = static_cast<uint8_t>(symbol);
+					continue;
+				}
+				if (symbol == 256)
+					break;
+				const int lengthCode = symbol - 257;
+				if (lengthCode >= 29)
+					malformed();
+				const size_t length = lengthBase[lengthCode] + reader.read(lengthExtra[lengthCode]);
+				const int distanceCode = distances.decode(reader);
+				if (distanceCode >= 30)
+					malformed();
+				const size_t distance = distanceBase[distanceCode] + reader.read(distanceExtra[distanceCode]);
+				if (distance > static_cast<size_t>(out - output.data()) || length > static_cast<size_t>(outEnd - out))
+					malformed();
+				const uint8_t *match = out - distance;
+				for (size_t i = 0; i < length; i++) {
+					out[i] = match[i];
+				}
+				out += length;
+			}
+		} while (!last);
+
+		if (out != outEnd)
+			malformed();
+	}
+} // namespace pxe
@@ -0,0 +1,39 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pxe {
+	/// Largest ratio of decompressed to compressed size a deflate stream can reach, 258 bytes per 2 bits.
+	inline constexpr size_t maxInflateRatio = 1032;
+
+	/**
+	 * @brief Decompresses a zlib stream (RFC 1950/1951) whose decompressed size is known up front.
+	 *
+	 * Huffman codes are decoded through a 10-bit lookup table, falling back to a canonical walk only
+	 * for longer codes. The Adler-32 trailer is not verified.
+	 * @param input The zlib stream, e.g. the concatenated IDAT chunks of a PNG file.
+	 * @param output Receives exactly the decompressed data.
+	 * @throws std::runtime_error if the stream is malformed, uses a preset dictionary, or does not
+	 * decompress to exactly `output.size()` bytes.
+	 */
+	void inflateZlib(std::span<const uint8_t> input, std::span<uint8_t> output);
+} // namespace pxe
@@ -17,9 +17,14 @@
  */
 
 #include "input.h"
-#include <iostream>
 
 namespace pxe {
+	namespace {
+		bool isValid(const int code, const int count) {
+			return static_cast<unsigned>(code) < static_cast<unsigned>(count);
+		}
+	} // namespace
+
 	Input::Input(Window *window) {
 		// Store 'this' pointer in the GLFW window's user pointer
 		glfwSetWindowUserPointer(window->getGlfwWindow(), this);
@@ -28,50 +33,189 @@ namespace pxe {
 		glfwSetKeyCallback(window->getGlfwWindow(), keyCallbackGLFW);
 		glfwSetMouseButtonCallback(window->getGlfwWindow(), mouseButtonCallbackGLFW);
 		glfwSetCursorPosCallback(window->getGlfwWindow(), cursorPositionCallbackGLFW);
+		frameEvents.reserve(eventCapacity);
+	}
+
+	void Input::update() {
+		keysPressed.reset();
+		keysReleased.reset();
+		buttonsPressed.reset();
+		buttonsReleased.reset();
+		frameEvents.clear();
+
+		InputEvent event;
+		while (queue.tryPop(event)) {
+			apply(event);
+			frameEvents.push_back(event);
+		}
+		// Read after draining, so the live state is at least as new as the last event consumed.
+		if (overflowed.exchange(false, std::memory_order_acquire)) {
+			resynchronize();
+		}
+
+		if (keyCallback) {
+			for (const InputEvent &keyEvent: frameEvents) {
+				switch (keyEvent.type) {
+					case InputEventType::KeyPress:
+						keyCallback(static_cast<int>(keyEvent.key), GLFW_PRESS);
+						break;
+					case InputEventType::KeyRelease:
+						keyCallback(static_cast<int>(keyEvent.key), GLFW_RELEASE);
+						break;
+					case InputEventType::KeyRepeat:
+						keyCallback(static_cast<int>(keyEvent.key), GLFW_REPEAT);
+						break;
+					default:
+						break;
+				}
+			}
+		}
+	}
+
+	bool Input::isKeyPressed(const int key) const noexcept { return isValid(key, keyCount) && keysDown[key]; }
+
+	bool Input::wasKeyPressed(const int key) const noexcept { return isValid(key, keyCount) && keysPressed[key]; }
+
+	bool Input::wasKeyReleased(const int key) const noexcept {
+		return isValid(key, keyCount) && keysReleased[key];
+	}
+
+	bool Input::isMousePressed(const int button) const noexcept {
+		return isValid(button, mouseButtonCount) && buttonsDown[button];
 	}
 
-	bool Input::isKeyPressed(int key) const noexcept {
-		auto it = keyState.find(key);
-		return it != keyState.end() && it->second;
+	bool Input::wasMousePressed(const int button) const noexcept {
+		return isValid(button, mouseButtonCount) && buttonsPressed[button];
 	}
 
-	bool Input::isMousePressed(int button) const noexcept {
-		auto it = mouseState.find(button);
-		return it != mouseState.end() && it->second;
+	bool Input::wasMouseReleased(const int button) const noexcept {
+		return isValid(button, mouseButtonCount) && buttonsReleased[button];
 	}
 
 	std::pair<double, double> Input::getMousePosition() const noexcept { return {mouseX, mouseY}; }
 
+	std::span<const InputEvent> Input::getEvents() const noexcept { return frameEvents; }
+
 	void Input::setKeyCallback(std::function<void(int key, int action)> callback) noexcept {
 		keyCallback = std::move(callback);
 	}
 
+	void Input::push(const InputEvent &event) {
+		if (!queue.tryPush(event)) {
+			overflowed.store(true, std::memory_order_release);
+		}
+	}
+
+	void Input::apply(const InputEvent &event) {
+		mouseX = event.x;
+		mouseY = event.y;
+		const int key = static_cast<int>(event.key);
+		const int button = static_cast<int>(event.button);
+		switch (event.type) {
+			case InputEventType::KeyPress:
+				if (isValid(key, keyCount)) {
+					keysDown.set(key);
+					keysPressed.set(key);
+				}
+				break;
+			case InputEventType::KeyRelease:
+				if (isValid(key, keyCount)) {
+					keysDown.reset(key);
+					keysReleased.set(key);
+				}
+				break;
+			case InputEventType::MousePress:
+				if (isValid(button, mouseButtonCount)) {
+					buttonsDown.set(button);
+					buttonsPressed.set(button);
+				}
+				break;
+			case InputEventType::MouseRelease:
+				if (isValid(button, mouseButtonCount)) {
+					buttonsDown.reset(button);
+					buttonsReleased.set(button);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	void Input::resynchronize() {
+		// Events were dropped: adopt the live state and report whatever changed as edges.
+		for (int key = 0; key < keyCount; key++) {
+			const bool down = (liveKeys[key / 64].load(std::memory_order_relaxed) >> (key % 64)) & 1;
+			if (down != keysDown[key]) {
+				(down ? keysPressed : keysReleased).set(key);
+				keysDown[key] = down;
+			}
+		}
+		const uint64_t buttons = liveButtons.load(std::memory_order_relaxed);
+		for (int button = 0; button < mouseButtonCount; button++) {
+			const bool down = (buttons >> button) & 1;
+			if (down != buttonsDown[button]) {
+				(down ? buttonsPressed : buttonsReleased).set(button);
+				buttonsDown[button] = down;
+			}
+		}
+		mouseX = liveX.load(std::memory_order_relaxed);
+		mouseY = liveY.load(std::memory_order_relaxed);
+	}
+
 	void Input::keyCallbackGLFW(GLFWwindow *window, int key, int scancode, int action, int mods) {
 		Input *input = static_cast<Input *>(glfwGetWindowUserPointer(window));
+		InputEvent event;
+		event.key = isValid(key, keyCount) ? static_cast<KeyCode>(key) : KeyCode::Unknown;
 		if (action == GLFW_PRESS) {
-			input->keyState[key] = true;
+			event.type = InputEventType::KeyPress;
 		} else if (action == GLFW_RELEASE) {
-			input->keyState[key] = false;
+			event.type = InputEventType::KeyRelease;
+		} else {
+			event.type = InputEventType::KeyRepeat;
 		}
-
-		// Call user-defined key callback if set.
-		if (input->keyCallback) {
-			input->keyCallback(key, action);
+		if (isValid(key, keyCount) && event.type != InputEventType::KeyRepeat) {
+			const uint64_t bit = uint64_t{1} << (key % 64);
+			if (event.type == InputEventType::KeyPress) {
+				input->liveKeys[key / 64].fetch_or(bit, std::memory_order_relaxed);
+			} else {
+				input->liveKeys[key / 64].fetch_and(~bit, std::memory_order_relaxed);
+			}
 		}
+		event.x = input->liveX.load(std::memory_order_relaxed);
+		event.y = input->liveY.load(std::memory_order_relaxed);
+		event.time = std::chrono::steady_clock::now();
+		input->push(event);
 	}
 
 	void Input::mouseButtonCallbackGLFW(GLFWwindow *window, int button, int action, int mods) {
 		Input *input = static_cast<Input *>(glfwGetWindowUserPointer(window));
+		if (!isValid(button, mouseButtonCount) || action == GLFW_REPEAT) {
+			return;
+		}
+		InputEvent event;
+		event.button = static_cast<MouseButton>(button);
+		const uint64_t bit = uint64_t{1} << button;
 		if (action == GLFW_PRESS) {
-			input->mouseState[button] = true;
-		} else if (action == GLFW_RELEASE) {
-			input->mouseState[button] = false;
+			event.type = InputEventType::MousePress;
+			input->liveButtons.fetch_or(bit, std::memory_order_relaxed);
+		} else {
+			event.type = InputEventType::MouseRelease;
+			input->liveButtons.fetch_and(~bit, std::memory_order_relaxed);
 		}
+		event.x = input->liveX.load(std::memory_order_relaxed);
+		event.y = input->liveY.load(std::memory_order_relaxed);
+		event.time = std::chrono::steady_clock::now();
+		input->push(event);
 	}
 
 	void Input::cursorPositionCallbackGLFW(GLFWwindow *window, double xpos, double ypos) {
 		Input *input = static_cast<Input *>(glfwGetWindowUserPointer(window));
-		input->mouseX = xpos;
-		input->mouseY = ypos;
+		input->liveX.store(xpos, std::memory_order_relaxed);
+		input->liveY.store(ypos, std::memory_order_relaxed);
+		InputEvent event;
+		event.x = xpos;
+		event.y = ypos;
+		event.time = std::chrono::steady_clock::now();
+		input->push(event);
 	}
 } // namespace pxe
@@ -17,25 +17,49 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
 #include <functional>
-#include <unordered_map>
+#include <span>
+#include <vector>
+#include "inputEvent.h"
 #include "openGLContext.h"
+#include "spscQueue.h"
 #include "window.h"
 
 namespace pxe {
 	/**
 	 * @brief Manages user input (keyboard & mouse).
 	 *
-	 * This class tracks input states and provides event callbacks.
+	 * GLFW callbacks, on the thread polling events, only append timestamped events to a lock-free SPSC
+	 * ring. The thread running the simulation drains the ring once per frame with `update`, which folds
+	 * the events into flat bitsets of held keys and buttons plus the edges of the frame. Queries read
+	 * those bitsets without locks or hashing, and a press and release between two updates is still seen
+	 * as an edge. If the ring ever fills, the newest events are dropped and `update` resynchronises the
+	 * held state from the live state the callbacks maintain.
 	 */
 	class Input {
 	public:
+		static constexpr int keyCount = GLFW_KEY_LAST + 1; ///< Size of the key bitsets.
+		static constexpr int mouseButtonCount = GLFW_MOUSE_BUTTON_LAST + 1; ///< Size of the button bitsets.
+		static constexpr size_t eventCapacity = 1024; ///< Events the ring holds between two updates.
+
 		/**
 		 * @brief Constructs an Input system object.
 		 * @param window The window handle.
 		 */
 		explicit Input(Window *window);
 
+		/**
+		 * @brief Consumes the events queued since the previous call. Consumer side only.
+		 *
+		 * Updates the held state, the pressed/released edges and the mouse position, then invokes the key
+		 * callback for every key event, on the calling thread.
+		 */
+		void update();
+
 		/**
 		 * @brief Checks if a key is currently pressed.
 		 * @param key The GLFW key code (e.g., GLFW_KEY_W).
@@ -43,6 +67,16 @@ namespace pxe {
 		 */
 		bool isKeyPressed(int key) const noexcept;
 
+		/**
+		 * @brief Checks whether a key went down since the previous update, even if already released.
+		 */
+		bool wasKeyPressed(int key) const noexcept;
+
+		/**
+		 * @brief Checks whether a key went up since the previous update.
+		 */
+		bool wasKeyReleased(int key) const noexcept;
+
 		/**
 		 * @brief Checks if a mouse button is pressed.
 		 * @param button The GLFW mouse button (e.g., GLFW_MOUSE_BUTTON_LEFT).
@@ -50,26 +84,63 @@ namespace pxe {
 		 */
 		bool isMousePressed(int button) const noexcept;
 
+		/**
+		 * @brief Checks whether a mouse button went down since the previous update.
+		 */
+		bool wasMousePressed(int button) const noexcept;
+
+		/**
+		 * @brief Checks whether a mouse button went up since the previous update.
+		 */
+		bool wasMouseReleased(int button) const noexcept;
+
 		/**
 		 * @brief Gets the current mouse position.
 		 * @return A pair (x, y) of the mouse coordinates.
 		 */
 		std::pair<double, double> getMousePosition() const noexcept;
 
+		/**
+		 * @brief Gets every event consumed by the last update, oldest first.
+		 */
+		std::span<const InputEvent> getEvents() const noexcept;
+
 		/**
 		 * @brief Sets a callback function for key events.
+		 *
+		 * The callback runs inside `update`, not inside the GLFW callback.
 		 * @param callback The function to be called on key events.
 		 */
 		void setKeyCallback(std::function<void(int key, int action)> callback) noexcept;
 
 	private:
-		std::unordered_map<int, bool> keyState;
-		std::unordered_map<int, bool> mouseState;
+		static constexpr size_t keyWords = (keyCount + 63) / 64;
+
+		// Producer side, written by the GLFW callbacks.
+		SpscQueue<InputEvent> queue{eventCapacity};
+		std::atomic<bool> overflowed{false}; ///< Set when an event did not fit into the ring.
+		std::array<std::atomic<uint64_t>, keyWords> liveKeys{}; ///< Held keys as of the latest callback.
+		std::atomic<uint64_t> liveButtons{0}; ///< Held mouse buttons as of the latest callback.
+		std::atomic<double> liveX{0.0};
+		std::atomic<double> liveY{0.0};
+
+		// Consumer side, owned by the thread calling update.
+		std::bitset<keyCount> keysDown;
+		std::bitset<keyCount> keysPressed;
+		std::bitset<keyCount> keysReleased;
+		std::bitset<mouseButtonCount> buttonsDown;
+		std::bitset<mouseButtonCount> buttonsPressed;
+		std::bitset<mouseButtonCount> buttonsReleased;
 		double mouseX = 0;
 		double mouseY = 0;
+		std::vector<InputEvent> frameEvents; ///< Events consumed by the last update.
 
 		std::function<void(int, int)> keyCallback = nullptr;
 
+		void push(const InputEvent &event);
+		void apply(const InputEvent &event);
+		void resynchronize();
+
 		static void keyCallbackGLFW(GLFWwindow *window, int key, int scancode, int action, int mods);
 		static void mouseButtonCallbackGLFW(GLFWwindow *window, int button, int action, int mods);
 		static void cursorPositionCallbackGLFW(GLFWwindow *window, double xpos, double ypos);
@@ -0,0 +1,162 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace pxe {
+	namespace {
+		constexpr size_t minMatch = 4;
+		// The format requires the last match to start at least 12 bytes before the end of the block and
+		// the last 5 bytes to be literals.
+		constexpr size_t matchStartMargin = 12;
+		constexpr size_t literalTail = 5;
+		constexpr size_t maxOffset = 65535;
+		constexpr int hashBits = 16;
+
+		uint32_t load32(const uint8_t *bytes) {
+			uint32_t value;
+			std::memcpy(&value, bytes, sizeof(value));
+			return value;
+		}
+
+		uint32_t hash(const uint32_t sequence) { return (sequence * 2654435761u) >> (32 - hashBits); }
+
+		// Appends the 255-terminated continuation bytes of a length whose nibble was saturated at 15.
+		void writeLength(std::vector<uint8_t> &output, size_t length) {
+			for (; length >= 255; length -= 255) {
+				output.push_back(255);
+			}
+			output.push_back(static_cast<uint8_t>(length));
+		}
+
+		void writeSequence(std::vector<uint8_t> &output, const uint8_t *literals, const size_t literalLength,
+						   const size_t offset, const size_t matchLength) {
+			const size_t matchCode = matchLength - minMatch;
+			output.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) |
+												  std::min<size_t>(matchCode, 15)));
+			if (literalLength >= 15) {
+				writeLength(output, literalLength - 15);
+			}
+			output.insert(output.end(), literals, literals + literalLength);
+			output.push_back(static_cast<uint8_t>(offset));
+			output.push_back(static_cast<uint8_t>(offset >> 8));
+			if (matchCode >= 15) {
+				writeLength(output, matchCode - 15);
+			}
+		}
+
+		[[noreturn]] void malformed() { throw std::runtime_error("Malformed LZ4 block"); }
+	} // namespace
+
+	void lz4Compress(const std::span<const uint8_t> input, std::vector<uint8_t> &output) {
+		output.clear();
+		output.reserve(input.size() + input.size() / 255 + 16);
+		const uint8_t *data = input.data();
+		const size_t size = input.size();
+		size_t anchor = 0;
+
+		if (size > matchStartMargin) {
+			std::vector<uint32_t> table(size_t{1} << hashBits, 0);
+			const size_t matchStartLimit = size - matchStartMargin;
+			const size_t matchEndLimit = size - literalTail;
+			for (size_t position = 1; position < matchStartLimit;) {
+				const uint32_t sequence = load32(data + position);
+				const uint32_t candidate = std::exchange(table[hash(sequence)], static_cast<uint32_t>(position));
+				if (position - candidate > maxOffset || load32(data + candidate) != sequence) {
+					position++;
+					continue;
+				}
+				size_t length = minMatch;
+				while (position + length < matchEndLimit && data[candidate + length] == data[position + length]) {
+					length++;
+				}
+				writeSequence(output, data + anchor, position - anchor, position - candidate, length);
+				position += length;
+				anchor = position;
+			}
+		}
+
+		// The final sequence is literals only.
+		const size_t literalLength = size - anchor;
+		output.push_back(static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4));
+		if (literalLength >= 15) {
+			writeLength(output, literalLength - 15);
+		}
+		output.insert(output.end(), data + anchor, data + size);
+	}
+
+	void lz4Decompress(const std::span<const uint8_t> input, const std::span<uint8_t> output) {
+		const uint8_t *in = input.data();
+		const uint8_t *const inEnd = in + input.size();
+		uint8_t *out = output.data();
+		uint8_t *const outEnd = out + output.size();
+
+		auto readLength = [&](size_t length) {
+			if (length == 15) {
+				uint8_t byte;
+				do {
+					if (in == inEnd)
+						malformed();
+					byte = *in++;
+					length += byte;
+				} while (byte == 255);
+			}
+			return length;
+		};
+
+		while (true) {
+			if (in == inEnd)
+				malformed();
+			const uint8_t token = *in++;
+			const size_t literalLength = readLength(token >> 4);
+			if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out))
+				malformed();
+			if (literalLength != 0)
+				std::memcpy(out, in, literalLength); // `out` may be null when decompressing into an empty span.
+			in += literalLength;
+			out += literalLength;
+			if (in == inEnd)
+				break; // The last sequence has no match.
+
+			if (inEnd - in < 2)
+				malformed();
+			const size_t offset = in[0] | (in[1] << 8);
+			in += 2;
+			const size_t matchLength = readLength(token & 15) + minMatch;
+			if (offset == 0 || offset > static_cast<size_t>(out - output.data()) ||
+				matchLength > static_cast<size_t>(outEnd - out))
+				malformed();
+			const uint8_t *match = out - offset;
+			if (offset >= matchLength) {
+				std::memcpy(out, match, matchLength);
+				out += matchLength;
+			} else {
+				// Overlapping matches repeat the last `offset` bytes; copy forwards one byte at a time.
+				for (size_t i = 0; i < matchLength; i++) {
+					*out++ = match[i];
+				}
+			}
+		}
+		if (out != outEnd)
+			malformed();
+	}
+} // namespace pxe
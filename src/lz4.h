@@ -0,0 +1,46 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pxe {
+	/// Largest ratio of decompressed to compressed size an LZ4 block can reach, one length byte per 255 bytes.
+	inline constexpr size_t maxLz4Ratio = 255;
+
+	/**
+	 * @brief Compresses data into a single LZ4 block (the raw block format, without frame headers).
+	 *
+	 * A greedy single-probe matcher: fast enough to run over a whole asset directory offline, and the
+	 * output decodes with any conforming LZ4 block decoder.
+	 * @param input The data to compress.
+	 * @param output Receives the block; previous contents are discarded.
+	 */
+	void lz4Compress(std::span<const uint8_t> input, std::vector<uint8_t> &output);
+
+	/**
+	 * @brief Decompresses a single LZ4 block whose decompressed size is known up front.
+	 * @param input The compressed block.
+	 * @param output Receives exactly the decompressed data.
+	 * @throws std::runtime_error if the block is malformed or does not decompress to exactly `output.size()`.
+	 */
+	void lz4Decompress(std::span<const uint8_t> input, std::span<uint8_t> output);
+} // namespace pxe
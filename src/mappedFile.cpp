@@ -0,0 +1,99 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pxe {
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string &path) {
+		fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+								 FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("Failed to open " + path);
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize)) {
+			CloseHandle(fileHandle);
+			throw std::runtime_error("Failed to get the size of " + path);
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		// Empty files cannot be mapped; they are simply empty.
+		if (size == 0)
+			return;
+		mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle) {
+			bytes = static_cast<const uint8_t *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		}
+		if (!bytes) {
+			if (mappingHandle) {
+				CloseHandle(mappingHandle);
+			}
+			CloseHandle(fileHandle);
+			throw std::runtime_error("Failed to map " + path);
+		}
+	}
+
+	MappedFile::~MappedFile() {
+		if (bytes) {
+			UnmapViewOfFile(bytes);
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+	}
+#else
+	MappedFile::MappedFile(const std::string &path) {
+		const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (descriptor < 0)
+			throw std::runtime_error("Failed to open " + path);
+		struct stat status {};
+		if (fstat(descriptor, &status) != 0) {
+			close(descriptor);
+			throw std::runtime_error("Failed to get the size of " + path);
+		}
+		size = static_cast<size_t>(status.st_size);
+		// Empty files cannot be mapped; they are simply empty.
+		if (size > 0) {
+			void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (mapping == MAP_FAILED) {
+				close(descriptor);
+				throw std::runtime_error("Failed to map " + path);
+			}
+			bytes = static_cast<const uint8_t *>(mapping);
+		}
+		// The mapping keeps the file referenced on its own.
+		close(descriptor);
+	}
+
+	MappedFile::~MappedFile() {
+		if (bytes) {
+			munmap(const_cast<uint8_t *>(bytes), size);
+		}
+	}
+#endif
+} // namespace pxe
@@ -0,0 +1,62 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace pxe {
+	/**
+	 * @brief A read-only memory mapping of a whole file.
+	 *
+	 * Pages are only read from disk when first touched, and stay shared with the page cache, so mapping
+	 * an asset costs almost nothing until its pixels are used.
+	 */
+	class MappedFile {
+	public:
+		/**
+		 * @brief Maps a file.
+		 * @param path Path of the file.
+		 * @throws std::runtime_error if the file cannot be opened or mapped.
+		 */
+		explicit MappedFile(const std::string &path);
+
+		/**
+		 * @brief Unmaps the file.
+		 */
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		/**
+		 * @brief Gets the contents of the file; the first byte is page aligned.
+		 */
+		[[nodiscard]] std::span<const uint8_t> getBytes() const { return {bytes, size}; }
+
+	private:
+		const uint8_t *bytes = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		void *fileHandle = nullptr;
+		void *mappingHandle = nullptr;
+#endif
+	};
+} // namespace pxe
@@ -0,0 +1,115 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "offscreenContext.h"
+#include <cstring>
+#include <stdexcept>
+#include <EGL/eglext.h>
+
+namespace pxe {
+	namespace {
+		bool hasExtension(const char *extensions, const char *name) {
+			if (!extensions)
+				return false;
+			const size_t length = std::strlen(name);
+			for (const char *match = std::strstr(extensions, name); match; match = std::strstr(match + 1, name)) {
+				const bool startsWord = match == extensions || match[-1] == ' ';
+				if (startsWord && (match[length] == ' ' || match[length] == '\0'))
+					return true;
+			}
+			return false;
+		}
+
+		// A display on the first GPU device, which needs no X11 or Wayland server, or the default display.
+		EGLDisplay openDisplay() {
+			const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			if (hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+				const auto queryDevices =
+						reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+				const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+						eglGetProcAddress("eglGetPlatformDisplayEXT"));
+				EGLDeviceEXT device;
+				EGLint deviceCount = 0;
+				if (queryDevices && getPlatformDisplay && queryDevices(1, &device, &deviceCount) && deviceCount > 0) {
+					const EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+					if (display != EGL_NO_DISPLAY)
+						return display;
+				}
+			}
+			return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+	} // namespace
+
+	OffscreenContext::OffscreenContext() {
+		display = openDisplay();
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+			throw std::runtime_error("Failed to initialize EGL");
+		}
+		try {
+			if (!hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+				throw std::runtime_error("EGL display does not support surfaceless contexts");
+			}
+			if (!eglBindAPI(EGL_OPENGL_API)) {
+				throw std::runtime_error("EGL display does not support desktop OpenGL");
+			}
+
+			// No surface is ever created, so do not restrict the config to the default window surface type.
+			constexpr EGLint configAttributes[] = {EGL_SURFACE_TYPE, 0, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+			EGLConfig config;
+			EGLint configCount = 0;
+			if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+				throw std::runtime_error("No EGL config supports OpenGL");
+			}
+
+			// Same version and profile as the windowed context.
+			constexpr EGLint contextAttributes[] = {EGL_CONTEXT_MAJOR_VERSION,
+													3,
+													EGL_CONTEXT_MINOR_VERSION,
+													3,
+													EGL_CONTEXT_OPENGL_PROFILE_MASK,
+													EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+													EGL_NONE};
+			context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+			if (context == EGL_NO_CONTEXT) {
+				throw std::runtime_error("Failed to create EGL OpenGL 3.3 context");
+			}
+			if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+				throw std::runtime_error("Failed to make the EGL context current");
+			}
+		} catch (...) {
+			destroy();
+			throw;
+		}
+	}
+
+	OffscreenContext::~OffscreenContext() { destroy(); }
+
+	void OffscreenContext::destroy() {
+		if (display == EGL_NO_DISPLAY)
+			return;
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (context != EGL_NO_CONTEXT) {
+			eglDestroyContext(display, context);
+			context = EGL_NO_CONTEXT;
+		}
+		eglTerminate(display);
+		display = EGL_NO_DISPLAY;
+	}
+
+	GLADloadproc OffscreenContext::getLoader() { return reinterpret_cast<GLADloadproc>(eglGetProcAddress); }
+} // namespace pxe
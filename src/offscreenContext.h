@@ -0,0 +1,56 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <glad/glad.h>
+// GLAD must come before any other header that may pull in OpenGL.
+#include <EGL/egl.h>
+
+namespace pxe {
+	/**
+	 * @brief An OpenGL 3.3 core context without any window or surface, created through EGL.
+	 *
+	 * Prefers a GPU device display (`EGL_EXT_platform_device`) so it works on servers without a display
+	 * server, and falls back to the default display. The context is made current on construction; Graphics
+	 * then renders into its own framebuffer object.
+	 */
+	class OffscreenContext {
+	public:
+		/**
+		 * @brief Creates the context and makes it current on the calling thread.
+		 * @throws std::runtime_error if EGL, surfaceless contexts or desktop OpenGL are unavailable.
+		 */
+		OffscreenContext();
+
+		~OffscreenContext();
+
+		OffscreenContext(const OffscreenContext &) = delete;
+		OffscreenContext &operator=(const OffscreenContext &) = delete;
+
+		/**
+		 * @brief Gets the function loader to initialize GLAD with.
+		 */
+		[[nodiscard]] static GLADloadproc getLoader();
+
+	private:
+		EGLDisplay display = EGL_NO_DISPLAY;
+		EGLContext context = EGL_NO_CONTEXT;
+
+		void destroy();
+	};
+} // namespace pxe
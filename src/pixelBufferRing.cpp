@@ -0,0 +1,99 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pixelBufferRing.h"
+#include <stdexcept>
+
+namespace pxe {
+	namespace {
+		constexpr GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		constexpr GLuint64 fenceTimeout = 1'000'000; // 1 ms per wait, retried until the fence signals.
+	} // namespace
+
+	PixelBufferRing::PixelBufferRing(const size_t slotSize, const int slotCount) :
+		slots(static_cast<size_t>(slotCount)), slotSize(slotSize) {
+		if (!isSupported()) {
+			throw std::runtime_error("Persistent buffer mapping (GL_ARB_buffer_storage) is not supported");
+		}
+
+		for (auto &slot: slots) {
+			glGenBuffers(1, &slot.buffer);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+			glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(slotSize), nullptr, mapFlags);
+			slot.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(slotSize), mapFlags);
+			if (!slot.mapped) {
+				destroy();
+				throw std::runtime_error("Failed to map pixel buffer object");
+			}
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	PixelBufferRing::~PixelBufferRing() { destroy(); }
+
+	void PixelBufferRing::destroy() {
+		for (auto &slot: slots) {
+			if (slot.fence) {
+				glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+				glDeleteSync(slot.fence);
+				slot.fence = nullptr;
+			}
+			if (slot.buffer) {
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+				glDeleteBuffers(1, &slot.buffer);
+				slot.buffer = 0;
+			}
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	bool PixelBufferRing::isSupported() { return GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage; }
+
+	void *PixelBufferRing::acquire() {
+		Slot &slot = slots[current];
+		waitForSlot(slot);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+		return slot.mapped;
+	}
+
+	void PixelBufferRing::release() {
+		Slot &slot = slots[current];
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		current = (current + 1) % slots.size();
+	}
+
+	size_t PixelBufferRing::getSlotSize() const { return slotSize; }
+
+	void PixelBufferRing::waitForSlot(Slot &slot) {
+		if (!slot.fence)
+			return;
+
+		GLenum status;
+		do {
+			status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout);
+		} while (status == GL_TIMEOUT_EXPIRED);
+
+		glDeleteSync(slot.fence);
+		slot.fence = nullptr;
+		if (status == GL_WAIT_FAILED) {
+			throw std::runtime_error("Failed to wait for pixel buffer fence");
+		}
+	}
+} // namespace pxe
@@ -0,0 +1,97 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "openGLContext.h"
+
+namespace pxe {
+	/**
+	 * @brief A ring of persistently mapped pixel unpack buffers used to stream texture uploads.
+	 *
+	 * Each slot is a buffer object created with `glBufferStorage` and mapped once for its whole lifetime.
+	 * A fence is inserted after the GPU is told to read a slot, and the slot is only handed back to the CPU
+	 * once that fence has signaled. With two or three slots the CPU fills the next frame while the driver is
+	 * still transferring the previous one.
+	 */
+	class PixelBufferRing {
+	public:
+		static constexpr int defaultSlotCount = 3;
+
+		/**
+		 * @brief Allocates and maps the ring buffers.
+		 * @param slotSize Size in bytes of every slot.
+		 * @param slotCount Number of slots in the ring (2 or 3 is usually enough).
+		 */
+		explicit PixelBufferRing(size_t slotSize, int slotCount = defaultSlotCount);
+
+		/**
+		 * @brief Waits for pending transfers and releases the buffer objects.
+		 */
+		~PixelBufferRing();
+
+		/**
+		 * @brief Checks whether the current context can create persistently mapped buffers.
+		 */
+		[[nodiscard]] static bool isSupported();
+
+		/**
+		 * @brief Waits until the current slot is no longer in use by the GPU and binds it.
+		 *
+		 * The slot stays bound to `GL_PIXEL_UNPACK_BUFFER` until `release()` is called, so transfer
+		 * commands issued in between read from it using byte offsets instead of client pointers.
+		 * @return Pointer to the mapped memory of the slot.
+		 */
+		void *acquire();
+
+		/**
+		 * @brief Fences the commands that read the current slot, unbinds it and advances the ring.
+		 */
+		void release();
+
+		/**
+		 * @brief Gets the size in bytes of every slot.
+		 */
+		[[nodiscard]] size_t getSlotSize() const;
+
+		PixelBufferRing(const PixelBufferRing &) = delete;
+		PixelBufferRing &operator=(const PixelBufferRing &) = delete;
+
+	private:
+		struct Slot {
+			GLuint buffer = 0;
+			void *mapped = nullptr;
+			GLsync fence = nullptr;
+		};
+
+		std::vector<Slot> slots;
+		size_t slotSize;
+		size_t current = 0;
+
+		/**
+		 * @brief Blocks until the fence of the given slot has signaled and deletes it.
+		 */
+		static void waitForSlot(Slot &slot);
+
+		/**
+		 * @brief Unmaps and deletes every buffer object created so far.
+		 */
+		void destroy();
+	};
+} // namespace pxe
@@ -0,0 +1,485 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pixelKernels.h"
+#include <algorithm>
+#include <vector>
+#include "cpuFeatures.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PXE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC accepts intrinsics of any instruction set without per-function target attributes.
+#define PXE_TARGET_AVX2
+#else
+#define PXE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PXE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace pxe {
+	namespace {
+		constexpr size_t defaultCacheSize = 8 * 1024 * 1024;
+
+		// Unrolled so that short tile-width spans (32 pixels) do not pay for a loop per pixel.
+		void fillColumnScalar(uint32_t *dst, size_t count, const size_t pitch, const uint32_t pixel) {
+			for (; count >= 4; count -= 4) {
+				dst[0] = pixel;
+				dst[pitch] = pixel;
+				dst[2 * pitch] = pixel;
+				dst[3 * pitch] = pixel;
+				dst += 4 * pitch;
+			}
+			for (; count > 0; count--) {
+				*dst = pixel;
+				dst += pitch;
+			}
+		}
+
+		void fillSpanScalar(uint32_t *dst, const size_t count, const uint32_t pixel) { std::fill_n(dst, count, pixel); }
+
+		constexpr FillKernels scalarKernels{"scalar", fillSpanScalar, fillSpanScalar, fillColumnScalar};
+
+		// Rounded x / 255 for x in [0, 255 * 255], without a division.
+		constexpr uint32_t divide255(uint32_t x) {
+			x += 128;
+			return (x + (x >> 8)) >> 8;
+		}
+
+		constexpr uint32_t blendPixel(const uint32_t dst, const uint32_t src) {
+			const uint32_t inverseAlpha = 255 - (src >> 24);
+			uint32_t result = 0;
+			for (int shift = 0; shift < 32; shift += 8) {
+				const uint32_t channel = ((src >> shift) & 0xFF) + divide255(((dst >> shift) & 0xFF) * inverseAlpha);
+				result |= std::min<uint32_t>(channel, 255) << shift;
+			}
+			return result;
+		}
+
+		void colorKeyRowScalar(uint32_t *dst, const uint32_t *src, const size_t count, const uint32_t key) {
+			for (size_t i = 0; i < count; i++) {
+				if (src[i] != key) {
+					dst[i] = src[i];
+				}
+			}
+		}
+
+		void blendRowScalar(uint32_t *dst, const uint32_t *src, const size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				const uint32_t alpha = src[i] >> 24;
+				if (alpha == 255) {
+					dst[i] = src[i];
+				} else if (src[i] != 0) {
+					dst[i] = blendPixel(dst[i], src[i]);
+				}
+			}
+		}
+
+		constexpr BlitKernels scalarBlitKernels{"scalar", colorKeyRowScalar, blendRowScalar};
+
+		// Gathers the even bits of a Morton index: the x coordinate of `index`, or the y coordinate of `index >> 1`.
+		constexpr size_t compactBits(size_t index) {
+			index &= 0x55;
+			index = (index | index >> 1) & 0x33;
+			return (index | index >> 2) & 0x0F;
+		}
+
+		void mortonTileScalar(uint32_t *dst, const size_t pitch, const uint32_t *tile) {
+			for (size_t i = 0; i < 256; i++) {
+				dst[compactBits(i >> 1) * pitch + compactBits(i)] = tile[i];
+			}
+		}
+
+		constexpr DetileKernels scalarDetileKernels{"scalar", mortonTileScalar};
+
+#if PXE_KERNELS_X86
+		// Stores single pixels until `dst` reaches the requested alignment; returns the remaining count.
+		inline size_t alignHead(uint32_t *&dst, size_t count, const uint32_t pixel, const uintptr_t alignment) {
+			while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & (alignment - 1)) != 0) {
+				*dst++ = pixel;
+				count--;
+			}
+			return count;
+		}
+
+		template<bool Stream>
+		void fillSpanSse2(uint32_t *dst, size_t count, const uint32_t pixel) {
+			count = alignHead(dst, count, pixel, 16);
+			const __m128i value = _mm_set1_epi32(static_cast<int>(pixel));
+			auto store = [](uint32_t *p, const __m128i v) {
+				if constexpr (Stream) {
+					_mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+				} else {
+					_mm_store_si128(reinterpret_cast<__m128i *>(p), v);
+				}
+			};
+			for (; count >= 16; count -= 16) {
+				store(dst, value);
+				store(dst + 4, value);
+				store(dst + 8, value);
+				store(dst + 12, value);
+				dst += 16;
+			}
+			for (; count >= 4; count -= 4) {
+				store(dst, value);
+				dst += 4;
+			}
+			if constexpr (Stream) {
+				_mm_sfence();
+			}
+			std::fill_n(dst, count, pixel);
+		}
+
+		template<bool Stream>
+		PXE_TARGET_AVX2 void fillSpanAvx2(uint32_t *dst, size_t count, const uint32_t pixel) {
+			count = alignHead(dst, count, pixel, 32);
+			const __m256i value = _mm256_set1_epi32(static_cast<int>(pixel));
+			auto store = [](uint32_t *p, const __m256i v) PXE_TARGET_AVX2 {
+				if constexpr (Stream) {
+					_mm256_stream_si256(reinterpret_cast<__m256i *>(p), v);
+				} else {
+					_mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+				}
+			};
+			for (; count >= 32; count -= 32) {
+				store(dst, value);
+				store(dst + 8, value);
+				store(dst + 16, value);
+				store(dst + 24, value);
+				dst += 32;
+			}
+			for (; count >= 8; count -= 8) {
+				store(dst, value);
+				dst += 8;
+			}
+			if constexpr (Stream) {
+				_mm_sfence();
+			}
+			std::fill_n(dst, count, pixel);
+		}
+
+		void colorKeyRowSse2(uint32_t *dst, const uint32_t *src, size_t count, const uint32_t key) {
+			const __m128i keys = _mm_set1_epi32(static_cast<int>(key));
+			for (; count >= 4; count -= 4) {
+				const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+				const __m128i keep = _mm_cmpeq_epi32(source, keys);
+				auto *target = reinterpret_cast<__m128i *>(dst);
+				const __m128i old = _mm_loadu_si128(target);
+				_mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(keep, old), _mm_andnot_si128(keep, source)));
+				src += 4;
+				dst += 4;
+			}
+			colorKeyRowScalar(dst, src, count, key);
+		}
+
+		// Multiplies eight 16-bit channels by their inverse source alpha and divides by 255, rounded.
+		inline __m128i scaleChannelsSse2(const __m128i channels, const __m128i inverseAlpha) {
+			const __m128i product = _mm_add_epi16(_mm_mullo_epi16(channels, inverseAlpha), _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+		}
+
+		void blendRowSse2(uint32_t *dst, const uint32_t *src, size_t count) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			for (; count >= 4; count -= 4) {
+				const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+				auto *target = reinterpret_cast<__m128i *>(dst);
+				// Opaque and fully transparent groups are common in sprites and skip the arithmetic.
+				const __m128i alpha = _mm_and_si128(source, alphaMask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+					_mm_storeu_si128(target, source);
+				} else if (_mm_movemask_epi8(_mm_cmpeq_epi32(source, zero)) != 0xFFFF) {
+					const __m128i old = _mm_loadu_si128(target);
+					// Alpha bytes of the inverted source are 255 - alpha; broadcast them to every channel.
+					const __m128i inverse = _mm_xor_si128(source, alphaMask);
+					__m128i inverseLow = _mm_unpacklo_epi8(inverse, zero);
+					__m128i inverseHigh = _mm_unpackhi_epi8(inverse, zero);
+					inverseLow = _mm_shufflehi_epi16(_mm_shufflelo_epi16(inverseLow, 0xFF), 0xFF);
+					inverseHigh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(inverseHigh, 0xFF), 0xFF);
+					const __m128i low = scaleChannelsSse2(_mm_unpacklo_epi8(old, zero), inverseLow);
+					const __m128i high = scaleChannelsSse2(_mm_unpackhi_epi8(old, zero), inverseHigh);
+					_mm_storeu_si128(target, _mm_adds_epu8(_mm_packus_epi16(low, high), source));
+				}
+				src += 4;
+				dst += 4;
+			}
+			blendRowScalar(dst, src, count);
+		}
+
+		PXE_TARGET_AVX2 void colorKeyRowAvx2(uint32_t *dst, const uint32_t *src, size_t count, const uint32_t key) {
+			const __m256i keys = _mm256_set1_epi32(static_cast<int>(key));
+			for (; count >= 8; count -= 8) {
+				const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+				const __m256i keep = _mm256_cmpeq_epi32(source, keys);
+				auto *target = reinterpret_cast<__m256i *>(dst);
+				_mm256_storeu_si256(target, _mm256_blendv_epi8(source, _mm256_loadu_si256(target), keep));
+				src += 8;
+				dst += 8;
+			}
+			colorKeyRowScalar(dst, src, count, key);
+		}
+
+		PXE_TARGET_AVX2 inline __m256i scaleChannelsAvx2(const __m256i channels, const __m256i inverseAlpha) {
+			const __m256i product =
+					_mm256_add_epi16(_mm256_mullo_epi16(channels, inverseAlpha), _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+		}
+
+		PXE_TARGET_AVX2 void blendRowAvx2(uint32_t *dst, const uint32_t *src, size_t count) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			// Copies byte 3 (alpha) of each pixel into all four of its 16-bit channel lanes.
+			const __m256i broadcastAlpha = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15, 6,
+															7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+			for (; count >= 8; count -= 8) {
+				const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+				auto *target = reinterpret_cast<__m256i *>(dst);
+				const __m256i alpha = _mm256_and_si256(source, alphaMask);
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alphaMask)) == -1) {
+					_mm256_storeu_si256(target, source);
+				} else if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(source, zero)) != -1) {
+					const __m256i old = _mm256_loadu_si256(target);
+					const __m256i inverse = _mm256_xor_si256(source, alphaMask);
+					const __m256i inverseLow = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(inverse, zero), broadcastAlpha);
+					const __m256i inverseHigh =
+							_mm256_shuffle_epi8(_mm256_unpackhi_epi8(inverse, zero), broadcastAlpha);
+					const __m256i low = scaleChannelsAvx2(_mm256_unpacklo_epi8(old, zero), inverseLow);
+					const __m256i high = scaleChannelsAvx2(_mm256_unpackhi_epi8(old, zero), inverseHigh);
+					_mm256_storeu_si256(target, _mm256_adds_epu8(_mm256_packus_epi16(low, high), source));
+				}
+				src += 8;
+				dst += 8;
+			}
+			blendRowSse2(dst, src, count);
+		}
+
+		constexpr FillKernels sse2Kernels{"sse2", fillSpanSse2<false>, fillSpanSse2<true>, fillColumnScalar};
+		constexpr FillKernels avx2Kernels{"avx2", fillSpanAvx2<false>, fillSpanAvx2<true>, fillColumnScalar};
+		// Every 16 consecutive pixels of a Morton tile form a 4x4 block, stored as the 2x2 quads
+		// (0,0) (1,0) (0,1) (1,1): two 64-bit unpacks per pair of quads rebuild the four rows.
+		void mortonTileSse2(uint32_t *dst, const size_t pitch, const uint32_t *tile) {
+			for (size_t block = 0; block < 16; block++, tile += 16) {
+				const auto *source = reinterpret_cast<const __m128i *>(tile);
+				const __m128i top0 = _mm_load_si128(source);
+				const __m128i top1 = _mm_load_si128(source + 1);
+				const __m128i bottom0 = _mm_load_si128(source + 2);
+				const __m128i bottom1 = _mm_load_si128(source + 3);
+				uint32_t *rows = dst + compactBits(block >> 1) * 4 * pitch + compactBits(block) * 4;
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(rows), _mm_unpacklo_epi64(top0, top1));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(rows + pitch), _mm_unpackhi_epi64(top0, top1));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(rows + 2 * pitch), _mm_unpacklo_epi64(bottom0, bottom1));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(rows + 3 * pitch), _mm_unpackhi_epi64(bottom0, bottom1));
+			}
+		}
+
+		constexpr BlitKernels sse2BlitKernels{"sse2", colorKeyRowSse2, blendRowSse2};
+		constexpr BlitKernels avx2BlitKernels{"avx2", colorKeyRowAvx2, blendRowAvx2};
+		constexpr DetileKernels sse2DetileKernels{"sse2", mortonTileSse2};
+#endif
+
+#if PXE_KERNELS_NEON
+		void fillSpanNeon(uint32_t *dst, size_t count, const uint32_t pixel) {
+			const uint32x4_t value = vdupq_n_u32(pixel);
+			for (; count >= 16; count -= 16) {
+				vst1q_u32(dst, value);
+				vst1q_u32(dst + 4, value);
+				vst1q_u32(dst + 8, value);
+				vst1q_u32(dst + 12, value);
+				dst += 16;
+			}
+			for (; count >= 4; count -= 4) {
+				vst1q_u32(dst, value);
+				dst += 4;
+			}
+			std::fill_n(dst, count, pixel);
+		}
+
+		// NEON has no non-temporal store intrinsic; the streaming entry reuses the regular kernel.
+		constexpr FillKernels neonKernels{"neon", fillSpanNeon, fillSpanNeon, fillColumnScalar};
+
+		void colorKeyRowNeon(uint32_t *dst, const uint32_t *src, size_t count, const uint32_t key) {
+			const uint32x4_t keys = vdupq_n_u32(key);
+			for (; count >= 4; count -= 4) {
+				const uint32x4_t source = vld1q_u32(src);
+				vst1q_u32(dst, vbslq_u32(vceqq_u32(source, keys), vld1q_u32(dst), source));
+				src += 4;
+				dst += 4;
+			}
+			colorKeyRowScalar(dst, src, count, key);
+		}
+
+		void blendRowNeon(uint32_t *dst, const uint32_t *src, size_t count) {
+			for (; count >= 4; count -= 4) {
+				const uint32x4_t source = vld1q_u32(src);
+				const uint32x4_t alpha = vshrq_n_u32(source, 24);
+				if (vminvq_u32(alpha) == 255) {
+					vst1q_u32(dst, source);
+				} else if (vmaxvq_u32(source) != 0) {
+					// 255 - alpha, broadcast to the four bytes of each pixel.
+					const uint32x4_t inverseAlpha = vsubq_u32(vdupq_n_u32(255), alpha);
+					const uint8x16_t inverse = vreinterpretq_u8_u32(vmulq_n_u32(inverseAlpha, 0x01010101));
+					const uint8x16_t old = vreinterpretq_u8_u32(vld1q_u32(dst));
+					const uint16x8_t low = vmull_u8(vget_low_u8(old), vget_low_u8(inverse));
+					const uint16x8_t high = vmull_u8(vget_high_u8(old), vget_high_u8(inverse));
+					// Rounded division by 255: (x + ((x + 128) >> 8) + 128) >> 8.
+					const uint8x16_t scaled = vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(low, low, 8), 8),
+														  vrshrn_n_u16(vrsraq_n_u16(high, high, 8), 8));
+					vst1q_u32(dst, vreinterpretq_u32_u8(vqaddq_u8(scaled, vreinterpretq_u8_u32(source))));
+				}
+				src += 4;
+				dst += 4;
+			}
+			blendRowScalar(dst, src, count);
+		}
+
+		constexpr BlitKernels neonBlitKernels{"neon", colorKeyRowNeon, blendRowNeon};
+
+		// See mortonTileSse2: each 4x4 block is rebuilt from the halves of its four 2x2 quads.
+		void mortonTileNeon(uint32_t *dst, const size_t pitch, const uint32_t *tile) {
+			for (size_t block = 0; block < 16; block++, tile += 16) {
+				const uint32x4_t top0 = vld1q_u32(tile);
+				const uint32x4_t top1 = vld1q_u32(tile + 4);
+				const uint32x4_t bottom0 = vld1q_u32(tile + 8);
+				const uint32x4_t bottom1 = vld1q_u32(tile + 12);
+				uint32_t *rows = dst + compactBits(block >> 1) * 4 * pitch + compactBits(block) * 4;
+				vst1q_u32(rows, vcombine_u32(vget_low_u32(top0), vget_low_u32(top1)));
+				vst1q_u32(rows + pitch, vcombine_u32(vget_high_u32(top0), vget_high_u32(top1)));
+				vst1q_u32(rows + 2 * pitch, vcombine_u32(vget_low_u32(bottom0), vget_low_u32(bottom1)));
+				vst1q_u32(rows + 3 * pitch, vcombine_u32(vget_high_u32(bottom0), vget_high_u32(bottom1)));
+			}
+		}
+
+		constexpr DetileKernels neonDetileKernels{"neon", mortonTileNeon};
+#endif
+
+		std::vector<const FillKernels *> detectKernels() {
+			std::vector<const FillKernels *> kernels{&scalarKernels};
+#if PXE_KERNELS_X86
+			// SSE2 is part of the x86-64 baseline.
+			kernels.push_back(&sse2Kernels);
+			if (cpuSupportsAvx2()) {
+				kernels.push_back(&avx2Kernels);
+			}
+#elif PXE_KERNELS_NEON
+			kernels.push_back(&neonKernels);
+#endif
+			return kernels;
+		}
+
+		std::vector<const BlitKernels *> detectBlitKernels() {
+			std::vector<const BlitKernels *> kernels{&scalarBlitKernels};
+#if PXE_KERNELS_X86
+			kernels.push_back(&sse2BlitKernels);
+			if (cpuSupportsAvx2()) {
+				kernels.push_back(&avx2BlitKernels);
+			}
+#elif PXE_KERNELS_NEON
+			kernels.push_back(&neonBlitKernels);
+#endif
+			return kernels;
+		}
+
+		std::vector<const DetileKernels *> detectDetileKernels() {
+			std::vector<const DetileKernels *> kernels{&scalarDetileKernels};
+#if PXE_KERNELS_X86
+			kernels.push_back(&sse2DetileKernels);
+#elif PXE_KERNELS_NEON
+			kernels.push_back(&neonDetileKernels);
+#endif
+			return kernels;
+		}
+
+		const std::vector<const DetileKernels *> &detileKernelRegistry() {
+			static const std::vector<const DetileKernels *> kernels = detectDetileKernels();
+			return kernels;
+		}
+
+		const std::vector<const BlitKernels *> &blitKernelRegistry() {
+			static const std::vector<const BlitKernels *> kernels = detectBlitKernels();
+			return kernels;
+		}
+
+		const std::vector<const FillKernels *> &kernelRegistry() {
+			static const std::vector<const FillKernels *> kernels = detectKernels();
+			return kernels;
+		}
+	} // namespace
+
+	const FillKernels &fillKernels() {
+		static const FillKernels &best = *kernelRegistry().back();
+		return best;
+	}
+
+	std::span<const FillKernels *const> availableFillKernels() { return kernelRegistry(); }
+
+	const BlitKernels &blitKernels() {
+		static const BlitKernels &best = *blitKernelRegistry().back();
+		return best;
+	}
+
+	std::span<const BlitKernels *const> availableBlitKernels() { return blitKernelRegistry(); }
+
+	const DetileKernels &detileKernels() {
+		static const DetileKernels &best = *detileKernelRegistry().back();
+		return best;
+	}
+
+	std::span<const DetileKernels *const> availableDetileKernels() { return detileKernelRegistry(); }
+
+	size_t lastLevelCacheSize() {
+		static const size_t size = [] {
+			long bytes = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+			bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+			if (bytes <= 0) {
+				bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+			}
+#elif defined(__APPLE__)
+			size_t length = sizeof(bytes);
+			if (sysctlbyname("hw.l3cachesize", &bytes, &length, nullptr, 0) != 0 || bytes <= 0) {
+				length = sizeof(bytes);
+				sysctlbyname("hw.l2cachesize", &bytes, &length, nullptr, 0);
+			}
+#endif
+			return bytes > 0 ? static_cast<size_t>(bytes) : defaultCacheSize;
+		}();
+		return size;
+	}
+
+	void fillRect(const FillKernels &kernels, uint32_t *dst, const size_t width, const size_t height,
+				  const size_t pitch, const uint32_t pixel) {
+		const bool stream = width * height * sizeof(uint32_t) > lastLevelCacheSize();
+		const auto fill = stream ? kernels.streamSpan : kernels.fillSpan;
+		if (width == pitch) {
+			fill(dst, width * height, pixel);
+			return;
+		}
+		for (size_t y = 0; y < height; y++) {
+			fill(dst + y * pitch, width, pixel);
+		}
+	}
+} // namespace pxe
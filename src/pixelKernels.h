@@ -0,0 +1,126 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pxe {
+	/**
+	 * @brief A table of pixel fill kernels implemented for one instruction set.
+	 *
+	 * All kernels operate on 32-bit pixels and accept any alignment and length, including zero.
+	 */
+	struct FillKernels {
+		/// Name of the instruction set, e.g. "avx2".
+		const char *name;
+		/// Fills `count` consecutive pixels with `pixel`.
+		void (*fillSpan)(uint32_t *dst, size_t count, uint32_t pixel);
+		/// Like `fillSpan`, but with non-temporal stores that bypass the cache. Meant for buffers larger than
+		/// the last-level cache, where regular stores would only evict useful data.
+		void (*streamSpan)(uint32_t *dst, size_t count, uint32_t pixel);
+		/// Fills `count` pixels spaced `pitch` pixels apart, i.e. a vertical span.
+		void (*fillColumn)(uint32_t *dst, size_t count, size_t pitch, uint32_t pixel);
+	};
+
+	/**
+	 * @brief Gets the fastest kernels supported by the running CPU.
+	 *
+	 * The selection is made once, on first use, from the CPU features detected at runtime.
+	 */
+	[[nodiscard]] const FillKernels &fillKernels();
+
+	/**
+	 * @brief Lists every kernel table the running CPU can execute, scalar first.
+	 *
+	 * Used by benchmarks to compare implementations against each other.
+	 */
+	[[nodiscard]] std::span<const FillKernels *const> availableFillKernels();
+
+	/**
+	 * @brief A table of row compositing kernels implemented for one instruction set.
+	 *
+	 * Like `FillKernels`, every kernel accepts any alignment and length. Source and destination rows
+	 * must not overlap.
+	 */
+	struct BlitKernels {
+		/// Name of the instruction set, e.g. "avx2".
+		const char *name;
+		/// Copies the `count` source pixels that differ from `key`; pixels equal to it are left untouched.
+		void (*colorKeyRow)(uint32_t *dst, const uint32_t *src, size_t count, uint32_t key);
+		/// Composites premultiplied source pixels over the destination: dst = src + dst * (255 - srcAlpha) / 255,
+		/// per channel, rounded and saturated.
+		void (*blendRow)(uint32_t *dst, const uint32_t *src, size_t count);
+	};
+
+	/**
+	 * @brief Gets the fastest compositing kernels supported by the running CPU.
+	 */
+	[[nodiscard]] const BlitKernels &blitKernels();
+
+	/**
+	 * @brief Lists every compositing kernel table the running CPU can execute, scalar first.
+	 */
+	[[nodiscard]] std::span<const BlitKernels *const> availableBlitKernels();
+
+	/**
+	 * @brief A table of detiling kernels implemented for one instruction set.
+	 *
+	 * Detiling converts pixels from a 2D-local layout back to rows, e.g. before a tiled surface is uploaded.
+	 */
+	struct DetileKernels {
+		/// Name of the instruction set, e.g. "sse2".
+		const char *name;
+		/// Writes the 16x16 pixels of one `MortonLayout` tile (256 pixels in Z order) into `dst` as rows of
+		/// `pitch` pixels.
+		void (*mortonTile)(uint32_t *dst, size_t pitch, const uint32_t *tile);
+	};
+
+	/**
+	 * @brief Gets the fastest detiling kernels supported by the running CPU.
+	 */
+	[[nodiscard]] const DetileKernels &detileKernels();
+
+	/**
+	 * @brief Lists every detiling kernel table the running CPU can execute, scalar first.
+	 */
+	[[nodiscard]] std::span<const DetileKernels *const> availableDetileKernels();
+
+	/**
+	 * @brief Gets the size of the last-level data cache in bytes.
+	 *
+	 * Falls back to a conservative default when the platform does not report it.
+	 */
+	[[nodiscard]] size_t lastLevelCacheSize();
+
+	/**
+	 * @brief Fills a rectangle of a row-pitched pixel buffer.
+	 *
+	 * Uses non-temporal stores when the rectangle is larger than the last-level cache, and a single
+	 * span fill when the rows are contiguous.
+	 * @param kernels The kernel table to use.
+	 * @param dst Pointer to the top-left pixel of the rectangle.
+	 * @param width Width of the rectangle in pixels.
+	 * @param height Height of the rectangle in pixels.
+	 * @param pitch Distance in pixels between the starts of two consecutive rows.
+	 * @param pixel The packed pixel value to store.
+	 */
+	void fillRect(const FillKernels &kernels, uint32_t *dst, size_t width, size_t height, size_t pitch,
+				  uint32_t pixel);
+} // namespace pxe
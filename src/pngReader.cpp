@@ -0,0 +1,263 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pngReader.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "imageLimits.h"
+#include "inflate.h"
+#include "pixelFormat.h"
+
+namespace pxe {
+	namespace {
+		constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+		enum ColorType : uint8_t { Grayscale = 0, Truecolor = 2, Indexed = 3, GrayscaleAlpha = 4, TruecolorAlpha = 6 };
+
+		uint32_t loadBigEndian(const uint8_t *bytes) {
+			return (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+		}
+
+		[[noreturn]] void malformed(const char *reason) {
+			throw std::runtime_error(std::string("Invalid PNG: ") + reason);
+		}
+
+		int channelCount(const uint8_t colorType) {
+			switch (colorType) {
+				case Grayscale:
+				case Indexed:
+					return 1;
+				case GrayscaleAlpha:
+					return 2;
+				case Truecolor:
+					return 3;
+				case TruecolorAlpha:
+					return 4;
+				default:
+					malformed("unknown color type");
+			}
+		}
+
+		uint8_t paeth(const int a, const int b, const int c) {
+			const int p = a + b - c;
+			const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+			if (pa <= pb && pa <= pc)
+				return static_cast<uint8_t>(a);
+			return static_cast<uint8_t>(pb <= pc ? b : c);
+		}
+
+		// Reverses the per-row filter in place; `previous` is the unfiltered row above, or null for the first.
+		void unfilter(const uint8_t filter, uint8_t *row, const uint8_t *previous, const size_t length,
+					  const size_t bytesPerPixel) {
+			switch (filter) {
+				case 0:
+					break;
+				case 1:
+					for (size_t i = bytesPerPixel; i < length; i++) {
+						row[i] += row[i - bytesPerPixel];
+					}
+					break;
+				case 2:
+					if (previous) {
+						for (size_t i = 0; i < length; i++) {
+							row[i] += previous[i];
+						}
+					}
+					break;
+				case 3:
+					for (size_t i = 0; i < length; i++) {
+						const int left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+						const int up = previous ? previous[i] : 0;
+						row[i] += static_cast<uint8_t>((left + up) / 2);
+					}
+					break;
+				case 4:
+					for (size_t i = 0; i < length; i++) {
+						const int left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+						const int up = previous ? previous[i] : 0;
+						const int upLeft = previous && i >= bytesPerPixel ? previous[i - bytesPerPixel] : 0;
+						row[i] += paeth(left, up, upLeft);
+					}
+					break;
+				default:
+					malformed("unknown filter type");
+			}
+		}
+	} // namespace
+
+	Image decodePng(const std::span<const uint8_t> file) {
+		if (file.size() < sizeof(signature) || std::memcmp(file.data(), signature, sizeof(signature)) != 0)
+			malformed("missing signature");
+
+		uint32_t width = 0, height = 0;
+		uint8_t bitDepth = 0, colorType = 0;
+		uint32_t palette[256]{};
+		size_t paletteSize = 0;
+		bool hasTransparentColor = false;
+		uint16_t transparentSample[3]{}; ///< tRNS color of grayscale (one sample) and truecolor images.
+		std::vector<uint8_t> compressed;
+
+		for (size_t offset = sizeof(signature); ;) {
+			if (file.size() - offset < 12)
+				malformed("truncated chunk");
+			const uint32_t length = loadBigEndian(&file[offset]);
+			const uint8_t *type = &file[offset + 4];
+			const uint8_t *data = &file[offset + 8];
+			if (length > file.size() - offset - 12)
+				malformed("truncated chunk");
+			offset += 12 + static_cast<size_t>(length);
+
+			if (std::memcmp(type, "IHDR", 4) == 0) {
+				if (length != 13)
+					malformed("bad IHDR");
+				width = loadBigEndian(data);
+				height = loadBigEndian(data + 4);
+				bitDepth = data[8];
+				colorType = data[9];
+				if (data[10] != 0 || data[11] != 0)
+					malformed("unknown compression or filter method");
+				if (data[12] != 0)
+					throw std::runtime_error("Interlaced PNG images are not supported");
+			} else if (std::memcmp(type, "PLTE", 4) == 0) {
+				if (length % 3 != 0 || length > 768)
+					malformed("bad PLTE");
+				paletteSize = length / 3;
+				for (size_t i = 0; i < paletteSize; i++) {
+					palette[i] = PixelFormat::pack(data[3 * i], data[3 * i + 1], data[3 * i + 2]);
+				}
+			} else if (std::memcmp(type, "tRNS", 4) == 0) {
+				if (colorType == Indexed) {
+					for (size_t i = 0; i < length && i < 256; i++) {
+						palette[i] = (palette[i] & ~(0xFFu << PixelFormat::alphaShift)) |
+									 (static_cast<uint32_t>(data[i]) << PixelFormat::alphaShift);
+					}
+				} else if (length >= 2 * static_cast<size_t>(channelCount(colorType))) {
+					hasTransparentColor = true;
+					for (int i = 0; i < channelCount(colorType); i++) {
+						transparentSample[i] = static_cast<uint16_t>((data[2 * i] << 8) | data[2 * i + 1]);
+					}
+				}
+			} else if (std::memcmp(type, "IDAT", 4) == 0) {
+				compressed.insert(compressed.end(), data, data + length);
+			} else if (std::memcmp(type, "IEND", 4) == 0) {
+				break;
+			} else if ((type[0] & 0x20) == 0) {
+				malformed("unknown critical chunk");
+			}
+		}
+
+		const int channels = channelCount(colorType);
+		// Depths below 8 are only allowed for palette and grayscale images, 16 for everything but palettes.
+		bool validDepth = bitDepth != 0 && (bitDepth & (bitDepth - 1)) == 0 && bitDepth <= 16;
+		if (colorType == Indexed) {
+			validDepth &= bitDepth <= 8;
+		} else if (colorType != Grayscale) {
+			validDepth &= bitDepth >= 8;
+		}
+		if (width == 0 || height == 0 || width > 0x7FFFFFFF || height > 0x7FFFFFFF || !validDepth)
+			malformed("bad IHDR");
+		if (height > maxImagePixels / width)
+			malformed("image too large");
+		if (colorType == Indexed && paletteSize == 0)
+			malformed("missing PLTE");
+
+		// At most `maxImagePixels` pixels of 64 bits, but the sizes are checked anyway for 32-bit targets.
+		const size_t bitsPerPixel = static_cast<size_t>(channels) * bitDepth;
+		if (width > (SIZE_MAX - 7) / bitsPerPixel)
+			malformed("image too large");
+		const size_t rowBytes = (static_cast<size_t>(width) * bitsPerPixel + 7) / 8;
+		const size_t bytesPerPixel = std::max<size_t>(bitsPerPixel / 8, 1);
+		if (rowBytes + 1 > SIZE_MAX / height)
+			malformed("image too large");
+		const size_t rawSize = (rowBytes + 1) * height;
+		if (rawSize / maxInflateRatio > compressed.size())
+			malformed("image data too short");
+		std::vector<uint8_t> raw(rawSize);
+		inflateZlib(compressed, raw);
+		compressed = {};
+
+		Image image(static_cast<int>(width), static_cast<int>(height));
+		const SurfaceView view = image.getView();
+		const int sampleStride = bitDepth == 16 ? 2 : 1;
+		const uint32_t sampleMax = (1u << bitDepth) - 1;
+		const uint8_t *previous = nullptr;
+		for (uint32_t y = 0; y < height; y++) {
+			uint8_t *row = &raw[y * (rowBytes + 1)];
+			unfilter(row[0], row + 1, previous, rowBytes, bytesPerPixel);
+			previous = row + 1;
+			const uint8_t *samples = row + 1;
+			uint32_t *out = view.row(static_cast<int>(y));
+
+			if (bitDepth < 8) {
+				// Packed samples, most significant bits first.
+				for (uint32_t x = 0; x < width; x++) {
+					const size_t bit = static_cast<size_t>(x) * bitDepth;
+					const uint32_t sample = (samples[bit / 8] >> (8 - bitDepth - bit % 8)) & sampleMax;
+					if (colorType == Indexed) {
+						out[x] = sample < paletteSize ? palette[sample] : 0;
+					} else {
+						const auto gray = static_cast<uint8_t>(sample * 255 / sampleMax);
+						const bool transparent = hasTransparentColor && sample == transparentSample[0];
+						out[x] = PixelFormat::pack(gray, gray, gray, transparent ? 0 : 255);
+					}
+				}
+				continue;
+			}
+
+			const size_t pixelBytes = static_cast<size_t>(channels) * sampleStride;
+			for (uint32_t x = 0; x < width; x++) {
+				const uint8_t *pixel = samples + x * pixelBytes;
+				// 16-bit samples keep their high byte, which comes first.
+				auto sample = [&](const int channel) { return pixel[channel * sampleStride]; };
+				auto fullSample = [&](const int channel) {
+					return sampleStride == 2 ? static_cast<uint16_t>((pixel[2 * channel] << 8) | pixel[2 * channel + 1])
+											 : pixel[channel];
+				};
+				switch (colorType) {
+					case Indexed:
+						out[x] = pixel[0] < paletteSize ? palette[pixel[0]] : 0;
+						break;
+					case Grayscale: {
+						const bool transparent = hasTransparentColor && fullSample(0) == transparentSample[0];
+						out[x] = PixelFormat::pack(sample(0), sample(0), sample(0), transparent ? 0 : 255);
+						break;
+					}
+					case GrayscaleAlpha:
+						out[x] = PixelFormat::pack(sample(0), sample(0), sample(0), sample(1));
+						break;
+					case Truecolor: {
+						const bool transparent = hasTransparentColor && fullSample(0) == transparentSample[0] &&
+												 fullSample(1) == transparentSample[1] &&
+												 fullSample(2) == transparentSample[2];
+						out[x] = PixelFormat::pack(sample(0), sample(1), sample(2), transparent ? 0 : 255);
+						break;
+					}
+					default:
+						out[x] = PixelFormat::pack(sample(0), sample(1), sample(2), sample(3));
+						break;
+				}
+			}
+		}
+		return image;
+	}
+} // namespace pxe
@@ -0,0 +1,36 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief Decodes a PNG file.
+	 *
+	 * Supports every non-interlaced color type and bit depth: grayscale, RGB and palette images get
+	 * their alpha from a tRNS chunk if present, and 16-bit samples keep their high byte. Chunk CRCs are
+	 * not verified.
+	 * @param file The complete PNG file.
+	 * @return The image with straight (not premultiplied) alpha.
+	 * @throws std::runtime_error if the file is malformed, interlaced, or larger than 2^31 pixels per side.
+	 */
+	[[nodiscard]] Image decodePng(std::span<const uint8_t> file);
+} // namespace pxe
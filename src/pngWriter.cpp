@@ -0,0 +1,165 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pngWriter.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include "pixelFormat.h"
+
+namespace pxe {
+	namespace {
+		constexpr size_t maxStoredBlock = 65535;
+
+		// Slicing-by-8 tables: table[0] is the classic byte-wise CRC-32 table.
+		constexpr std::array<std::array<uint32_t, 256>, 8> crcTables = [] {
+			std::array<std::array<uint32_t, 256>, 8> tables{};
+			for (uint32_t n = 0; n < 256; n++) {
+				uint32_t c = n;
+				for (int k = 0; k < 8; k++) {
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				}
+				tables[0][n] = c;
+			}
+			for (uint32_t n = 0; n < 256; n++) {
+				for (size_t t = 1; t < 8; t++) {
+					tables[t][n] = (tables[t - 1][n] >> 8) ^ tables[0][tables[t - 1][n] & 0xFF];
+				}
+			}
+			return tables;
+		}();
+
+		uint32_t loadLittleEndian(const uint8_t *bytes) {
+			return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+		}
+
+		uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0xFFFFFFFFu) {
+			const auto &t = crcTables;
+			for (; size >= 8; size -= 8, data += 8) {
+				const uint32_t low = crc ^ loadLittleEndian(data);
+				const uint32_t high = loadLittleEndian(data + 4);
+				crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+					  t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+			}
+			for (; size > 0; size--, data++) {
+				crc = t[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+			}
+			return crc;
+		}
+
+		void appendBigEndian(std::vector<uint8_t> &out, const uint32_t value) {
+			const uint8_t bytes[] = {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+									 static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+			out.insert(out.end(), bytes, bytes + 4);
+		}
+
+		// Patches the length of the chunk starting at `chunkStart`, whose payload ends `out`, and appends its CRC.
+		void finishChunk(std::vector<uint8_t> &out, const size_t chunkStart) {
+			const size_t payloadSize = out.size() - chunkStart - 8;
+			for (int i = 0; i < 4; i++) {
+				out[chunkStart + i] = static_cast<uint8_t>(payloadSize >> (24 - 8 * i));
+			}
+			// The CRC covers the chunk type and the payload, but not the length.
+			appendBigEndian(out, crc32(out.data() + chunkStart + 4, payloadSize + 4) ^ 0xFFFFFFFFu);
+		}
+
+		size_t beginChunk(std::vector<uint8_t> &out, const char (&type)[5]) {
+			const size_t chunkStart = out.size();
+			out.insert(out.end(), 4, 0); // Length, patched by finishChunk.
+			out.insert(out.end(), type, type + 4);
+			return chunkStart;
+		}
+	} // namespace
+
+	void encodePng(const uint32_t *pixels, const int width, const int height, const int pitch,
+				   std::vector<uint8_t> &png) {
+		static constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+		const size_t rowSize = 1 + static_cast<size_t>(width) * 3; // Filter type byte, then RGB.
+		const size_t imageSize = rowSize * height;
+		const size_t blockCount = imageSize / maxStoredBlock + 1;
+
+		png.clear();
+		png.reserve(sizeof(signature) + 25 + 12 + 2 + imageSize + blockCount * 5 + 4 + 12);
+		png.insert(png.end(), signature, signature + sizeof(signature));
+
+		size_t chunk = beginChunk(png, "IHDR");
+		appendBigEndian(png, width);
+		appendBigEndian(png, height);
+		const uint8_t header[] = {8, 2, 0, 0, 0}; // 8-bit truecolor, deflate, adaptive filters, no interlace.
+		png.insert(png.end(), header, header + sizeof(header));
+		finishChunk(png, chunk);
+
+		chunk = beginChunk(png, "IDAT");
+		png.push_back(0x78); // zlib header: deflate, 32K window, no preset dictionary.
+		png.push_back(0x01);
+		const size_t dataStart = png.size();
+		for (size_t offset = 0; offset < imageSize; offset += maxStoredBlock) {
+			const auto length = static_cast<uint16_t>(std::min(imageSize - offset, maxStoredBlock));
+			const uint8_t blockHeader[] = {
+					static_cast<uint8_t>(offset + length == imageSize), // BFINAL on the last block, BTYPE 00.
+					static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8),
+					static_cast<uint8_t>(~length), static_cast<uint8_t>(~length >> 8)};
+			png.insert(png.end(), blockHeader, blockHeader + sizeof(blockHeader));
+			png.insert(png.end(), length, 0); // Filled with scanlines below.
+		}
+
+		// Convert each row to a filtered scanline, then copy it into the stored blocks around their headers.
+		std::vector<uint8_t> scanline(rowSize);
+		size_t out = dataStart + 5, blockLeft = std::min(imageSize, maxStoredBlock);
+		uint32_t adlerA = 1, adlerB = 0;
+		for (int y = 0; y < height; y++) {
+			const uint32_t *row = pixels + static_cast<size_t>(y) * pitch;
+			uint8_t *rgb = scanline.data();
+			*rgb++ = 0; // Filter type None.
+			for (int x = 0; x < width; x++) {
+				*rgb++ = PixelFormat::red(row[x]);
+				*rgb++ = PixelFormat::green(row[x]);
+				*rgb++ = PixelFormat::blue(row[x]);
+			}
+
+			// Adler-32, reduced every 5552 bytes, the longest run whose sums cannot overflow 32 bits.
+			for (size_t offset = 0; offset < rowSize;) {
+				const size_t end = std::min(rowSize, offset + 5552);
+				for (; offset < end; offset++) {
+					adlerA += scanline[offset];
+					adlerB += adlerA;
+				}
+				adlerA %= 65521;
+				adlerB %= 65521;
+			}
+
+			for (size_t copied = 0; copied < rowSize;) {
+				if (blockLeft == 0) {
+					out += 5;
+					blockLeft = maxStoredBlock;
+				}
+				const size_t count = std::min(rowSize - copied, blockLeft);
+				std::memcpy(png.data() + out, scanline.data() + copied, count);
+				out += count;
+				copied += count;
+				blockLeft -= count;
+			}
+		}
+		appendBigEndian(png, (adlerB << 16) | adlerA);
+		finishChunk(png, chunk);
+
+		chunk = beginChunk(png, "IEND");
+		finishChunk(png, chunk);
+	}
+} // namespace pxe
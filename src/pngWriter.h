@@ -0,0 +1,36 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace pxe {
+	/**
+	 * @brief Encodes a frame as a 24-bit RGB PNG.
+	 *
+	 * The image data is deflated with stored (uncompressed) blocks: files are about as large as the raw
+	 * frame, but encoding is a single linear pass, which keeps a capture writer thread ahead of 60 FPS.
+	 * @param pixels Top-left pixel, in the engine's `PixelFormat`.
+	 * @param width Width in pixels.
+	 * @param height Height in pixels.
+	 * @param pitch Distance in pixels between the starts of two rows.
+	 * @param png Receives the complete PNG file; previous contents are discarded.
+	 */
+	void encodePng(const uint32_t *pixels, int width, int height, int pitch, std::vector<uint8_t> &png);
+} // namespace pxe
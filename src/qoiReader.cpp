@@ -0,0 +1,120 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "qoiReader.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include "imageLimits.h"
+#include "pixelFormat.h"
+
+namespace pxe {
+	namespace {
+		constexpr size_t headerSize = 14;
+		constexpr size_t endMarkerSize = 8;
+		constexpr size_t maxRunLength = 62;
+
+		enum Op : uint8_t {
+			OpIndex = 0x00,
+			OpDiff = 0x40,
+			OpLuma = 0x80,
+			OpRun = 0xC0,
+			OpRgb = 0xFE,
+			OpRgba = 0xFF,
+			OpMask = 0xC0,
+		};
+
+		struct Rgba {
+			uint8_t r = 0, g = 0, b = 0, a = 255;
+
+			[[nodiscard]] int hash() const { return (r * 3 + g * 5 + b * 7 + a * 11) % 64; }
+		};
+
+		uint32_t loadBigEndian(const uint8_t *bytes) {
+			return (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+		}
+
+		[[noreturn]] void malformed() { throw std::runtime_error("Invalid QOI image"); }
+	} // namespace
+
+	Image decodeQoi(const std::span<const uint8_t> file) {
+		if (file.size() < headerSize + endMarkerSize || std::memcmp(file.data(), "qoif", 4) != 0)
+			malformed();
+		const uint32_t width = loadBigEndian(&file[4]);
+		const uint32_t height = loadBigEndian(&file[8]);
+		if (width == 0 || height == 0 || height > maxImagePixels / width || file[12] < 3 || file[12] > 4)
+			malformed();
+		// One byte encodes at most a run of 62 pixels; checked before allocating the image.
+		if (static_cast<size_t>(width) * height / maxRunLength > file.size() - headerSize - endMarkerSize)
+			malformed();
+
+		Image image(static_cast<int>(width), static_cast<int>(height));
+		const SurfaceView view = image.getView();
+		// The spec starts the index with all channels zero, alpha included, but the running pixel opaque black.
+		Rgba seen[64];
+		std::fill(std::begin(seen), std::end(seen), Rgba{0, 0, 0, 0});
+		Rgba pixel;
+		size_t offset = headerSize;
+		const size_t end = file.size() - endMarkerSize;
+		int run = 0;
+		for (uint32_t y = 0; y < height; y++) {
+			uint32_t *out = view.row(static_cast<int>(y));
+			for (uint32_t x = 0; x < width; x++) {
+				if (run > 0) {
+					run--;
+				} else {
+					if (offset >= end)
+						malformed();
+					const uint8_t op = file[offset++];
+					if (op == OpRgb || op == OpRgba) {
+						const size_t size = op == OpRgb ? 3 : 4;
+						if (end - offset < size)
+							malformed();
+						pixel.r = file[offset];
+						pixel.g = file[offset + 1];
+						pixel.b = file[offset + 2];
+						if (op == OpRgba) {
+							pixel.a = file[offset + 3];
+						}
+						offset += size;
+					} else if ((op & OpMask) == OpIndex) {
+						pixel = seen[op];
+					} else if ((op & OpMask) == OpDiff) {
+						pixel.r += ((op >> 4) & 3) - 2;
+						pixel.g += ((op >> 2) & 3) - 2;
+						pixel.b += (op & 3) - 2;
+					} else if ((op & OpMask) == OpLuma) {
+						if (offset >= end)
+							malformed();
+						const uint8_t next = file[offset++];
+						const int greenDelta = (op & 0x3F) - 32;
+						pixel.r += greenDelta - 8 + ((next >> 4) & 0x0F);
+						pixel.g += greenDelta;
+						pixel.b += greenDelta - 8 + (next & 0x0F);
+					} else {
+						run = op & 0x3F;
+					}
+					seen[pixel.hash()] = pixel;
+				}
+				out[x] = PixelFormat::pack(pixel.r, pixel.g, pixel.b, pixel.a);
+			}
+		}
+		return image;
+	}
+} // namespace pxe
@@ -0,0 +1,35 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief Decodes a QOI ("Quite OK Image") file.
+	 *
+	 * QOI decodes in a single pass without entropy coding, several times faster than PNG, which makes
+	 * it the better interchange format for large assets that are not converted offline.
+	 * @param file The complete QOI file.
+	 * @return The image with straight (not premultiplied) alpha.
+	 * @throws std::runtime_error if the file is malformed.
+	 */
+	[[nodiscard]] Image decodeQoi(std::span<const uint8_t> file);
+} // namespace pxe
@@ -0,0 +1,381 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+#include "pixelKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PXE_RASTER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PXE_RASTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace pxe {
+	namespace {
+		constexpr int blockSize = 8; ///< Edge length of the blocks a triangle's bounding box is walked in.
+
+		/**
+		 * @brief Edge function w(x, y) = a * x + b * y + c of one triangle edge, biased for the fill rule.
+		 *
+		 * A pixel is inside the edge when w >= 0.
+		 */
+		struct Edge {
+			int64_t a, b, c;
+
+			[[nodiscard]] int64_t at(const int64_t x, const int64_t y) const { return a * x + b * y + c; }
+		};
+
+		// For a triangle with positive area, the inside of the edge from (ax, ay) to (bx, by) is w > 0.
+		// Top and left edges also own the pixels exactly on them (w == 0), which the bias folds into w >= 0.
+		Edge makeEdge(const int ax, const int ay, const int bx, const int by) {
+			const int64_t a = static_cast<int64_t>(ay) - by;
+			const int64_t b = static_cast<int64_t>(bx) - ax;
+			const bool topLeft = a > 0 || (a == 0 && b > 0);
+			return {a, b, -a * ax - b * ay - (topLeft ? 0 : 1)};
+		}
+
+		/**
+		 * @brief Stores `pixel` to each of `count` pixels whose three edge values are all non-negative.
+		 *
+		 * `w0`..`w2` are the edge values at the first pixel and `a0`..`a2` their increments per pixel.
+		 */
+		void coverRow(uint32_t *row, const int count, int32_t w0, int32_t w1, int32_t w2, const int32_t a0,
+					  const int32_t a1, const int32_t a2, const uint32_t pixel) {
+			int x = 0;
+#if PXE_RASTER_SSE2
+			const __m128i color = _mm_set1_epi32(static_cast<int>(pixel));
+			__m128i e0 = _mm_setr_epi32(w0, w0 + a0, w0 + 2 * a0, w0 + 3 * a0);
+			__m128i e1 = _mm_setr_epi32(w1, w1 + a1, w1 + 2 * a1, w1 + 3 * a1);
+			__m128i e2 = _mm_setr_epi32(w2, w2 + a2, w2 + 2 * a2, w2 + 3 * a2);
+			const __m128i step0 = _mm_set1_epi32(4 * a0), step1 = _mm_set1_epi32(4 * a1);
+			const __m128i step2 = _mm_set1_epi32(4 * a2);
+			for (; x + 4 <= count; x += 4) {
+				// All ones in the lanes where any edge value is negative.
+				const __m128i outside = _mm_srai_epi32(_mm_or_si128(_mm_or_si128(e0, e1), e2), 31);
+				auto *dst = reinterpret_cast<__m128i *>(row + x);
+				const __m128i old = _mm_loadu_si128(dst);
+				_mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(outside, old), _mm_andnot_si128(outside, color)));
+				e0 = _mm_add_epi32(e0, step0);
+				e1 = _mm_add_epi32(e1, step1);
+				e2 = _mm_add_epi32(e2, step2);
+			}
+			w0 += x * a0;
+			w1 += x * a1;
+			w2 += x * a2;
+#elif PXE_RASTER_NEON
+			const uint32x4_t color = vdupq_n_u32(pixel);
+			const int32_t lanes[] = {0, 1, 2, 3};
+			const int32x4_t lane = vld1q_s32(lanes);
+			int32x4_t e0 = vmlaq_n_s32(vdupq_n_s32(w0), lane, a0);
+			int32x4_t e1 = vmlaq_n_s32(vdupq_n_s32(w1), lane, a1);
+			int32x4_t e2 = vmlaq_n_s32(vdupq_n_s32(w2), lane, a2);
+			for (; x + 4 <= count; x += 4) {
+				// All ones in the lanes where every edge value is non-negative.
+				const uint32x4_t inside = vcgeq_s32(vorrq_s32(vorrq_s32(e0, e1), e2), vdupq_n_s32(0));
+				vst1q_u32(row + x, vbslq_u32(inside, color, vld1q_u32(row + x)));
+				e0 = vaddq_s32(e0, vdupq_n_s32(4 * a0));
+				e1 = vaddq_s32(e1, vdupq_n_s32(4 * a1));
+				e2 = vaddq_s32(e2, vdupq_n_s32(4 * a2));
+			}
+			w0 += x * a0;
+			w1 += x * a1;
+			w2 += x * a2;
+#endif
+			for (; x < count; x++) {
+				if ((w0 | w1 | w2) >= 0) {
+					row[x] = pixel;
+				}
+				w0 += a0;
+				w1 += a1;
+				w2 += a2;
+			}
+		}
+
+		// Integer square root, exact for every non-negative 64-bit value a circle can produce.
+		int64_t isqrt(const int64_t value) {
+			auto root = static_cast<int64_t>(std::sqrt(static_cast<double>(value)));
+			while (root * root > value) {
+				root--;
+			}
+			while ((root + 1) * (root + 1) <= value) {
+				root++;
+			}
+			return root;
+		}
+
+		Rect intersect(const Rect &a, const Rect &b) {
+			const int x0 = std::max(a.x, b.x), y0 = std::max(a.y, b.y);
+			const int x1 = std::min(a.right(), b.right()), y1 = std::min(a.bottom(), b.bottom());
+			if (x0 >= x1 || y0 >= y1)
+				return {};
+			return {x0, y0, x1 - x0, y1 - y0};
+		}
+	} // namespace
+
+	bool clipLine(const Rect &bounds, Line &line) {
+		if (bounds.isEmpty())
+			return false;
+		const int xMax = bounds.right() - 1, yMax = bounds.bottom() - 1;
+		auto inside = [&](const int x, const int y) {
+			return x >= bounds.x && x <= xMax && y >= bounds.y && y <= yMax;
+		};
+		if (inside(line.x0, line.y0) && inside(line.x1, line.y1))
+			return true;
+
+		// Liang–Barsky: intersect the parameter range [0, 1] with the range inside each of the four edges.
+		const double dx = static_cast<double>(line.x1) - line.x0, dy = static_cast<double>(line.y1) - line.y0;
+		const double p[] = {-dx, dx, -dy, dy};
+		const double q[] = {static_cast<double>(line.x0) - bounds.x, static_cast<double>(xMax) - line.x0,
+							static_cast<double>(line.y0) - bounds.y, static_cast<double>(yMax) - line.y0};
+		double t0 = 0.0, t1 = 1.0;
+		for (int edge = 0; edge < 4; edge++) {
+			if (p[edge] == 0.0) {
+				if (q[edge] < 0.0)
+					return false;
+				continue;
+			}
+			const double t = q[edge] / p[edge];
+			if (p[edge] < 0.0) {
+				t0 = std::max(t0, t);
+			} else {
+				t1 = std::min(t1, t);
+			}
+			if (t0 > t1)
+				return false;
+		}
+
+		// Rounding can push an endpoint one pixel past the edge it was clipped to; clamp it back.
+		auto clampX = [&](const double x) { return std::clamp(static_cast<int>(std::lround(x)), bounds.x, xMax); };
+		auto clampY = [&](const double y) { return std::clamp(static_cast<int>(std::lround(y)), bounds.y, yMax); };
+		const Line original = line;
+		line.x0 = clampX(original.x0 + t0 * dx);
+		line.y0 = clampY(original.y0 + t0 * dy);
+		line.x1 = clampX(original.x0 + t1 * dx);
+		line.y1 = clampY(original.y0 + t1 * dy);
+		return true;
+	}
+
+	void rasterizeLine(const SurfaceView &view, const Line &line, const uint32_t pixel) {
+		const FillKernels &kernels = fillKernels();
+		const auto pitch = static_cast<ptrdiff_t>(view.getPitch());
+		if (line.y0 == line.y1) {
+			kernels.fillSpan(view.row(line.y0) + std::min(line.x0, line.x1), std::abs(line.x1 - line.x0) + 1, pixel);
+			return;
+		}
+		if (line.x0 == line.x1) {
+			kernels.fillColumn(view.row(std::min(line.y0, line.y1)) + line.x0, std::abs(line.y1 - line.y0) + 1,
+							   pitch, pixel);
+			return;
+		}
+
+		// Walk the major axis one pixel at a time, stepping along the minor axis whenever the error underflows.
+		int majorLength = std::abs(line.x1 - line.x0), minorLength = std::abs(line.y1 - line.y0);
+		ptrdiff_t majorStep = line.x0 < line.x1 ? 1 : -1;
+		ptrdiff_t minorStep = line.y0 < line.y1 ? pitch : -pitch;
+		if (minorLength > majorLength) {
+			std::swap(majorLength, minorLength);
+			std::swap(majorStep, minorStep);
+		}
+		uint32_t *dst = view.row(line.y0) + line.x0;
+		int error = majorLength / 2;
+		*dst = pixel;
+		for (int i = 0; i < majorLength; i++) {
+			dst += majorStep;
+			error -= minorLength;
+			if (error < 0) {
+				dst += minorStep;
+				error += majorLength;
+			}
+			*dst = pixel;
+		}
+	}
+
+	void rasterizeLineRegion(const SurfaceView &view, const Rect &region, const Line &line, const uint32_t pixel) {
+		const Rect clipped = intersect(region, {std::min(line.x0, line.x1), std::min(line.y0, line.y1),
+												std::abs(line.x1 - line.x0) + 1, std::abs(line.y1 - line.y0) + 1});
+		if (clipped.isEmpty())
+			return;
+		if (line.y0 == line.y1 || line.x0 == line.x1) {
+			const SurfaceView target = view.subView({clipped.x - region.x, clipped.y - region.y, clipped.width,
+													 clipped.height});
+			pxe::fillRect(fillKernels(), target.row(0), target.getWidth(), target.getHeight(), target.getPitch(),
+						  pixel);
+			return;
+		}
+
+		// The same walk as rasterizeLine, with the same choice of major axis, started at the region's edge.
+		const bool xMajor = std::abs(line.y1 - line.y0) <= std::abs(line.x1 - line.x0);
+		const int majorStart = xMajor ? line.x0 : line.y0, minorStart = xMajor ? line.y0 : line.x0;
+		const int majorEnd = xMajor ? line.x1 : line.y1, minorEnd = xMajor ? line.y1 : line.x1;
+		const int64_t majorLength = std::abs(majorEnd - majorStart), minorLength = std::abs(minorEnd - minorStart);
+		const int majorStep = majorStart < majorEnd ? 1 : -1, minorStep = minorStart < minorEnd ? 1 : -1;
+		const int low = xMajor ? clipped.x : clipped.y, high = (xMajor ? clipped.right() : clipped.bottom()) - 1;
+		const int minorLow = xMajor ? clipped.y : clipped.x, minorHigh = xMajor ? clipped.bottom() : clipped.right();
+		const int64_t first = majorStep > 0 ? low - majorStart : majorStart - high;
+		const int64_t last = majorStep > 0 ? high - majorStart : majorStart - low;
+
+		// After i steps the error has dropped by i * minorLength and been raised by majorLength once per
+		// minor step, which keeps it in [0, majorLength).
+		const int64_t deficit = first * minorLength - majorLength / 2;
+		const int64_t minorSteps = deficit > 0 ? (deficit + majorLength - 1) / majorLength : 0;
+		int64_t error = majorLength / 2 - first * minorLength + minorSteps * majorLength;
+		int major = majorStart + static_cast<int>(first) * majorStep;
+		int minor = minorStart + static_cast<int>(minorSteps) * minorStep;
+		for (int64_t i = first; i <= last; i++) {
+			if (minor >= minorLow && minor < minorHigh) {
+				const int x = xMajor ? major : minor, y = xMajor ? minor : major;
+				view.row(y - region.y)[x - region.x] = pixel;
+			}
+			major += majorStep;
+			error -= minorLength;
+			if (error < 0) {
+				minor += minorStep;
+				error += majorLength;
+			}
+		}
+	}
+
+	Rect rasterizeCircle(const SurfaceView &view, const int centerX, const int centerY, const int radius,
+						 const uint32_t pixel, const bool filled) {
+		if (radius < 0)
+			return {};
+		const Rect bounds = intersect({centerX - radius, centerY - radius, 2 * radius + 1, 2 * radius + 1},
+									  {0, 0, view.getWidth(), view.getHeight()});
+		if (bounds.isEmpty())
+			return {};
+
+		if (filled) {
+			// Rows of pixels within radius + 1/2 of the center, the same pixels the outline encloses.
+			const FillKernels &kernels = fillKernels();
+			const int64_t limit = static_cast<int64_t>(radius) * radius + radius;
+			for (int y = bounds.y; y < bounds.bottom(); y++) {
+				const int64_t dy = y - centerY;
+				const auto half = static_cast<int>(isqrt(limit - dy * dy));
+				const int x0 = std::max(centerX - half, bounds.x), x1 = std::min(centerX + half + 1, bounds.right());
+				if (x0 < x1) {
+					kernels.fillSpan(view.row(y) + x0, x1 - x0, pixel);
+				}
+			}
+			return bounds;
+		}
+
+		// Only circles crossing the view's edges pay for a bounds check per pixel.
+		const bool clipped = bounds.width != 2 * radius + 1 || bounds.height != 2 * radius + 1;
+		auto plot = [&](const int x, const int y) {
+			if (!clipped || (x >= bounds.x && x < bounds.right() && y >= bounds.y && y < bounds.bottom())) {
+				view.row(y)[x] = pixel;
+			}
+		};
+		int x = radius, y = 0, error = 1 - radius;
+		while (x >= y) {
+			plot(centerX + x, centerY + y);
+			plot(centerX - x, centerY + y);
+			plot(centerX + x, centerY - y);
+			plot(centerX - x, centerY - y);
+			plot(centerX + y, centerY + x);
+			plot(centerX - y, centerY + x);
+			plot(centerX + y, centerY - x);
+			plot(centerX - y, centerY - x);
+			y++;
+			if (error < 0) {
+				error += 2 * y + 1;
+			} else {
+				x--;
+				error += 2 * (y - x) + 1;
+			}
+		}
+		return bounds;
+	}
+
+	Rect rasterizeTriangle(const SurfaceView &view, const int x0, const int y0, int x1, int y1, int x2, int y2,
+						   const uint32_t pixel) {
+		const int64_t area = (static_cast<int64_t>(x1) - x0) * (static_cast<int64_t>(y2) - y0) -
+							 (static_cast<int64_t>(y1) - y0) * (static_cast<int64_t>(x2) - x0);
+		if (area == 0)
+			return {};
+		if (area < 0) {
+			std::swap(x1, x2);
+			std::swap(y1, y2);
+		}
+
+		const int minX = std::min({x0, x1, x2}), maxX = std::max({x0, x1, x2});
+		const int minY = std::min({y0, y1, y2}), maxY = std::max({y0, y1, y2});
+		// Samples sit on pixel corners and right/bottom edges are exclusive, so maxX and maxY are never covered.
+		const Rect bounds =
+				intersect({minX, minY, maxX - minX, maxY - minY}, {0, 0, view.getWidth(), view.getHeight()});
+		if (bounds.isEmpty())
+			return {};
+
+		const Edge edges[] = {makeEdge(x0, y0, x1, y1), makeEdge(x1, y1, x2, y2), makeEdge(x2, y2, x0, y0)};
+		const FillKernels &kernels = fillKernels();
+
+		// Blocks are aligned to the view so adjacent triangles classify shared blocks identically.
+		const int firstBlockX = bounds.x & ~(blockSize - 1), firstBlockY = bounds.y & ~(blockSize - 1);
+		for (int blockY = firstBlockY; blockY < bounds.bottom(); blockY += blockSize) {
+			const int top = std::max(blockY, bounds.y), bottom = std::min(blockY + blockSize, bounds.bottom());
+			for (int blockX = firstBlockX; blockX < bounds.right(); blockX += blockSize) {
+				const int left = std::max(blockX, bounds.x), right = std::min(blockX + blockSize, bounds.right());
+
+				// Edge functions are linear, so their extremes over the block are at its corners.
+				bool outside = false, covered = true, fitsInt32 = true;
+				for (const Edge &edge: edges) {
+					const int64_t corners[] = {edge.at(left, top), edge.at(right - 1, top), edge.at(left, bottom - 1),
+											   edge.at(right - 1, bottom - 1)};
+					const int64_t low = std::min({corners[0], corners[1], corners[2], corners[3]});
+					const int64_t high = std::max({corners[0], corners[1], corners[2], corners[3]});
+					outside |= high < 0;
+					covered &= low >= 0;
+					fitsInt32 &= low > INT32_MIN / 2 && high < INT32_MAX / 2 && std::abs(edge.a) < (1 << 24);
+				}
+				if (outside)
+					continue;
+				if (covered) {
+					for (int y = top; y < bottom; y++) {
+						kernels.fillSpan(view.row(y) + left, right - left, pixel);
+					}
+					continue;
+				}
+
+				for (int y = top; y < bottom; y++) {
+					uint32_t *row = view.row(y) + left;
+					if (fitsInt32) {
+						coverRow(row, right - left, static_cast<int32_t>(edges[0].at(left, y)),
+								 static_cast<int32_t>(edges[1].at(left, y)), static_cast<int32_t>(edges[2].at(left, y)),
+								 static_cast<int32_t>(edges[0].a), static_cast<int32_t>(edges[1].a),
+								 static_cast<int32_t>(edges[2].a), pixel);
+						continue;
+					}
+					// Huge off-screen vertices: stay in 64 bits.
+					for (int x = left; x < right; x++) {
+						if (edges[0].at(x, y) >= 0 && edges[1].at(x, y) >= 0 && edges[2].at(x, y) >= 0) {
+							row[x - left] = pixel;
+						}
+					}
+				}
+			}
+		}
+		return bounds;
+	}
+} // namespace pxe
@@ -0,0 +1,88 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include "geometry.h"
+#include "surfaceView.h"
+
+namespace pxe {
+	/**
+	 * @brief Clips a line segment against a rectangle (Liang–Barsky).
+	 *
+	 * The clipped endpoints are rounded to the nearest pixel and always lie inside `bounds`, so the
+	 * segment can then be rasterized without any per-pixel bounds check.
+	 * @param bounds The clip rectangle.
+	 * @param line The segment to clip, updated in place.
+	 * @return False if no part of the segment is inside `bounds`.
+	 */
+	[[nodiscard]] bool clipLine(const Rect &bounds, Line &line);
+
+	/**
+	 * @brief Draws a line whose endpoints both lie inside the view (Bresenham).
+	 *
+	 * Horizontal and vertical lines are filled as spans with the fastest available fill kernels.
+	 * @param view The destination.
+	 * @param line The segment, already clipped to the view with `clipLine`.
+	 * @param pixel The packed pixel value to store.
+	 */
+	void rasterizeLine(const SurfaceView &view, const Line &line, uint32_t pixel);
+
+	/**
+	 * @brief Draws the part of a line inside a region, exactly the pixels `rasterizeLine` would draw there.
+	 *
+	 * Lets a line be split across tiles: drawing it into every tile it crosses, in any order, produces the
+	 * same image as drawing it once. Only the steps of the line's major axis inside the region are walked.
+	 * @param view The destination, covering `region`.
+	 * @param region The part of the surface the view covers, in surface coordinates.
+	 * @param line The segment in surface coordinates, already clipped to the surface with `clipLine`.
+	 * @param pixel The packed pixel value to store.
+	 */
+	void rasterizeLineRegion(const SurfaceView &view, const Rect &region, const Line &line, uint32_t pixel);
+
+	/**
+	 * @brief Draws the outline or the interior of a circle (midpoint algorithm), clipped to the view.
+	 *
+	 * Filled circles cover the pixels whose distance to the center is at most about `radius`, matching
+	 * the outline drawn with the same radius.
+	 * @param view The destination.
+	 * @param centerX X-coordinate of the center.
+	 * @param centerY Y-coordinate of the center.
+	 * @param radius Radius in pixels; negative radii draw nothing.
+	 * @param pixel The packed pixel value to store.
+	 * @param filled True to fill the circle, false to draw its one pixel wide outline.
+	 * @return The region that may have been modified, clipped to the view.
+	 */
+	Rect rasterizeCircle(const SurfaceView &view, int centerX, int centerY, int radius, uint32_t pixel, bool filled);
+
+	/**
+	 * @brief Fills a triangle with the half-space method, clipped to the view.
+	 *
+	 * Vertices sit on pixel corners and pixels are sampled at their top-left corner with a top-left fill
+	 * rule, so triangles sharing an edge never overlap or leave gaps, and two triangles splitting a
+	 * rectangle cover exactly the pixels `fillRect` would. The bounding box is walked in 8x8 blocks:
+	 * blocks outside an edge are skipped, blocks inside all edges are filled as spans, and only blocks
+	 * straddling an edge evaluate the edge functions per pixel (four at a time with SIMD).
+	 * Either winding order is accepted.
+	 * @param view The destination.
+	 * @param x0, y0, x1, y1, x2, y2 The vertices.
+	 * @param pixel The packed pixel value to store.
+	 * @return The region that may have been modified, clipped to the view.
+	 */
+	Rect rasterizeTriangle(const SurfaceView &view, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t pixel);
+} // namespace pxe
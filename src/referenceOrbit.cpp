@@ -0,0 +1,133 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "referenceOrbit.h"
+#include <algorithm>
+#include <cmath>
+#include "fractalKernels.h"
+
+namespace pxe {
+	namespace {
+		// Plain arithmetic instead of std::complex, whose multiplication checks for infinities and NaNs.
+		struct Series {
+			double ar = 0.0, ai = 0.0, br = 0.0, bi = 0.0, cr = 0.0, ci = 0.0;
+		};
+	} // namespace
+
+	void ReferenceOrbit::setPoint(const BigFixed &real, const BigFixed &imag) {
+		pointReal = real;
+		pointImag = imag;
+		orbit.clear();
+	}
+
+	void ReferenceOrbit::offset(const double real, const double imag) {
+		pointReal = pointReal + BigFixed::fromDouble(real);
+		pointImag = pointImag + BigFixed::fromDouble(imag);
+		orbit.clear();
+	}
+
+	double ReferenceOrbit::getReal() const { return pointReal.toDouble(); }
+
+	double ReferenceOrbit::getImag() const { return pointImag.toDouble(); }
+
+	int ReferenceOrbit::precisionFor(const double scale) {
+		// The bits down to one pixel, plus 64 guard bits for the error that builds up along the orbit.
+		const double bits = -std::log2(scale) + 64.0;
+		return std::clamp(static_cast<int>(std::ceil(bits / 32.0)), 2, BigFixed::maxFractionLimbs);
+	}
+
+	void ReferenceOrbit::compute(const int precision, const int maxIterations, const double radius) {
+		this->maxIterations = maxIterations;
+		orbit.clear();
+		orbit.push_back({0.0, 0.0});
+		BigFixed zr, zi;
+		for (int n = 0; n < maxIterations; n++) {
+			const BigFixed zr2 = zr.multiply(zr, precision);
+			const BigFixed zi2 = zi.multiply(zi, precision);
+			const BigFixed zri = zr.multiply(zi, precision);
+			zr = zr2 - zi2 + pointReal;
+			zi = zri + zri + pointImag;
+			const Complex z{zr.toDouble(), zi.toDouble()};
+			orbit.push_back(z);
+			// Radius 2 suffices for the reference; pixels that have not escaped yet are rebased onto Z_0.
+			if (z.real * z.real + z.imag * z.imag > 4.0)
+				break;
+		}
+
+		// A' = 2ZA + 1, B' = 2ZB + A², C' = 2ZC + 2AB, starting from zero at Z_0.
+		Series series;
+		seriesA = seriesB = seriesC = {};
+		skipped = 0;
+		const double radius2 = radius * radius;
+		const int last = static_cast<int>(orbit.size()) - 1;
+		for (int n = 0; n < last; n++) {
+			const double zr2 = 2.0 * orbit[n].real, zi2 = 2.0 * orbit[n].imag;
+			Series next;
+			next.ar = zr2 * series.ar - zi2 * series.ai + 1.0;
+			next.ai = zr2 * series.ai + zi2 * series.ar;
+			next.br = zr2 * series.br - zi2 * series.bi + series.ar * series.ar - series.ai * series.ai;
+			next.bi = zr2 * series.bi + zi2 * series.br + 2.0 * series.ar * series.ai;
+			next.cr = zr2 * series.cr - zi2 * series.ci + 2.0 * (series.ar * series.br - series.ai * series.bi);
+			next.ci = zr2 * series.ci + zi2 * series.cr + 2.0 * (series.ar * series.bi + series.ai * series.br);
+			const double magnitudeA = std::hypot(next.ar, next.ai);
+			const double magnitudeC = std::hypot(next.cr, next.ci);
+			if (!std::isfinite(magnitudeC) || magnitudeC * radius2 > seriesTolerance * magnitudeA)
+				break;
+			series = next;
+			skipped = n + 1;
+		}
+		seriesA = {series.ar, series.ai};
+		seriesB = {series.br, series.bi};
+		seriesC = {series.cr, series.ci};
+	}
+
+	float ReferenceOrbit::escape(const double deltaReal, const double deltaImag) const {
+		// d = A dc + B dc² + C dc³, evaluated as ((C dc + B) dc + A) dc.
+		double hr = seriesC.real * deltaReal - seriesC.imag * deltaImag + seriesB.real;
+		double hi = seriesC.real * deltaImag + seriesC.imag * deltaReal + seriesB.imag;
+		double tr = hr * deltaReal - hi * deltaImag + seriesA.real;
+		double ti = hr * deltaImag + hi * deltaReal + seriesA.imag;
+		double dr = tr * deltaReal - ti * deltaImag;
+		double di = tr * deltaImag + ti * deltaReal;
+
+		const size_t last = orbit.size() - 1;
+		size_t reference = static_cast<size_t>(skipped);
+		for (int n = skipped; n <= maxIterations; n++) {
+			const double zr = orbit[reference].real + dr;
+			const double zi = orbit[reference].imag + di;
+			const double magnitude = zr * zr + zi * zi;
+			if (magnitude > fractalBailout)
+				return smoothEscapeValue(n, magnitude);
+			if (n == maxIterations)
+				break;
+			if (magnitude < dr * dr + di * di || reference == last) {
+				dr = zr;
+				di = zi;
+				reference = 0;
+			}
+			// d' = (2Z + d) d + dc
+			const double sr = 2.0 * orbit[reference].real + dr;
+			const double si = 2.0 * orbit[reference].imag + di;
+			const double nextR = sr * dr - si * di + deltaReal;
+			di = sr * di + si * dr + deltaImag;
+			dr = nextR;
+			reference++;
+		}
+		return fractalInterior;
+	}
+} // namespace pxe
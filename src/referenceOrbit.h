@@ -0,0 +1,98 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <vector>
+#include "bigFixed.h"
+
+namespace pxe {
+	/**
+	 * @brief A high-precision Mandelbrot orbit that every pixel near it is iterated against.
+	 *
+	 * Perturbation theory: with the reference orbit Z iterated in `BigFixed` at the view center C, a pixel
+	 * at c = C + dc follows z = Z + d with d' = 2Zd + d² + dc, which plain doubles represent well because d
+	 * stays tiny relative to the view. A cubic series in dc, fitted along the orbit, evaluates the first
+	 * iterations of every pixel at once.
+	 *
+	 * Pixels whose orbit drifts away from the reference (the "glitches" of naive perturbation) are rebased:
+	 * once |z| < |d|, or the reference ends, d restarts as z against the beginning of the orbit, which is
+	 * equivalent because Z starts at 0.
+	 */
+	class ReferenceOrbit {
+	public:
+		/**
+		 * @brief Places the reference point; `compute` must be called before the next `escape`.
+		 */
+		void setPoint(const BigFixed &real, const BigFixed &imag);
+
+		/**
+		 * @brief Moves the reference point by an offset, at full precision.
+		 */
+		void offset(double real, double imag);
+
+		/**
+		 * @brief Gets the reference point, rounded to doubles.
+		 */
+		[[nodiscard]] double getReal() const;
+		[[nodiscard]] double getImag() const;
+
+		/**
+		 * @brief Iterates the orbit of the reference point and fits the series approximation.
+		 * @param precision Fraction limbs used by the iteration; see `precisionFor`.
+		 * @param maxIterations The iteration limit of the pixels.
+		 * @param radius Largest |dc| of any pixel, which bounds the error of the series.
+		 */
+		void compute(int precision, int maxIterations, double radius);
+
+		/**
+		 * @brief Computes the smooth escape value of the point at `dc` from the reference point.
+		 *
+		 * Thread-safe once `compute` returned.
+		 * @return The smooth escape value, or `fractalInterior`.
+		 */
+		[[nodiscard]] float escape(double deltaReal, double deltaImag) const;
+
+		/**
+		 * @brief Gets the number of iterations every pixel skips through the series approximation.
+		 */
+		[[nodiscard]] int getSkippedIterations() const { return skipped; }
+
+		/**
+		 * @brief Gets the number of fraction limbs needed to iterate a view of the given scale.
+		 */
+		[[nodiscard]] static int precisionFor(double scale);
+
+	private:
+		struct Complex {
+			double real;
+			double imag;
+		};
+
+		/// Keeps the series while its cubic term stays this small relative to the linear one.
+		static constexpr double seriesTolerance = 1e-9;
+
+		BigFixed pointReal;
+		BigFixed pointImag;
+		std::vector<Complex> orbit; ///< Z_0 = 0 up to the first escaped value or Z at the iteration limit.
+		int maxIterations = 0;
+		int skipped = 0;
+		Complex seriesA{}; ///< Series coefficients at iteration `skipped`: d = A dc + B dc² + C dc³.
+		Complex seriesB{};
+		Complex seriesC{};
+	};
+} // namespace pxe
@@ -0,0 +1,53 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resolutionScaler.h"
+#include <algorithm>
+
+namespace pxe {
+	void ResolutionScaler::configure(const double budgetMilliseconds, const double minimumScale) {
+		budget = budgetMilliseconds;
+		this->minimumScale = std::clamp(minimumScale, 0.01, 1.0);
+		scale = 1.0;
+		averageCost = 0.0;
+		cooldown = cooldownFrames;
+	}
+
+	bool ResolutionScaler::record(const double milliseconds) {
+		averageCost = averageCost == 0.0 ? milliseconds : averageCost + (milliseconds - averageCost) * 0.1;
+		if (cooldown > 0) {
+			cooldown--;
+			return false;
+		}
+
+		double next = scale;
+		if (averageCost > budget) {
+			next = std::max(scale * 0.9, minimumScale);
+		} else if (averageCost < budget * 0.7) {
+			next = std::min(scale * 1.05, 1.0);
+		}
+		if (next == scale)
+			return false;
+
+		// The cost scales roughly with the pixel count, i.e. with the square of the scale.
+		averageCost *= next * next / (scale * scale);
+		scale = next;
+		cooldown = cooldownFrames;
+		return true;
+	}
+} // namespace pxe
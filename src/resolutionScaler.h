@@ -0,0 +1,60 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace pxe {
+	/**
+	 * @brief Chooses the render scale of dynamic-resolution mode from measured frame costs.
+	 *
+	 * Costs are smoothed with an exponential moving average. When the average exceeds the budget the scale
+	 * drops by 10%, and when it stays below 70% of the budget the scale grows by 5% again, up to 1. The
+	 * asymmetric steps and a cool-down after every change keep it from oscillating between two sizes.
+	 */
+	class ResolutionScaler {
+	public:
+		/// Frames to wait after a change before the next one, so the average reflects the new size.
+		static constexpr int cooldownFrames = 30;
+
+		/**
+		 * @brief Sets the frame budget and the smallest scale, and returns to full resolution.
+		 * @param budgetMilliseconds CPU time a frame may take.
+		 * @param minimumScale Lower bound of the scale, in (0, 1].
+		 */
+		void configure(double budgetMilliseconds, double minimumScale);
+
+		/**
+		 * @brief Records the cost of a frame.
+		 * @param milliseconds CPU time of the frame, excluding waits for the display.
+		 * @return True if the scale changed.
+		 */
+		bool record(double milliseconds);
+
+		/**
+		 * @brief Gets the current scale, in [minimumScale, 1].
+		 */
+		[[nodiscard]] double getScale() const { return scale; }
+
+	private:
+		double budget = 1000.0 / 60.0;
+		double minimumScale = 0.5;
+		double scale = 1.0;
+		double averageCost = 0.0;
+		int cooldown = 0;
+	};
+} // namespace pxe
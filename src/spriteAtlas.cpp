@@ -0,0 +1,54 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "spriteAtlas.h"
+#include <stdexcept>
+
+namespace pxe {
+	SpriteAtlas::SpriteAtlas() : packer(size, size) {}
+
+	SpriteId SpriteAtlas::add(const Image &image) {
+		if (image.getWidth() <= 0 || image.getHeight() <= 0)
+			throw std::invalid_argument("Sprite images must not be empty");
+
+		// Reserve the gutter on the right and bottom; the atlas edges act as the gutter on the other sides.
+		const auto slot = packer.insert(image.getWidth() + gutter, image.getHeight() + gutter);
+		if (!slot)
+			throw std::runtime_error("Sprite atlas is full");
+
+		const Rect region{slot->x, slot->y, image.getWidth(), image.getHeight()};
+		regions.push_back(region);
+		{
+			std::lock_guard lock(pendingMutex);
+			pending.push_back({region, image});
+		}
+		return {static_cast<int>(regions.size()) - 1};
+	}
+
+	const Rect &SpriteAtlas::getRegion(const SpriteId sprite) const {
+		if (sprite.index < 0 || static_cast<size_t>(sprite.index) >= regions.size())
+			throw std::out_of_range("Unknown sprite");
+		return regions[sprite.index];
+	}
+
+	void SpriteAtlas::takePendingUploads(std::vector<PendingUpload> &uploads) {
+		uploads.clear();
+		std::lock_guard lock(pendingMutex);
+		uploads.swap(pending);
+	}
+} // namespace pxe
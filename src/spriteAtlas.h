@@ -0,0 +1,77 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <mutex>
+#include <vector>
+#include "atlasPacker.h"
+#include "geometry.h"
+#include "image.h"
+#include "sprite.h"
+
+namespace pxe {
+	/**
+	 * @brief CPU side of the sprite atlas: packs images into one texture-sized area and queues their pixels.
+	 *
+	 * Adding sprites never touches OpenGL, so it works from any thread that draws; the thread owning the
+	 * GL context collects the queued images with `takePendingUploads()`. Sprites are separated by a
+	 * transparent gutter so scaled or rotated sprites do not sample their neighbours.
+	 */
+	class SpriteAtlas {
+	public:
+		/// Edge length in pixels of the square atlas texture; 16 MiB of RGBA8, supported by every GL 3.3 driver.
+		static constexpr int size = 2048;
+
+		/// An image waiting to be copied into the atlas texture.
+		struct PendingUpload {
+			Rect region; ///< Destination in the atlas, in texels.
+			Image image; ///< The pixels to copy.
+		};
+
+		SpriteAtlas();
+
+		/**
+		 * @brief Reserves space for an image and queues its pixels for upload.
+		 * @param image The sprite; copied, so it may be destroyed afterwards.
+		 * @return The handle to draw the sprite with.
+		 * @throws std::invalid_argument if the image is empty.
+		 * @throws std::runtime_error if the atlas has no room left for the image.
+		 */
+		SpriteId add(const Image &image);
+
+		/**
+		 * @brief Gets the atlas region of a sprite.
+		 * @throws std::out_of_range if the handle does not belong to this atlas.
+		 */
+		[[nodiscard]] const Rect &getRegion(SpriteId sprite) const;
+
+		/**
+		 * @brief Moves the images added since the previous call into `uploads`.
+		 * @param uploads Receives the pending images; previous contents are discarded.
+		 */
+		void takePendingUploads(std::vector<PendingUpload> &uploads);
+
+	private:
+		static constexpr int gutter = 1; ///< Transparent texels kept between sprites.
+
+		AtlasPacker packer;
+		std::vector<Rect> regions; ///< Atlas region of each sprite, indexed by `SpriteId::index`.
+		std::mutex pendingMutex; ///< Guards `pending`, which the presenting thread drains.
+		std::vector<PendingUpload> pending;
+	};
+} // namespace pxe
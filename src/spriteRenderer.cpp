@@ -0,0 +1,154 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "spriteRenderer.h"
+#include <algorithm>
+#include <cstddef>
+#include "glPixelFormat.h"
+#include "glProgram.h"
+#include "pixelFormat.h"
+
+namespace pxe {
+	namespace {
+		auto spriteVertexShaderSource = R"(
+            #version 330 core
+            layout (location = 0) in vec4 aDestination;
+            layout (location = 1) in vec4 aSource;
+            layout (location = 2) in float aRotation;
+            layout (location = 3) in uint aTint;
+            uniform vec2 surfaceSize;
+            uniform uvec4 channelShifts;
+            out vec2 TexCoord;
+            out vec4 Tint;
+            void main() {
+                vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+                vec2 offset = (corner - 0.5) * aDestination.zw;
+                float s = sin(aRotation), c = cos(aRotation);
+                vec2 position = aDestination.xy + 0.5 * aDestination.zw + vec2(c * offset.x - s * offset.y,
+                                                                               s * offset.x + c * offset.y);
+                // Same mapping as the display quad: surface row 0 is the top of the viewport.
+                vec2 ndc = position / surfaceSize * 2.0 - 1.0;
+                gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+                TexCoord = mix(aSource.xy, aSource.zw, corner);
+                Tint = vec4((uvec4(aTint) >> channelShifts) & 0xFFu) / 255.0;
+            }
+        )";
+
+		auto spriteFragmentShaderSource = R"(
+            #version 330 core
+            out vec4 FragColor;
+            in vec2 TexCoord;
+            in vec4 Tint;
+            uniform sampler2D atlas;
+            void main() {
+                FragColor = texture(atlas, TexCoord) * Tint;
+            }
+        )";
+	} // namespace
+
+	SpriteRenderer::SpriteRenderer() {
+		program = linkProgram(spriteVertexShaderSource, spriteFragmentShaderSource);
+		surfaceSizeLocation = glGetUniformLocation(program, "surfaceSize");
+		glUseProgram(program);
+		glUniform4ui(glGetUniformLocation(program, "channelShifts"), PixelFormat::redShift, PixelFormat::greenShift,
+					 PixelFormat::blueShift, PixelFormat::alphaShift);
+
+		glGenVertexArrays(1, &vertexArray);
+		glGenBuffers(1, &instanceBuffer);
+		glBindVertexArray(vertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		constexpr auto stride = static_cast<GLsizei>(sizeof(SpriteInstance));
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(offsetof(SpriteInstance, x)));
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(offsetof(SpriteInstance, u0)));
+		glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride,
+							  reinterpret_cast<void *>(offsetof(SpriteInstance, rotation)));
+		glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, stride, reinterpret_cast<void *>(offsetof(SpriteInstance, tint)));
+		for (GLuint attribute = 0; attribute < 4; attribute++) {
+			glEnableVertexAttribArray(attribute);
+			glVertexAttribDivisor(attribute, 1);
+		}
+		glBindVertexArray(0);
+
+		// Start fully transparent so the gutters between sprites blend to nothing.
+		const std::vector<uint32_t> transparent(static_cast<size_t>(SpriteAtlas::size) * SpriteAtlas::size, 0);
+		GLint rowLength;
+		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+		glGenTextures(1, &atlasTexture);
+		glBindTexture(GL_TEXTURE_2D, atlasTexture);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, surfaceGLFormat.internalFormat, SpriteAtlas::size, SpriteAtlas::size, 0,
+					 surfaceGLFormat.format, surfaceGLFormat.type, transparent.data());
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength); // Restored for the display texture uploads.
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+
+	SpriteRenderer::~SpriteRenderer() {
+		glDeleteTextures(1, &atlasTexture);
+		glDeleteBuffers(1, &instanceBuffer);
+		glDeleteVertexArrays(1, &vertexArray);
+		glDeleteProgram(program);
+	}
+
+	void SpriteRenderer::upload(SpriteAtlas &atlas) {
+		atlas.takePendingUploads(uploads);
+		if (uploads.empty())
+			return;
+
+		GLint rowLength;
+		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+		glBindTexture(GL_TEXTURE_2D, atlasTexture);
+		for (const auto &[region, image]: uploads) {
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, image.getPitch());
+			glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height, surfaceGLFormat.format,
+							surfaceGLFormat.type, image.getPixels().data());
+		}
+		// The display texture uploads rely on the surface row length.
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+		uploads.clear();
+	}
+
+	void SpriteRenderer::draw(const std::span<const SpriteInstance> sprites, const int surfaceWidth,
+							  const int surfaceHeight) {
+		if (sprites.empty())
+			return;
+
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		const auto bytes = static_cast<GLsizeiptr>(sprites.size_bytes());
+		if (sprites.size() > instanceCapacity) {
+			instanceCapacity = std::max(sprites.size(), instanceCapacity * 2);
+		}
+		// Respecifying the storage every frame orphans the previous one, so the driver never waits for the
+		// GPU to finish reading last frame's instances.
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity * sizeof(SpriteInstance)), nullptr,
+					 GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, sprites.data());
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		glUseProgram(program);
+		glUniform2f(surfaceSizeLocation, static_cast<float>(surfaceWidth), static_cast<float>(surfaceHeight));
+		glBindTexture(GL_TEXTURE_2D, atlasTexture);
+		glBindVertexArray(vertexArray);
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(sprites.size()));
+		glBindVertexArray(0);
+		glDisable(GL_BLEND);
+	}
+} // namespace pxe
@@ -0,0 +1,81 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "openGLContext.h"
+#include "spriteAtlas.h"
+
+namespace pxe {
+	/**
+	 * @brief One sprite draw as stored in the instance buffer.
+	 */
+	struct SpriteInstance {
+		float x, y, width, height; ///< Destination rectangle before rotation, in surface pixels.
+		float u0, v0, u1, v1; ///< Source rectangle in normalized atlas coordinates.
+		float rotation; ///< Radians about the rectangle's center.
+		uint32_t tint; ///< Packed in the native `PixelFormat`.
+	};
+
+	/**
+	 * @brief GPU pipeline that composites batched sprites over the display quad.
+	 *
+	 * Owns the atlas texture, its own shader program and a dynamic instance buffer. All sprites of a
+	 * frame are drawn with a single instanced draw call of a four-vertex strip; the corners are derived
+	 * from `gl_VertexID`, so the only per-frame upload is the instance data. Blending uses premultiplied
+	 * alpha, matching `BlendMode::Alpha`. Must be created, used and destroyed on the thread owning the
+	 * GL context.
+	 */
+	class SpriteRenderer {
+	public:
+		/**
+		 * @brief Creates the pipeline and an empty, transparent atlas texture.
+		 * @throws std::runtime_error if the shaders fail to build.
+		 */
+		SpriteRenderer();
+
+		~SpriteRenderer();
+
+		SpriteRenderer(const SpriteRenderer &) = delete;
+		SpriteRenderer &operator=(const SpriteRenderer &) = delete;
+
+		/**
+		 * @brief Copies the images added to the atlas since the previous call into the atlas texture.
+		 */
+		void upload(SpriteAtlas &atlas);
+
+		/**
+		 * @brief Draws sprites over whatever the current framebuffer holds, in submission order.
+		 * @param sprites The sprites of the frame.
+		 * @param surfaceWidth Width of the surface the coordinates refer to.
+		 * @param surfaceHeight Height of the surface the coordinates refer to.
+		 */
+		void draw(std::span<const SpriteInstance> sprites, int surfaceWidth, int surfaceHeight);
+
+	private:
+		GLuint program{};
+		GLuint vertexArray{};
+		GLuint instanceBuffer{};
+		GLuint atlasTexture{};
+		GLint surfaceSizeLocation = -1;
+		size_t instanceCapacity = 0; ///< Instances the buffer can hold before it has to grow.
+		std::vector<SpriteAtlas::PendingUpload> uploads; ///< Kept to reuse its allocation.
+	};
+} // namespace pxe
@@ -0,0 +1,110 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pxe {
+	/**
+	 * @brief A bounded, lock-free single-producer/single-consumer queue.
+	 *
+	 * The capacity is rounded up to a power of two. Head and tail live on separate cache lines and each
+	 * side caches the other's index, so an uncontended push or pop touches no shared cache line at all.
+	 * Exactly one thread may push and exactly one (other) thread may pop.
+	 * @tparam T Element type; moved in and out of the ring.
+	 */
+	template<typename T>
+	class SpscQueue {
+	public:
+		/**
+		 * @brief Creates a queue holding at least `capacity` elements.
+		 */
+		explicit SpscQueue(size_t capacity) {
+			if (capacity == 0) {
+				throw std::invalid_argument("Queue capacity must be positive");
+			}
+			size_t size = 1;
+			while (size < capacity) {
+				size <<= 1;
+			}
+			elements.resize(size);
+			mask = size - 1;
+		}
+
+		SpscQueue(const SpscQueue &) = delete;
+		SpscQueue &operator=(const SpscQueue &) = delete;
+
+		/**
+		 * @brief Appends an element unless the queue is full. Producer side only.
+		 * @return True if the element was queued.
+		 */
+		bool tryPush(T value) {
+			const size_t tail = this->tail.load(std::memory_order_relaxed);
+			if (tail - cachedHead > mask) {
+				cachedHead = head.load(std::memory_order_acquire);
+				if (tail - cachedHead > mask)
+					return false;
+			}
+			elements[tail & mask] = std::move(value);
+			this->tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Removes the oldest element, if any. Consumer side only.
+		 * @return True if `value` received an element.
+		 */
+		bool tryPop(T &value) {
+			const size_t head = this->head.load(std::memory_order_relaxed);
+			if (head == cachedTail) {
+				cachedTail = tail.load(std::memory_order_acquire);
+				if (head == cachedTail)
+					return false;
+			}
+			value = std::move(elements[head & mask]);
+			this->head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Checks whether the queue looks empty. Exact only when called by the consumer.
+		 */
+		[[nodiscard]] bool isEmpty() const {
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Gets the number of elements the queue can hold.
+		 */
+		[[nodiscard]] size_t getCapacity() const { return mask + 1; }
+
+	private:
+		static constexpr size_t cacheLine = 64;
+
+		std::vector<T> elements;
+		size_t mask = 0;
+		alignas(cacheLine) std::atomic<size_t> head{0}; ///< Next element to pop, written by the consumer.
+		size_t cachedTail = 0; ///< Consumer's last seen tail.
+		alignas(cacheLine) std::atomic<size_t> tail{0}; ///< Next free element, written by the producer.
+		size_t cachedHead = 0; ///< Producer's last seen head.
+	};
+} // namespace pxe
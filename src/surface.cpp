@@ -18,66 +18,321 @@
 
 #include "surface.h"
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include "blitter.h"
+#include "pixelKernels.h"
+#include "rasterizer.h"
 
 namespace pxe {
-	Surface::Surface(int width, int height) :
-		width(width), height(height), pixelBuffer(static_cast<size_t>(width * height), 0xFF000000) {
-		// 0xFF000000 represents opaque black in 0xAARRGGBB format.
+	Surface::Surface(int width, int height, SurfaceAllocator &allocator, const Color clearColor) :
+		width(width), height(height), pitch(alignedPitch(width, sizeof(uint32_t))), clearValue(clearColor.pixel()),
+		tileColumns((width + dirtyTileSize - 1) / dirtyTileSize),
+		tileRows((height + dirtyTileSize - 1) / dirtyTileSize),
+		pixelBuffer(allocator, static_cast<size_t>(pitch) * height * sizeof(uint32_t)),
+		dirtyTiles(static_cast<size_t>(tileColumns * tileRows), 1),
+		contentTiles(static_cast<size_t>(tileColumns * tileRows), 0) {
+		std::fill_n(pixels(), static_cast<size_t>(pitch) * height, clearValue);
+		// Everything starts dirty so the first upload covers the whole surface.
 	}
 
-	void Surface::clear() { std::ranges::fill(pixelBuffer, 0xFF000000); }
+	void Surface::clear() {
+		// Buffers that do not fit in the last-level cache are cleared with non-temporal stores.
+		const FillKernels &kernels = fillKernels();
+		const bool stream = pixelBuffer.size() > lastLevelCacheSize();
+		const auto fill = stream ? kernels.streamSpan : kernels.fillSpan;
+
+		// Walk the content bitmap one tile row at a time and clear each run of consecutive tiles
+		// with a single fill per pixel row, or a single fill overall when the run spans whole rows.
+		for (int tileY = 0; tileY < tileRows; tileY++) {
+			uint8_t *content = &contentTiles[static_cast<size_t>(tileY * tileColumns)];
+			uint8_t *dirty = &dirtyTiles[static_cast<size_t>(tileY * tileColumns)];
+			const int y0 = tileY * dirtyTileSize;
+			const int y1 = std::min(y0 + dirtyTileSize, height);
+
+			int tileX = 0;
+			while (tileX < tileColumns) {
+				if (!content[tileX]) {
+					tileX++;
+					continue;
+				}
+				const int runStart = tileX;
+				while (tileX < tileColumns && content[tileX]) {
+					content[tileX] = 0;
+					dirty[tileX] = 1;
+					tileX++;
+				}
+
+				const int x0 = runStart * dirtyTileSize;
+				const int x1 = std::min(tileX * dirtyTileSize, width);
+				uint32_t *first = pixelAt(x0, y0);
+				if (x1 - x0 == width) {
+					// Rows are contiguous apart from their padding, which may as well be cleared too.
+					fill(first, static_cast<size_t>(pitch) * (y1 - y0), clearValue);
+					continue;
+				}
+				for (int y = y0; y < y1; y++) {
+					fill(first + static_cast<size_t>(y - y0) * pitch, x1 - x0, clearValue);
+				}
+			}
+		}
+	}
 
 	void Surface::setPixel(int x, int y, Color color) {
 		if (x < 0 || x >= width || y < 0 || y >= height)
 			return;
-		const int index = y * width + x;
-		// Build a 32-bit pixel from the Color's channels.
-		pixelBuffer[index] = (static_cast<uint32_t>(color.a()) << 24) | (static_cast<uint32_t>(color.r()) << 16) |
-							 (static_cast<uint32_t>(color.g()) << 8) | static_cast<uint32_t>(color.b());
+		markPixel(x, y);
+		// The Color is already packed in the surface's pixel format.
+		*pixelAt(x, y) = color.pixel();
 	}
 
 	void Surface::setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
 		if (x < 0 || x >= width || y < 0 || y >= height)
 			return;
-		const int index = y * width + x;
+		markPixel(x, y);
 		// Default alpha is set to 255 (opaque).
-		pixelBuffer[index] = (0xFFu << 24) | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) |
-							 static_cast<uint32_t>(b);
+		*pixelAt(x, y) = PixelFormat::pack(r, g, b);
+	}
+
+	void Surface::drawSpan(const int x, const int y, std::span<const Color> colors) {
+		static_assert(sizeof(Color) == sizeof(uint32_t) && std::is_trivially_copyable_v<Color>,
+					  "Color must match the pixel layout to be block copied");
+		if (y < 0 || y >= height)
+			return;
+
+		const int x0 = std::max(x, 0);
+		const int x1 = static_cast<int>(std::min<int64_t>(x + static_cast<int64_t>(colors.size()), width));
+		if (x0 >= x1)
+			return;
+
+		markDirty({x0, y, x1 - x0, 1});
+		std::memcpy(pixelAt(x0, y), colors.data() + (x0 - x),
+					static_cast<size_t>(x1 - x0) * sizeof(uint32_t));
+	}
+
+	void Surface::fillRect(const Rect &region, const Color color) {
+		const Rect clipped = clip(region);
+		if (clipped.isEmpty())
+			return;
+
+		markDirty(clipped);
+		pxe::fillRect(fillKernels(), pixelAt(clipped.x, clipped.y), clipped.width, clipped.height, pitch,
+					  color.pixel());
+	}
+
+	void Surface::drawLine(const Line &line, const Color color) {
+		Line clipped = line;
+		if (!clipLine(getBounds(), clipped))
+			return;
+
+		markLineDirty(clipped);
+		rasterizeLine(getView(), clipped, color.pixel());
+	}
+
+	void Surface::drawLines(const std::span<const Line> lines, const Color color) {
+		const Rect bounds = getBounds();
+		const SurfaceView view = getView();
+		const uint32_t pixel = color.pixel();
+		for (const Line &line: lines) {
+			Line clipped = line;
+			if (!clipLine(bounds, clipped))
+				continue;
+			markLineDirty(clipped);
+			rasterizeLine(view, clipped, pixel);
+		}
+	}
+
+	void Surface::drawRect(const Rect &region, const Color color) {
+		if (region.isEmpty())
+			return;
+		if (region.width <= 2 || region.height <= 2) {
+			fillRect(region, color);
+			return;
+		}
+		fillRect({region.x, region.y, region.width, 1}, color);
+		fillRect({region.x, region.bottom() - 1, region.width, 1}, color);
+		fillRect({region.x, region.y + 1, 1, region.height - 2}, color);
+		fillRect({region.right() - 1, region.y + 1, 1, region.height - 2}, color);
+	}
+
+	void Surface::drawCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		markDirty(rasterizeCircle(getView(), centerX, centerY, radius, color.pixel(), false));
+	}
+
+	void Surface::fillCircle(const int centerX, const int centerY, const int radius, const Color color) {
+		markDirty(rasterizeCircle(getView(), centerX, centerY, radius, color.pixel(), true));
+	}
+
+	void Surface::drawTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+							   const Color color) {
+		const Line edges[] = {{x0, y0, x1, y1}, {x1, y1, x2, y2}, {x2, y2, x0, y0}};
+		drawLines(edges, color);
+	}
+
+	void Surface::fillTriangle(const int x0, const int y0, const int x1, const int y1, const int x2, const int y2,
+							   const Color color) {
+		markDirty(rasterizeTriangle(getView(), x0, y0, x1, y1, x2, y2, color.pixel()));
+	}
+
+	void Surface::blit(const Image &image, const Rect &sourceRegion, const int x, const int y, const BlendMode mode) {
+		markDirty(blitImage(getView(), image, sourceRegion, x, y, mode));
+	}
+
+	SurfaceView Surface::getView() { return {pixels(), width, height, pitch}; }
+
+	SurfaceView Surface::lockRows(const Rect &region) {
+		const Rect clipped = clip(region);
+		if (clipped.isEmpty())
+			return {};
+
+		markDirty(clipped);
+		return {pixelAt(clipped.x, clipped.y), clipped.width, clipped.height, pitch};
 	}
 
 	Color Surface::getPixel(int x, int y) const {
 		if (x < 0 || x >= width || y < 0 || y >= height) {
 			return Color::Black;
 		}
-		const int index = y * width + x;
-		const uint32_t pixel = pixelBuffer[index];
-		// Extract channels from the 32-bit pixel.
-		const uint8_t a = (pixel >> 24) & 0xFF;
-		const uint8_t r = (pixel >> 16) & 0xFF;
-		const uint8_t g = (pixel >> 8) & 0xFF;
-		const uint8_t b = pixel & 0xFF;
-		return Color(r, g, b, a);
+		return Color::fromPixel(*pixelAt(x, y));
+	}
+
+	std::span<const uint32_t> Surface::getBuffer() const {
+		return {pixels(), static_cast<size_t>(pitch) * height};
 	}
 
-	const std::vector<uint32_t> &Surface::getBuffer() const { return pixelBuffer; }
+	int Surface::getPitch() const { return pitch; }
+
+	Rect Surface::getBounds() const { return {0, 0, width, height}; }
+
+	Rect Surface::clip(const Rect &region) const {
+		const int x0 = std::max(region.x, 0);
+		const int y0 = std::max(region.y, 0);
+		const int x1 = std::min(region.right(), width);
+		const int y1 = std::min(region.bottom(), height);
+		if (x0 >= x1 || y0 >= y1)
+			return {};
+		return {x0, y0, x1 - x0, y1 - y0};
+	}
+
+	void Surface::markDirty(const Rect &region) {
+		const Rect clipped = clip(region);
+		if (clipped.isEmpty())
+			return;
+		const int x0 = clipped.x, y0 = clipped.y, x1 = clipped.right(), y1 = clipped.bottom();
+
+		const int tileX1 = (x1 - 1) >> dirtyTileShift;
+		const int tileY1 = (y1 - 1) >> dirtyTileShift;
+		for (int tileY = y0 >> dirtyTileShift; tileY <= tileY1; tileY++) {
+			for (int tileX = x0 >> dirtyTileShift; tileX <= tileX1; tileX++) {
+				const int tile = tileY * tileColumns + tileX;
+				dirtyTiles[tile] = 1;
+				contentTiles[tile] = 1;
+			}
+		}
+	}
+
+	void Surface::markLineDirty(const Line &line) {
+		// A diagonal line's bounding box can cover many tiles it never touches, so the line is split
+		// into tile-sized steps along its major axis and each step's box is marked on its own.
+		const int dx = line.x1 - line.x0, dy = line.y1 - line.y0;
+		const int length = std::max(std::abs(dx), std::abs(dy));
+		for (int start = 0; start <= length; start += dirtyTileSize) {
+			const int end = std::min(start + dirtyTileSize, length);
+			// Endpoints of the step, rounded outwards by one pixel to cover Bresenham's rounding.
+			const int64_t ax = line.x0 + static_cast<int64_t>(dx) * start / std::max(length, 1);
+			const int64_t ay = line.y0 + static_cast<int64_t>(dy) * start / std::max(length, 1);
+			const int64_t bx = line.x0 + static_cast<int64_t>(dx) * end / std::max(length, 1);
+			const int64_t by = line.y0 + static_cast<int64_t>(dy) * end / std::max(length, 1);
+			const int x0 = static_cast<int>(std::min(ax, bx)) - 1, y0 = static_cast<int>(std::min(ay, by)) - 1;
+			const int x1 = static_cast<int>(std::max(ax, bx)) + 2, y1 = static_cast<int>(std::max(ay, by)) + 2;
+			markDirty({x0, y0, x1 - x0, y1 - y0});
+		}
+	}
+
+	void Surface::takeDirtyRects(std::vector<Rect> &regions) {
+		regions.clear();
+		// Index into `regions` of the rectangles touching the previous tile row, which are the only
+		// candidates to be extended downwards.
+		openRects.clear();
+
+		for (int tileY = 0; tileY < tileRows; tileY++) {
+			uint8_t *dirty = &dirtyTiles[static_cast<size_t>(tileY * tileColumns)];
+			const int y0 = tileY * dirtyTileSize;
+			const int rowHeight = std::min(dirtyTileSize, height - y0);
+			nextOpenRects.clear();
+
+			size_t candidate = 0;
+			int tileX = 0;
+			while (tileX < tileColumns) {
+				if (!dirty[tileX]) {
+					tileX++;
+					continue;
+				}
+				const int runStart = tileX;
+				while (tileX < tileColumns && dirty[tileX]) {
+					dirty[tileX] = 0;
+					tileX++;
+				}
+
+				const int x0 = runStart * dirtyTileSize;
+				const int runWidth = std::min(tileX * dirtyTileSize, width) - x0;
+
+				// Open rectangles are sorted by x, so skip those that end before this run starts.
+				while (candidate < openRects.size() && regions[openRects[candidate]].x < x0) {
+					candidate++;
+				}
+				if (candidate < openRects.size() && regions[openRects[candidate]].x == x0 &&
+					regions[openRects[candidate]].width == runWidth) {
+					regions[openRects[candidate]].height += rowHeight;
+					nextOpenRects.push_back(openRects[candidate]);
+				} else {
+					regions.push_back({x0, y0, runWidth, rowHeight});
+					nextOpenRects.push_back(regions.size() - 1);
+				}
+			}
+			std::swap(openRects, nextOpenRects);
+		}
+	}
 
 	int Surface::getWidth() const { return width; }
 
 	int Surface::getHeight() const { return height; }
 
+	Color Surface::getClearColor() const { return Color::fromPixel(clearValue); }
+
 	Surface::Surface(Surface &&other) noexcept :
-		width(other.width), height(other.height), pixelBuffer(std::move(other.pixelBuffer)) {
+		width(other.width), height(other.height), pitch(other.pitch), clearValue(other.clearValue),
+		tileColumns(other.tileColumns),
+		tileRows(other.tileRows),
+		pixelBuffer(std::move(other.pixelBuffer)), dirtyTiles(std::move(other.dirtyTiles)),
+		contentTiles(std::move(other.contentTiles)), openRects(std::move(other.openRects)),
+		nextOpenRects(std::move(other.nextOpenRects)) {
 		other.width = 0;
 		other.height = 0;
+		other.pitch = 0;
+		other.tileColumns = 0;
+		other.tileRows = 0;
 	}
 
 	Surface &Surface::operator=(Surface &&other) noexcept {
 		if (this != &other) {
 			width = other.width;
 			height = other.height;
+			pitch = other.pitch;
+			clearValue = other.clearValue;
+			tileColumns = other.tileColumns;
+			tileRows = other.tileRows;
 			pixelBuffer = std::move(other.pixelBuffer);
+			dirtyTiles = std::move(other.dirtyTiles);
+			contentTiles = std::move(other.contentTiles);
+			openRects = std::move(other.openRects);
+			nextOpenRects = std::move(other.nextOpenRects);
 			other.width = 0;
 			other.height = 0;
+			other.pitch = 0;
+			other.tileColumns = 0;
+			other.tileRows = 0;
 		}
 		return *this;
 	}
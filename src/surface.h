@@ -18,29 +18,51 @@
 
 #pragma once
 #include <cstdint>
+#include <span>
 #include <vector>
 #include "color.h"
+#include "geometry.h"
+#include "image.h"
+#include "surfaceAllocator.h"
+#include "surfaceView.h"
 
 namespace pxe {
 	/**
 	 * @brief The Surface class represents an off-screen pixel buffer for rendering.
 	 *
 	 * This class encapsulates a 2D pixel array stored as a linear buffer.
-	 * Each pixel is stored as a 32-bit value in 0xAARRGGBB format.
+	 * Each pixel is stored as a 32-bit value in the native `PixelFormat` layout (0xAARRGGBB by default).
+	 * Rows start on `pixelAlignment` byte boundaries, so the pitch is the width rounded up to 16 pixels.
+	 *
+	 * The surface is split into square tiles of `dirtyTileSize` pixels and keeps two conservative
+	 * bitmaps over them: tiles modified since the last upload (dirty) and tiles holding anything other
+	 * than the clear color (content). `clear()` only touches content tiles, and `takeDirtyRects()` lets
+	 * the renderer upload only what changed.
 	 */
 	class Surface {
 	public:
 		/**
 		 * @brief Constructs a Surface with the given width and height.
 		 *
-		 * Initializes a pixel buffer with all pixels set to opaque black (0,0,0,255).
+		 * Initializes a pixel buffer with all pixels set to the clear color.
 		 * @param width Width of the surface in pixels.
 		 * @param height Height of the surface in pixels.
+		 * @param allocator Where the pixel buffer comes from; must outlive the surface.
+		 * @param clearColor Color written by `clear()`, e.g. `Color::Transparent` for a layer.
 		 */
-		Surface(int width, int height);
+		Surface(int width, int height, SurfaceAllocator &allocator = SurfaceAllocator::getDefault(),
+				Color clearColor = Color::Black);
+
+		/// Default pixel value written by `clear()` (opaque black).
+		static constexpr uint32_t clearPixel = Color::Black.pixel();
+
+		/// Edge length in pixels of the tiles used for dirty tracking.
+		static constexpr int dirtyTileSize = 32;
 
 		/**
-		 * @brief Clears the surface by setting all pixels to opaque black (0,0,0,255).
+		 * @brief Clears the surface by setting all pixels to the clear color, opaque black by default.
+		 *
+		 * Only tiles that were drawn to since the previous clear are rewritten; they are marked dirty.
 		 */
 		void clear();
 
@@ -66,6 +88,106 @@ namespace pxe {
 		 */
 		void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b);
 
+		/**
+		 * @brief Copies a horizontal run of pixels starting at the given coordinate.
+		 *
+		 * The span is clipped once against the surface and copied with a single block copy.
+		 * @param x X-coordinate of the first pixel.
+		 * @param y Y-coordinate of the row.
+		 * @param colors The colors to store, left to right.
+		 */
+		void drawSpan(int x, int y, std::span<const Color> colors);
+
+		/**
+		 * @brief Fills a rectangle with a solid color.
+		 *
+		 * The rectangle is clipped once against the surface.
+		 * @param region The rectangle to fill.
+		 * @param color The fill color.
+		 */
+		void fillRect(const Rect &region, Color color);
+
+		/**
+		 * @brief Draws a line; both endpoints are included.
+		 *
+		 * The line is clipped once against the surface, so the inner loop needs no bounds checks.
+		 * Horizontal and vertical lines are filled as spans.
+		 * @param line The segment to draw.
+		 * @param color The line color.
+		 */
+		void drawLine(const Line &line, Color color);
+
+		/**
+		 * @brief Draws a batch of lines sharing one color.
+		 * @param lines The segments to draw.
+		 * @param color The line color.
+		 */
+		void drawLines(std::span<const Line> lines, Color color);
+
+		/**
+		 * @brief Draws the one pixel wide outline of a rectangle, inside `region`.
+		 * @param region The rectangle to outline.
+		 * @param color The outline color.
+		 */
+		void drawRect(const Rect &region, Color color);
+
+		/**
+		 * @brief Draws the one pixel wide outline of a circle.
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The outline color.
+		 */
+		void drawCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Fills a circle, covering the same pixels as its outline and everything inside it.
+		 * @param centerX X-coordinate of the center.
+		 * @param centerY Y-coordinate of the center.
+		 * @param radius Radius in pixels.
+		 * @param color The fill color.
+		 */
+		void fillCircle(int centerX, int centerY, int radius, Color color);
+
+		/**
+		 * @brief Draws the outline of a triangle as three lines.
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The outline color.
+		 */
+		void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Fills a triangle.
+		 *
+		 * Vertices sit on pixel corners and a top-left fill rule applies, so triangles sharing an edge
+		 * neither overlap nor leave gaps.
+		 * @param x0, y0, x1, y1, x2, y2 The vertices.
+		 * @param color The fill color.
+		 */
+		void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+		/**
+		 * @brief Draws a region of an image onto the surface.
+		 *
+		 * Both rectangles are clipped once, and only the pixels actually written are marked dirty.
+		 * @param image The image to draw.
+		 * @param sourceRegion The region of `image` to draw.
+		 * @param x X-coordinate of the region's top-left corner on the surface.
+		 * @param y Y-coordinate of the region's top-left corner on the surface.
+		 * @param mode How image pixels are combined with the surface.
+		 */
+		void blit(const Image &image, const Rect &sourceRegion, int x, int y, BlendMode mode);
+
+		/**
+		 * @brief Gives direct write access to a region of the pixel buffer.
+		 *
+		 * The region is clipped once and marked dirty up front; the returned view can then be written
+		 * with plain stores. Coordinates inside the view are relative to the clipped region.
+		 * @param region The region to lock.
+		 * @return A view over the clipped region, empty if it lies outside the surface.
+		 */
+		[[nodiscard]] SurfaceView lockRows(const Rect &region);
+
 		/**
 		 * @brief Gets the color of a pixel at a given coordinate.
 		 *
@@ -79,10 +201,35 @@ namespace pxe {
 		/**
 		 * @brief Retrieves the underlying pixel buffer.
 		 *
-		 * The buffer stores one 32-bit value per pixel.
-		 * @return A constant reference to the pixel buffer.
+		 * The buffer stores one 32-bit value per pixel, `getHeight()` rows of `getPitch()` pixels.
+		 * @return The pixel buffer, padding included.
+		 */
+		[[nodiscard]] std::span<const uint32_t> getBuffer() const;
+
+		/**
+		 * @brief Gets a view over the whole surface without marking anything dirty.
+		 *
+		 * Meant for reading back a finished frame; writes through the view are not uploaded.
+		 * @return A row-pitched view over the surface.
+		 */
+		[[nodiscard]] SurfaceView getView();
+
+		/**
+		 * @brief Marks a region as modified, e.g. after writing to the buffer outside of `setPixel`.
+		 *
+		 * The region is clipped to the surface.
+		 * @param region The modified region.
+		 */
+		void markDirty(const Rect &region);
+
+		/**
+		 * @brief Collects the regions modified since the last call and resets the dirty state.
+		 *
+		 * Dirty tiles are merged into horizontal runs, and runs with the same extent on consecutive
+		 * tile rows are merged into a single rectangle. Rectangles are clipped to the surface.
+		 * @param regions Receives the dirty rectangles; previous contents are discarded.
 		 */
-		[[nodiscard]] const std::vector<uint32_t> &getBuffer() const;
+		void takeDirtyRects(std::vector<Rect> &regions);
 
 		/**
 		 * @brief Gets the width of the surface.
@@ -96,13 +243,71 @@ namespace pxe {
 		 */
 		[[nodiscard]] int getHeight() const;
 
+		/**
+		 * @brief Gets the distance in pixels between the starts of two consecutive rows.
+		 * @return The row pitch in pixels.
+		 */
+		[[nodiscard]] int getPitch() const;
+
+		/**
+		 * @brief Gets the bounds of the surface.
+		 * @return The rectangle (0, 0, width, height).
+		 */
+		[[nodiscard]] Rect getBounds() const;
+
+		/**
+		 * @brief Gets the color written by `clear()`.
+		 */
+		[[nodiscard]] Color getClearColor() const;
+
 		Surface(const Surface &) = delete;
 		Surface &operator=(const Surface &) = delete;
 		Surface(Surface &&other) noexcept;
 		Surface &operator=(Surface &&other) noexcept;
 
 	private:
+		static constexpr int dirtyTileShift = 5;
+		static_assert(1 << dirtyTileShift == dirtyTileSize);
+
 		int width, height;
-		std::vector<uint32_t> pixelBuffer;
+		int pitch; ///< Row pitch in pixels.
+		uint32_t clearValue; ///< Pixel value written by `clear()`.
+		int tileColumns, tileRows;
+		PixelStorage pixelBuffer;
+		std::vector<uint8_t> dirtyTiles; ///< Tiles modified since the last `takeDirtyRects()`.
+		std::vector<uint8_t> contentTiles; ///< Tiles drawn to since the last `clear()`.
+		std::vector<size_t> openRects; ///< `takeDirtyRects()` scratch, kept so every frame reuses its capacity.
+		std::vector<size_t> nextOpenRects; ///< `takeDirtyRects()` scratch, like `openRects`.
+
+		/**
+		 * @brief Gets the first pixel of the buffer.
+		 */
+		[[nodiscard]] uint32_t *pixels() const { return pixelBuffer.as<uint32_t>(); }
+
+		/**
+		 * @brief Gets a pixel of the buffer.
+		 */
+		[[nodiscard]] uint32_t *pixelAt(const int x, const int y) const {
+			return pixels() + static_cast<ptrdiff_t>(y) * pitch + x;
+		}
+
+		/**
+		 * @brief Clips a rectangle against the surface bounds.
+		 */
+		[[nodiscard]] Rect clip(const Rect &region) const;
+
+		/**
+		 * @brief Marks the tiles an in-bounds line passes through, one box per tile step of its major axis.
+		 */
+		void markLineDirty(const Line &line);
+
+		/**
+		 * @brief Flags the tile containing an in-bounds pixel as dirty and holding content.
+		 */
+		void markPixel(int x, int y) {
+			const int tile = (y >> dirtyTileShift) * tileColumns + (x >> dirtyTileShift);
+			dirtyTiles[tile] = 1;
+			contentTiles[tile] = 1;
+		}
 	};
 } // namespace pxe
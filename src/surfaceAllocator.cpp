@@ -0,0 +1,179 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "surfaceAllocator.h"
+#include <algorithm>
+#include <bit>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace pxe {
+	namespace {
+		[[nodiscard]] constexpr size_t roundUp(const size_t value, const size_t multiple) {
+			return (value + multiple - 1) / multiple * multiple;
+		}
+
+#ifdef __linux__
+		/// Size of a transparent huge page on x86-64 and on most ARM64 kernels.
+		constexpr size_t hugePageSize = size_t{2} << 20;
+#endif
+	} // namespace
+
+	SurfaceAllocator &SurfaceAllocator::getDefault() {
+		static HeapSurfaceAllocator allocator;
+		return allocator;
+	}
+
+	HeapSurfaceAllocator::HeapSurfaceAllocator(const size_t hugePageThreshold) :
+		hugePageThreshold(hugePageThreshold) {}
+
+	void *HeapSurfaceAllocator::allocate(const size_t bytes) {
+#ifdef __linux__
+		if (bytes > 0 && bytes >= hugePageThreshold) {
+			// Map one huge page more than needed, then trim the ends so the region starts on a huge page
+			// boundary: the kernel only backs whole, aligned 2 MB ranges with huge pages.
+			const size_t size = roundUp(bytes, hugePageSize);
+			void *region = mmap(nullptr, size + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+								-1, 0);
+			if (region == MAP_FAILED) {
+				throw std::bad_alloc();
+			}
+			const auto start = reinterpret_cast<uintptr_t>(region);
+			const uintptr_t aligned = roundUp(start, hugePageSize);
+			if (aligned > start) {
+				munmap(region, aligned - start);
+			}
+			if (const size_t tail = start + hugePageSize - aligned; tail > 0) {
+				munmap(reinterpret_cast<void *>(aligned + size), tail);
+			}
+			// Only advice: without transparent huge page support the mapping simply uses small pages.
+			madvise(reinterpret_cast<void *>(aligned), size, MADV_HUGEPAGE);
+			return reinterpret_cast<void *>(aligned);
+		}
+#endif
+		return ::operator new(bytes, std::align_val_t{pixelAlignment});
+	}
+
+	void HeapSurfaceAllocator::deallocate(void *memory, const size_t bytes) {
+#ifdef __linux__
+		if (bytes > 0 && bytes >= hugePageThreshold) {
+			munmap(memory, roundUp(bytes, hugePageSize));
+			return;
+		}
+#endif
+		::operator delete(memory, std::align_val_t{pixelAlignment});
+	}
+
+	FrameArena::FrameArena(SurfaceAllocator &upstream, const size_t blockSize) :
+		upstream(upstream), blockSize(roundUp(std::max(blockSize, pixelAlignment), pixelAlignment)) {}
+
+	FrameArena::~FrameArena() {
+		for (const Block &block: blocks) {
+			upstream.deallocate(block.memory, block.size);
+		}
+	}
+
+	void *FrameArena::allocate(size_t bytes) {
+		bytes = roundUp(std::max<size_t>(bytes, 1), pixelAlignment);
+		while (current < blocks.size()) {
+			if (blocks[current].size - offset >= bytes) {
+				void *memory = blocks[current].memory + offset;
+				offset += bytes;
+				return memory;
+			}
+			// The rest of this block stays unused until the next reset.
+			usedBytes += blocks[current].size;
+			current++;
+			offset = 0;
+		}
+
+		// No block left is large enough: add one, which becomes the current block.
+		const size_t size = std::max(bytes, blockSize);
+		blocks.reserve(blocks.size() + 1);
+		blocks.push_back({static_cast<std::byte *>(upstream.allocate(size)), size});
+		current = blocks.size() - 1;
+		offset = bytes;
+		return blocks.back().memory;
+	}
+
+	void FrameArena::deallocate(void *, size_t) {}
+
+	void FrameArena::reset() {
+		current = 0;
+		offset = 0;
+		usedBytes = 0;
+	}
+
+	size_t FrameArena::getUsedBytes() const { return usedBytes + offset; }
+
+	size_t FrameArena::getCapacityBytes() const {
+		size_t capacity = 0;
+		for (const Block &block: blocks) {
+			capacity += block.size;
+		}
+		return capacity;
+	}
+
+	SurfacePool::SurfacePool(SurfaceAllocator &upstream) : upstream(upstream) {}
+
+	SurfacePool::~SurfacePool() { trim(); }
+
+	size_t SurfacePool::sizeClass(const size_t bytes) {
+		constexpr size_t smallestClass = 4096;
+		if (bytes <= smallestClass)
+			return smallestClass;
+		const size_t step = std::bit_floor(bytes) / 8;
+		return roundUp(bytes, step);
+	}
+
+	void *SurfacePool::allocate(const size_t bytes) {
+		const size_t size = sizeClass(bytes);
+		if (const auto buffers = freeBuffers.find(size); buffers != freeBuffers.end() && !buffers->second.empty()) {
+			void *memory = buffers->second.back();
+			buffers->second.pop_back();
+			freeBytes -= size;
+			return memory;
+		}
+		return upstream.allocate(size);
+	}
+
+	void SurfacePool::deallocate(void *memory, const size_t bytes) {
+		const size_t size = sizeClass(bytes);
+		try {
+			freeBuffers[size].push_back(memory);
+			freeBytes += size;
+		} catch (const std::bad_alloc &) {
+			// Cannot keep it for later, so give it back right away.
+			upstream.deallocate(memory, size);
+		}
+	}
+
+	void SurfacePool::trim() {
+		for (auto &[size, buffers]: freeBuffers) {
+			for (void *memory: buffers) {
+				upstream.deallocate(memory, size);
+			}
+		}
+		freeBuffers.clear();
+		freeBytes = 0;
+	}
+
+	size_t SurfacePool::getFreeBytes() const { return freeBytes; }
+} // namespace pxe
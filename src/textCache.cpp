@@ -0,0 +1,89 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "textCache.h"
+#include <algorithm>
+#include <functional>
+#include "blitter.h"
+
+namespace pxe {
+	namespace {
+		size_t combine(const size_t seed, const uint64_t value) {
+			return seed ^ (std::hash<uint64_t>{}(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+		}
+	} // namespace
+
+	const Image &TextCache::get(const std::string_view text, const BitmapFont &font, const Color color) {
+		const uint32_t pixel = color.pixel();
+		const size_t hash = combine(combine(std::hash<std::string_view>{}(text), font.getId()), pixel);
+		auto [entry, inserted] = layouts.try_emplace(hash);
+		Layout &layout = entry->second;
+		layout.lastUse = generation;
+		if (!inserted && layout.font == font.getId() && layout.pixel == pixel && layout.text == text)
+			return layout.image;
+
+		// A new layout, or (rarely) a hash hit on another one, which is replaced.
+		const Image &atlas = getAtlas(font, pixel);
+		const Rect size = font.measure(text);
+		layout.text = text;
+		layout.font = font.getId();
+		layout.pixel = pixel;
+		layout.image = Image(size.width, size.height, Color::Transparent);
+		layout.image.setColorKey(Color::Transparent);
+		const SurfaceView view = layout.image.getView();
+		int x = 0;
+		int y = 0;
+		for (const char character: text) {
+			if (character == '\n') {
+				x = 0;
+				y += font.getLineHeight();
+				continue;
+			}
+			const Rect glyph = font.getGlyphRegion(character);
+			if (!glyph.isEmpty()) {
+				blitImage(view, atlas, glyph, x, y, BlendMode::Copy);
+			}
+			x += font.getAdvance();
+		}
+		return layout.image;
+	}
+
+	const Image &TextCache::getAtlas(const BitmapFont &font, const uint32_t pixel) {
+		auto [entry, inserted] = atlases.try_emplace(combine(font.getId(), pixel));
+		TintedAtlas &tinted = entry->second;
+		tinted.lastUse = generation;
+		if (!inserted && tinted.font == font.getId() && tinted.pixel == pixel)
+			return tinted.image;
+
+		tinted.font = font.getId();
+		tinted.pixel = pixel;
+		tinted.image = font.getAtlas();
+		const SurfaceView view = tinted.image.getView();
+		for (int y = 0; y < view.getHeight(); y++) {
+			uint32_t *row = view.row(y);
+			std::replace_if(row, row + view.getWidth(), [](const uint32_t ink) { return ink != 0; }, pixel);
+		}
+		return tinted.image;
+	}
+
+	void TextCache::trim() {
+		std::erase_if(layouts, [this](const auto &entry) { return entry.second.lastUse != generation; });
+		std::erase_if(atlases, [this](const auto &entry) { return entry.second.lastUse != generation; });
+		generation++;
+	}
+} // namespace pxe
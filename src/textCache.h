@@ -0,0 +1,79 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "bitmapFont.h"
+#include "color.h"
+#include "image.h"
+
+namespace pxe {
+	/**
+	 * @brief Rendered text layouts, so a string drawn again costs one color-keyed blit.
+	 *
+	 * A layout is rendered once per (text, font, color): one block copy per glyph row, from an atlas
+	 * tinted to the color (itself cached), into an image whose background is the transparent color key.
+	 * Strings that stop being drawn are evicted by `trim`, so text changing every frame, like a frame time,
+	 * costs one layout render per frame and never accumulates. Not thread-safe.
+	 */
+	class TextCache {
+	public:
+		/**
+		 * @brief Gets the layout of a text, rendering it if it is not cached.
+		 * @return An image of `font.measure(text)` pixels, valid until the next call, with glyph pixels of
+		 * `color` on Color::Transparent, which is also its color key.
+		 */
+		const Image &get(std::string_view text, const BitmapFont &font, Color color);
+
+		/**
+		 * @brief Evicts every layout and tinted atlas not used since the previous call; called once a frame.
+		 */
+		void trim();
+
+		/**
+		 * @brief Gets the number of cached layouts.
+		 */
+		[[nodiscard]] size_t size() const { return layouts.size(); }
+
+	private:
+		struct Layout {
+			std::string text; ///< Compared on hash hits.
+			uint64_t font = 0;
+			uint32_t pixel = 0;
+			Image image;
+			uint64_t lastUse = 0; ///< Value of `generation` when last drawn.
+		};
+
+		struct TintedAtlas {
+			uint64_t font = 0;
+			uint32_t pixel = 0;
+			Image image;
+			uint64_t lastUse = 0;
+		};
+
+		std::unordered_map<size_t, Layout> layouts; ///< By hash of text, font and color.
+		std::unordered_map<size_t, TintedAtlas> atlases; ///< By hash of font and color.
+		uint64_t generation = 0; ///< Number of `trim` calls.
+
+		const Image &getAtlas(const BitmapFont &font, uint32_t pixel);
+	};
+} // namespace pxe
@@ -0,0 +1,167 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "threadPool.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace pxe {
+	namespace {
+		constexpr uint64_t pack(const uint64_t begin, const uint64_t end) { return (begin << 32) | end; }
+		constexpr uint64_t rangeBegin(const uint64_t packed) { return packed >> 32; }
+		constexpr uint64_t rangeEnd(const uint64_t packed) { return packed & 0xFFFFFFFFu; }
+	} // namespace
+
+	ThreadPool::ThreadPool(const unsigned threadCount) :
+		participantCount(std::max(threadCount, 1u)) {
+		ranges = std::make_unique<WorkRange[]>(participantCount);
+		workers.reserve(participantCount - 1);
+		for (unsigned participant = 1; participant < participantCount; participant++) {
+			workers.emplace_back([this, participant] { workerLoop(participant); });
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard lock(stateMutex);
+			stopping = true;
+		}
+		wakeCondition.notify_all();
+		for (auto &worker: workers) {
+			worker.join();
+		}
+	}
+
+	void ThreadPool::parallelFor(const size_t count, const std::function<void(size_t)> &body) {
+		if (count == 0)
+			return;
+		if (count > 0xFFFFFFFFu) {
+			throw std::length_error("ThreadPool::parallelFor supports at most 2^32 - 1 iterations");
+		}
+
+		std::lock_guard loopLock(loopMutex);
+		if (participantCount == 1 || count == 1) {
+			for (size_t i = 0; i < count; i++) {
+				body(i);
+			}
+			return;
+		}
+
+		// Hand every participant an equal contiguous share; stealing evens out the rest.
+		for (unsigned participant = 0; participant < participantCount; participant++) {
+			const uint64_t begin = count * participant / participantCount;
+			const uint64_t end = count * (participant + 1) / participantCount;
+			ranges[participant].packed.store(pack(begin, end), std::memory_order_relaxed);
+		}
+		{
+			std::lock_guard lock(stateMutex);
+			currentBody = &body;
+			firstException = nullptr;
+			pendingParticipants = participantCount - 1;
+			generation++;
+		}
+		wakeCondition.notify_all();
+
+		participate(0);
+
+		std::exception_ptr exception;
+		{
+			std::unique_lock lock(stateMutex);
+			doneCondition.wait(lock, [this] { return pendingParticipants == 0; });
+			currentBody = nullptr;
+			exception = std::exchange(firstException, nullptr);
+		}
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+
+	unsigned ThreadPool::getThreadCount() const { return participantCount; }
+
+	void ThreadPool::workerLoop(const unsigned participant) {
+		uint64_t seenGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock lock(stateMutex);
+				wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+				if (stopping)
+					return;
+				seenGeneration = generation;
+			}
+
+			participate(participant);
+
+			bool last;
+			{
+				std::lock_guard lock(stateMutex);
+				last = --pendingParticipants == 0;
+			}
+			if (last) {
+				doneCondition.notify_one();
+			}
+		}
+	}
+
+	void ThreadPool::participate(const unsigned participant) {
+		const auto &body = *currentBody;
+		size_t index;
+		do {
+			while (popFront(ranges[participant], index)) {
+				try {
+					body(index);
+				} catch (...) {
+					std::lock_guard lock(stateMutex);
+					if (!firstException) {
+						firstException = std::current_exception();
+					}
+				}
+			}
+		} while (stealInto(participant));
+	}
+
+	bool ThreadPool::popFront(WorkRange &range, size_t &index) {
+		uint64_t current = range.packed.load(std::memory_order_acquire);
+		while (rangeBegin(current) < rangeEnd(current)) {
+			if (range.packed.compare_exchange_weak(current, pack(rangeBegin(current) + 1, rangeEnd(current)),
+												   std::memory_order_acq_rel)) {
+				index = rangeBegin(current);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ThreadPool::stealInto(const unsigned thief) {
+		for (unsigned offset = 1; offset < participantCount; offset++) {
+			WorkRange &victim = ranges[(thief + offset) % participantCount];
+			uint64_t current = victim.packed.load(std::memory_order_acquire);
+			while (rangeBegin(current) < rangeEnd(current)) {
+				// Take the back half, rounding up so a single remaining index can be stolen too.
+				const uint64_t begin = rangeBegin(current), end = rangeEnd(current);
+				const uint64_t middle = begin + (end - begin) / 2;
+				if (victim.packed.compare_exchange_weak(current, pack(begin, middle), std::memory_order_acq_rel)) {
+					// The thief's own range is empty, so no one else is competing for it.
+					ranges[thief].packed.store(pack(middle, end), std::memory_order_release);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+} // namespace pxe
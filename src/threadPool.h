@@ -0,0 +1,103 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pxe {
+	/**
+	 * @brief A persistent pool of worker threads executing data-parallel loops with work stealing.
+	 *
+	 * A loop over [0, count) is split into one contiguous range per participant (the workers plus the
+	 * calling thread). Each participant takes indices from the front of its own range, and once it runs
+	 * dry steals the back half of another participant's range. Ranges are packed into a single 64-bit
+	 * atomic so that taking and stealing never need a lock.
+	 */
+	class ThreadPool {
+	public:
+		/**
+		 * @brief Starts the worker threads.
+		 * @param threadCount Total number of threads running a loop, including the caller. Defaults to the
+		 * number of hardware threads.
+		 */
+		explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+
+		/**
+		 * @brief Stops and joins the worker threads.
+		 */
+		~ThreadPool();
+
+		/**
+		 * @brief Runs `body(i)` for every i in [0, count) and returns once all of them have completed.
+		 *
+		 * The calling thread participates. Only one loop runs at a time; concurrent calls are serialized.
+		 * If any invocation throws, the first exception is rethrown here after the loop has drained.
+		 * @param count Number of iterations.
+		 * @param body The function to run for each index.
+		 */
+		void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+		/**
+		 * @brief Gets the number of threads that run a loop, including the caller.
+		 */
+		[[nodiscard]] unsigned getThreadCount() const;
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+	private:
+		/// Half-open index range [begin, end) packed as (begin << 32) | end.
+		struct alignas(64) WorkRange {
+			std::atomic<uint64_t> packed{0};
+		};
+
+		std::vector<std::thread> workers;
+		std::unique_ptr<WorkRange[]> ranges; ///< One range per participant; index 0 is the caller.
+		unsigned participantCount;
+
+		std::mutex loopMutex; ///< Serializes calls to `parallelFor`.
+		std::mutex stateMutex;
+		std::condition_variable wakeCondition;
+		std::condition_variable doneCondition;
+		uint64_t generation = 0; ///< Incremented for every loop; workers wait for it to change.
+		unsigned pendingParticipants = 0;
+		bool stopping = false;
+
+		const std::function<void(size_t)> *currentBody = nullptr;
+		std::exception_ptr firstException;
+
+		void workerLoop(unsigned participant);
+
+		/**
+		 * @brief Executes indices from the participant's own range, then steals until no work is left.
+		 */
+		void participate(unsigned participant);
+
+		bool popFront(WorkRange &range, size_t &index);
+		bool stealInto(unsigned thief);
+	};
+} // namespace pxe
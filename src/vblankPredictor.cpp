@@ -0,0 +1,77 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vblankPredictor.h"
+#include <algorithm>
+#include <thread>
+
+namespace pxe {
+	void VblankPredictor::setRefreshRate(const double hertz) {
+		if (hertz == refreshRate)
+			return;
+		refreshRate = hertz;
+		nominalPeriod = hertz > 0.0 ? std::chrono::duration_cast<clock::duration>(
+											  std::chrono::duration<double>(1.0 / hertz))
+									: clock::duration::zero();
+		refreshPeriod = clock::duration::zero();
+		predictedCost = clock::duration::zero();
+		lastSwap = clock::time_point{};
+		recordedIntervals = 0;
+	}
+
+	void VblankPredictor::recordSwap(const clock::time_point returned) {
+		if (lastSwap != clock::time_point{}) {
+			intervals[recordedIntervals % intervalCount] = returned - lastSwap;
+			recordedIntervals++;
+			measurePeriod();
+		}
+		lastSwap = returned;
+	}
+
+	void VblankPredictor::measurePeriod() {
+		if (nominalPeriod == clock::duration::zero() || recordedIntervals < intervalCount)
+			return;
+		std::array<clock::duration, intervalCount> sorted = intervals;
+		std::nth_element(sorted.begin(), sorted.begin() + intervalCount / 2, sorted.end());
+		const clock::duration median = sorted[intervalCount / 2];
+		// Reliable when the swaps follow every vblank of the expected rate: the median within 10% of the
+		// nominal period, and three quarters of the intervals within 10% of the median.
+		const clock::duration tolerance = nominalPeriod / 10;
+		const auto matching = std::count_if(intervals.begin(), intervals.end(), [&](const clock::duration interval) {
+			return interval > median - tolerance && interval < median + tolerance;
+		});
+		const bool reliable = median > nominalPeriod - tolerance && median < nominalPeriod + tolerance &&
+							  matching >= intervalCount * 3 / 4;
+		refreshPeriod = reliable ? median : clock::duration::zero();
+	}
+
+	void VblankPredictor::recordFrameCost(const clock::duration cost) {
+		// Rise at once, decay by 1/16 of the difference per frame.
+		predictedCost = cost >= predictedCost ? cost : predictedCost - (predictedCost - cost) / 16;
+	}
+
+	void VblankPredictor::wait() const {
+		if (refreshPeriod == clock::duration::zero())
+			return;
+
+		const clock::time_point wakeTime = lastSwap + refreshPeriod - predictedCost - safetyMargin;
+		if (clock::now() < wakeTime) {
+			std::this_thread::sleep_until(wakeTime);
+		}
+	}
+} // namespace pxe
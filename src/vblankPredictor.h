@@ -0,0 +1,90 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+
+namespace pxe {
+	/**
+	 * @brief Predicts the next vertical blank and how long before it a frame has to start.
+	 *
+	 * With VSync the swap returns close to a vertical blank, so the next one is expected a refresh period
+	 * after the last swap returned. The period is measured, as the median of the recent intervals between
+	 * swap returns, and only trusted while it matches the monitor's refresh rate: a wrong rate (a window on
+	 * another monitor than expected) or frames too slow to swap every vblank disable the wait instead of
+	 * sleeping past the vblank. The cost of a frame, from polling input to submitting the swap, is
+	 * tracked as a decaying peak: it follows a slow frame immediately and relaxes over a few dozen fast
+	 * ones, so a single spike does not keep the wait short for long. Waking at the next vblank minus that
+	 * cost and a safety margin lets input be read as late as possible without missing the flip.
+	 */
+	class VblankPredictor {
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/// Slack kept before the predicted deadline, covering sleep overshoot and frame-time jitter.
+		static constexpr std::chrono::microseconds safetyMargin{2000};
+
+		/// Number of swap intervals the period is measured over.
+		static constexpr int intervalCount = 16;
+
+		/**
+		 * @brief Sets the refresh rate of the display and, if it changed, forgets the previous measurements.
+		 * @param hertz Nominal refresh rate; zero or negative disables waiting.
+		 */
+		void setRefreshRate(double hertz);
+
+		/**
+		 * @brief Records the time a buffer swap returned.
+		 */
+		void recordSwap(clock::time_point returned);
+
+		/**
+		 * @brief Records the duration of a frame, from polling input until the swap was submitted.
+		 */
+		void recordFrameCost(clock::duration cost);
+
+		/**
+		 * @brief Sleeps until the latest time the next frame can start and still make the next vblank.
+		 *
+		 * Returns immediately while the measured period is not reliable, or when the frame is already late.
+		 */
+		void wait() const;
+
+		/**
+		 * @brief Gets the measured refresh period, or zero while it is not reliable.
+		 */
+		[[nodiscard]] clock::duration getRefreshPeriod() const { return refreshPeriod; }
+
+		/**
+		 * @brief Gets the predicted frame cost.
+		 */
+		[[nodiscard]] clock::duration getPredictedCost() const { return predictedCost; }
+
+	private:
+		double refreshRate = 0.0;
+		clock::duration nominalPeriod{}; ///< Period of `refreshRate`, zero when waiting is disabled.
+		clock::duration refreshPeriod{}; ///< Measured period, zero until it matches `nominalPeriod`.
+		clock::duration predictedCost{};
+		clock::time_point lastSwap{};
+		std::array<clock::duration, intervalCount> intervals{}; ///< Recent swap intervals, a ring.
+		int recordedIntervals = 0;
+
+		void measurePeriod();
+	};
+} // namespace pxe
@@ -0,0 +1,43 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "viewport.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pxe {
+	Rect fitViewport(const int outputWidth, const int outputHeight, const int sourceWidth, const int sourceHeight,
+					 const bool integerScale) {
+		if (outputWidth <= 0 || outputHeight <= 0 || sourceWidth <= 0 || sourceHeight <= 0)
+			return {};
+
+		int width;
+		int height;
+		const int wholeScale = std::min(outputWidth / sourceWidth, outputHeight / sourceHeight);
+		if (integerScale && wholeScale >= 1) {
+			width = sourceWidth * wholeScale;
+			height = sourceHeight * wholeScale;
+		} else {
+			const double scale = std::min(static_cast<double>(outputWidth) / sourceWidth,
+										  static_cast<double>(outputHeight) / sourceHeight);
+			width = std::clamp(static_cast<int>(std::lround(sourceWidth * scale)), 1, outputWidth);
+			height = std::clamp(static_cast<int>(std::lround(sourceHeight * scale)), 1, outputHeight);
+		}
+		return {(outputWidth - width) / 2, (outputHeight - height) / 2, width, height};
+	}
+} // namespace pxe
@@ -0,0 +1,39 @@
+/*
+ * Part of the PX-Engine project - https://github.com/angelotadres/px-engine
+ *
+ * Copyright 2025 Angelo Tadres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "geometry.h"
+
+namespace pxe {
+	/**
+	 * @brief Computes where a surface is displayed inside the output, keeping its aspect ratio.
+	 *
+	 * The result is centered; the rest of the output is letterboxed. With `integerScale` the surface is
+	 * magnified by the largest whole factor that fits, falling back to a fractional fit when even 1x does
+	 * not fit.
+	 * @param outputWidth Width of the output (e.g. the window framebuffer) in pixels.
+	 * @param outputHeight Height of the output in pixels.
+	 * @param sourceWidth Width of the surface.
+	 * @param sourceHeight Height of the surface.
+	 * @param integerScale True to only use whole scale factors.
+	 * @return The displayed rectangle in output pixels, measured from the top-left corner; empty if either
+	 * size is empty.
+	 */
+	[[nodiscard]] Rect fitViewport(int outputWidth, int outputHeight, int sourceWidth, int sourceHeight,
+								   bool integerScale);
+} // namespace pxe
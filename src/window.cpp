@@ -29,7 +29,7 @@ namespace pxe {
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
 
 		window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
 		if (!window) {
@@ -38,6 +38,7 @@ namespace pxe {
 		}
 		glfwMakeContextCurrent(window);
 		glfwSwapInterval(1); // Enable VSync.
+		updateSize();
 	}
 
 	Window::~Window() {
@@ -51,11 +52,72 @@ namespace pxe {
 
 	void Window::swapBuffers() const { glfwSwapBuffers(window); }
 
-	void Window::pollEvents() const { glfwPollEvents(); }
+	void Window::pollEvents() {
+		glfwPollEvents();
+		updateSize();
+	}
+
+	void Window::updateSize() {
+		int windowWidth = 0;
+		int windowHeight = 0;
+		int bufferWidth = 0;
+		int bufferHeight = 0;
+		glfwGetWindowSize(window, &windowWidth, &windowHeight);
+		glfwGetFramebufferSize(window, &bufferWidth, &bufferHeight);
+		width.store(windowWidth, std::memory_order_relaxed);
+		height.store(windowHeight, std::memory_order_relaxed);
+		framebufferWidth.store(bufferWidth, std::memory_order_relaxed);
+		framebufferHeight.store(bufferHeight, std::memory_order_relaxed);
+	}
+
+	void Window::setSwapInterval(const int interval) const { glfwSwapInterval(interval); }
+
+	bool Window::supportsAdaptiveVSync() const {
+		return glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+			   glfwExtensionSupported("GLX_EXT_swap_control_tear");
+	}
+
+	double Window::getRefreshRate() const {
+		if (GLFWmonitor *monitor = glfwGetWindowMonitor(window)) {
+			const GLFWvidmode *mode = glfwGetVideoMode(monitor);
+			return mode ? mode->refreshRate : 0.0;
+		}
+		// Windowed: GLFW does not say which monitor shows the window, so take the one containing its center.
+		int x, y, width, height;
+		glfwGetWindowPos(window, &x, &y);
+		glfwGetWindowSize(window, &width, &height);
+		const int centerX = x + width / 2, centerY = y + height / 2;
+		int count = 0;
+		GLFWmonitor **monitors = glfwGetMonitors(&count);
+		for (int i = 0; i < count; i++) {
+			int monitorX, monitorY;
+			glfwGetMonitorPos(monitors[i], &monitorX, &monitorY);
+			const GLFWvidmode *mode = glfwGetVideoMode(monitors[i]);
+			if (mode && centerX >= monitorX && centerX < monitorX + mode->width && centerY >= monitorY &&
+				centerY < monitorY + mode->height)
+				return mode->refreshRate;
+		}
+		return 0.0;
+	}
+
+	void Window::setCursorCaptured(const bool captured) const {
+		glfwSetInputMode(window, GLFW_CURSOR, captured ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+	}
+
+	bool Window::setRawMouseMotion(const bool enabled) const {
+		if (!glfwRawMouseMotionSupported())
+			return false;
+		glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, enabled ? GLFW_TRUE : GLFW_FALSE);
+		return true;
+	}
 
 	GLFWwindow *Window::getGlfwWindow() const { return window; }
 
-	int Window::getWidth() const { return width; }
+	int Window::getWidth() const { return width.load(std::memory_order_relaxed); }
+
+	int Window::getHeight() const { return height.load(std::memory_order_relaxed); }
+
+	int Window::getFramebufferWidth() const { return framebufferWidth.load(std::memory_order_relaxed); }
 
-	int Window::getHeight() const { return height; }
+	int Window::getFramebufferHeight() const { return framebufferHeight.load(std::memory_order_relaxed); }
 } // namespace pxe
@@ -17,6 +17,7 @@
  */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include "openGLContext.h"
 
@@ -47,9 +48,40 @@ namespace pxe {
 		void swapBuffers() const;
 
 		/**
-		 * @brief Polls window events.
+		 * @brief Polls window events, then refreshes the cached window and framebuffer sizes.
 		 */
-		void pollEvents() const;
+		void pollEvents();
+
+		/**
+		 * @brief Sets the number of vertical blanks to wait for on every swap.
+		 *
+		 * Must be called on the thread owning the GL context.
+		 * @param interval 1 for VSync, 0 to swap immediately, -1 for adaptive VSync.
+		 */
+		void setSwapInterval(int interval) const;
+
+		/**
+		 * @brief Checks whether the driver supports adaptive VSync (a negative swap interval).
+		 */
+		[[nodiscard]] bool supportsAdaptiveVSync() const;
+
+		/**
+		 * @brief Gets the refresh rate of the monitor showing the window: its fullscreen monitor, or the one
+		 * containing the center of the window.
+		 * @return Refresh rate in Hz, or 0 if unknown, e.g. when the center is off every monitor.
+		 */
+		[[nodiscard]] double getRefreshRate() const;
+
+		/**
+		 * @brief Hides the cursor and locks it to the window, reporting unbounded relative motion.
+		 */
+		void setCursorCaptured(bool captured) const;
+
+		/**
+		 * @brief Requests unaccelerated, unscaled mouse motion while the cursor is captured.
+		 * @return True if the platform supports raw motion and it was applied.
+		 */
+		bool setRawMouseMotion(bool enabled) const;
 
 		/**
 		 * @brief Returns a pointer to the GLFW window handle.
@@ -57,18 +89,33 @@ namespace pxe {
 		[[nodiscard]] GLFWwindow *getGlfwWindow() const;
 
 		/**
-		 * @brief Gets the window width.
+		 * @brief Gets the window width in screen coordinates, as of the last poll. Safe from any thread.
 		 */
 		[[nodiscard]] int getWidth() const;
 
 		/**
-		 * @brief Gets the window height.
+		 * @brief Gets the window height in screen coordinates, as of the last poll. Safe from any thread.
 		 */
 		[[nodiscard]] int getHeight() const;
 
+		/**
+		 * @brief Gets the framebuffer width in pixels, as of the last poll; differs from the window width
+		 * on high-DPI displays. Safe from any thread.
+		 */
+		[[nodiscard]] int getFramebufferWidth() const;
+
+		/**
+		 * @brief Gets the framebuffer height in pixels, as of the last poll. Safe from any thread.
+		 */
+		[[nodiscard]] int getFramebufferHeight() const;
+
 	private:
 		GLFWwindow *window;
-		int width;
-		int height;
+		std::atomic<int> width; ///< Window size; the window is resizable, so it is refreshed on every poll.
+		std::atomic<int> height;
+		std::atomic<int> framebufferWidth{0};
+		std::atomic<int> framebufferHeight{0};
+
+		void updateSize();
 	};
 } // namespace pxe
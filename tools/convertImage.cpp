@@ -0,0 +1,61 @@
+/*
+* PX-Engine Tool - Image Converter
+ * ---------------------------------
+ * Converts a PNG, QOI or native image into the engine-native format, which
+ * Engine::loadImageAsync and pxe::loadImage load without decoding.
+ *
+ * Usage:
+ *   px-engine-convert <input> <output.pxi> [--lz4] [--premultiply]
+ *
+ * Options:
+ * - --lz4          Compress the pixels; smaller files that still load at memory bandwidth,
+ *                  but no longer memory-mapped in place.
+ * - --premultiply  Store premultiplied alpha, as the engine's Alpha blend mode expects.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <string_view>
+#include "imageFile.h"
+
+int main(const int argc, char *argv[]) {
+	std::string_view input;
+	std::string_view output;
+	auto compression = pxe::ImageCompression::None;
+	bool premultiply = false;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string_view argument = argv[i];
+		if (argument == "--lz4") {
+			compression = pxe::ImageCompression::Lz4;
+		} else if (argument == "--premultiply") {
+			premultiply = true;
+		} else if (input.empty()) {
+			input = argument;
+		} else if (output.empty()) {
+			output = argument;
+		} else {
+			input = {};
+			break;
+		}
+	}
+	if (input.empty() || output.empty()) {
+		std::fprintf(stderr, "usage: %s <input> <output.pxi> [--lz4] [--premultiply]\n", argv[0]);
+		return 2;
+	}
+
+	try {
+		pxe::Image image = pxe::loadImage(std::string(input));
+		if (premultiply) {
+			image.premultiplyAlpha();
+		}
+		pxe::saveImage(std::string(output), image, compression);
+		std::printf("%.*s: %dx%d\n", static_cast<int>(output.size()), output.data(), image.getWidth(),
+					image.getHeight());
+	} catch (const std::exception &e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}